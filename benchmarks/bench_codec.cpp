@@ -0,0 +1,137 @@
+
+//////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2024 Ken Barker
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//////////////////////////////////////////////////////////////////////////////
+/// @file
+/// @brief A benchmark of the column codec on synthetic flight profiles.
+///
+/// The pressure, density, True Air Speed and Mach number of the samples of a
+/// synthetic fleet are encoded to typical archive tolerances. The benchmark
+/// reports the compression ratio and the encode and decode speeds in GB/s of
+/// decoded values.
+/// The results are written in the Google Benchmark JSON format, e.g.:
+///
+///     bench_codec --flights 1000 --json results.json
+//////////////////////////////////////////////////////////////////////////////
+#include "results.hpp"
+#include "via/isa/batch.hpp"
+#include "via/isa/codec.hpp"
+#include "via/isa/synthetic_fleet.hpp"
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace via::isa;
+
+namespace {
+using Clock = std::chrono::steady_clock;
+
+constexpr int REPETITIONS{5};
+
+/// @return the shortest time of the function in nanoseconds.
+template <typename Function> auto measure(Function function) -> double {
+  double best{1e300};
+  for (int r{}; r < REPETITIONS; ++r) {
+    const auto start{Clock::now()};
+    function();
+    best = std::min(
+        best, static_cast<double>(
+                  std::chrono::duration_cast<std::chrono::nanoseconds>(
+                      Clock::now() - start)
+                      .count()));
+  }
+  return best;
+}
+} // namespace
+
+auto main(int argc, char *argv[]) -> int {
+  FleetParameters<double> params;
+  params.flights = 200;
+  std::string json_file;
+  for (int i{1}; i < argc; ++i) {
+    const std::string arg{argv[i]};
+    if ((arg == "--json") && (i + 1 < argc))
+      json_file = argv[++i];
+    else if ((arg == "--flights") && (i + 1 < argc))
+      params.flights = std::stoul(argv[++i]);
+    else {
+      std::cerr << "usage: bench_codec [--flights N] [--json FILE]\n";
+      return 1;
+    }
+  }
+
+  const auto fleet{generate_synthetic_fleet(params)};
+  const auto size{fleet.size()};
+
+  std::vector<double> temperatures(size);
+  std::vector<double> pressures(size);
+  std::vector<double> densities(size);
+  std::vector<double> tas(size);
+  batch::calculate_isa_temperature<double>(
+      fleet.altitude, fleet.delta_temperature, temperatures);
+  batch::calculate_isa_pressure<double>(fleet.altitude, pressures);
+  batch::calculate_density<double>(pressures, temperatures, densities);
+  batch::mach_true_air_speed<double>(fleet.mach, temperatures, tas);
+
+  struct Column {
+    std::string name;
+    const std::vector<double> &values;
+    double tolerance;
+  };
+  const std::vector<Column> columns{{"pressure", pressures, 0.5},
+                                    {"density", densities, 1e-5},
+                                    {"tas", tas, 0.01},
+                                    {"mach", fleet.mach, 1e-4}};
+
+  benchmarks::Results results;
+  const auto bytes{static_cast<double>(size * sizeof(double))};
+  std::vector<double> decoded(size);
+  for (const auto &column : columns) {
+    codec::EncodedColumn<double> encoded;
+    const auto encode_time{measure([&] {
+      encoded = codec::encode<double>(column.values, column.tolerance);
+    })};
+    const auto decode_time{
+        measure([&] { codec::decode<double>(encoded, decoded); })};
+
+    double error{};
+    for (std::size_t i{}; i < size; ++i)
+      error = std::max(error, std::abs(decoded[i] - column.values[i]));
+    if (error > column.tolerance * (1.0 + 1e-9)) {
+      std::cerr << "Error: " << column.name << " exceeds its tolerance\n";
+      return 1;
+    }
+
+    results.add("BM_encode/" + column.name, 1, encode_time, encode_time,
+                {{"bytes_per_second", bytes * 1e9 / encode_time},
+                 {"compression_ratio", encoded.compression_ratio()}});
+    results.add("BM_decode/" + column.name, 1, decode_time, decode_time,
+                {{"bytes_per_second", bytes * 1e9 / decode_time},
+                 {"compression_ratio", encoded.compression_ratio()},
+                 {"max_error", error}});
+  }
+
+  if (!json_file.empty())
+    std::ofstream(json_file) << results.to_json();
+  return 0;
+}
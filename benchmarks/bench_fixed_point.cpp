@@ -0,0 +1,172 @@
+
+//////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2024 Ken Barker
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//////////////////////////////////////////////////////////////////////////////
+/// @file
+/// @brief A benchmark of the fixed point functions against the floating
+/// point functions on synthetic flight profiles.
+///
+/// For each function, the benchmark reports the time per value of the fixed
+/// point and floating point batch functions and the maximum, RMS and mean
+/// errors of the fixed point values.
+/// The results are written in the Google Benchmark JSON format, e.g.:
+///
+///     bench_fixed_point --flights 100 --json results.json
+//////////////////////////////////////////////////////////////////////////////
+#include "results.hpp"
+#include "via/isa/batch.hpp"
+#include "via/isa/fixed_point.hpp"
+#include "via/isa/synthetic_fleet.hpp"
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace via::isa;
+
+namespace {
+using Clock = std::chrono::steady_clock;
+
+constexpr int REPETITIONS{5};
+
+/// @return the shortest time of the function in nanoseconds.
+template <typename Function> auto measure(Function function) -> double {
+  double best{1e300};
+  for (int r{}; r < REPETITIONS; ++r) {
+    const auto start{Clock::now()};
+    function();
+    best = std::min(
+        best, static_cast<double>(
+                  std::chrono::duration_cast<std::chrono::nanoseconds>(
+                      Clock::now() - start)
+                      .count()));
+  }
+  return best;
+}
+} // namespace
+
+auto main(int argc, char *argv[]) -> int {
+  FleetParameters<double> params;
+  params.flights = 50;
+  std::string json_file;
+  for (int i{1}; i < argc; ++i) {
+    const std::string arg{argv[i]};
+    if ((arg == "--json") && (i + 1 < argc))
+      json_file = argv[++i];
+    else if ((arg == "--flights") && (i + 1 < argc))
+      params.flights = std::stoul(argv[++i]);
+    else {
+      std::cerr << "usage: bench_fixed_point [--flights N] [--json FILE]\n";
+      return 1;
+    }
+  }
+
+  using Isa = fixed_point::FixedPointIsa<>;
+  constexpr auto F{Isa::FORMATS};
+  const Isa isa;
+
+  const auto fleet{generate_synthetic_fleet(params)};
+  const auto size{fleet.size()};
+  std::vector<double> pressures(size);
+  std::vector<double> temperatures(size);
+  std::vector<double> densities(size);
+  std::vector<double> tas(size);
+  std::vector<double> cas(size);
+  std::vector<double> altitudes(size);
+  batch::calculate_isa_temperature<double>(
+      fleet.altitude, fleet.delta_temperature, temperatures);
+
+  const auto fixed{[size](const std::vector<double> &values,
+                          const int fraction) {
+    std::vector<std::int32_t> result(size);
+    fixed_point::to_fixed<std::int32_t>(values, fraction, result);
+    return result;
+  }};
+  const auto h{fixed(fleet.altitude, F.altitude)};
+  const auto t{fixed(temperatures, F.temperature)};
+  const auto c{fixed(fleet.cas, F.speed)};
+  batch::calculate_isa_pressure<double>(fleet.altitude, pressures);
+  const auto p{fixed(pressures, F.pressure)};
+  batch::calculate_true_air_speed<double>(fleet.cas, pressures, temperatures,
+                                          tas);
+  const auto v{fixed(tas, F.speed)};
+  std::vector<std::int32_t> out(size);
+
+  benchmarks::Results results;
+  const auto add{[&](const std::string &name, const double double_time,
+                     const double fixed_time,
+                     const std::vector<double> &reference, const int fraction) {
+    const auto report{
+        fixed_point::error_report<std::int32_t>(reference, out, fraction)};
+    results.add("BM_double/" + name, 1, double_time, double_time,
+                {{"ns_per_element", double_time / static_cast<double>(size)}});
+    results.add("BM_fixed_point/" + name, 1, fixed_time, fixed_time,
+                {{"ns_per_element", fixed_time / static_cast<double>(size)},
+                 {"max_error", report.max_error},
+                 {"rms_error", report.rms_error},
+                 {"mean_error", report.mean_error}});
+  }};
+
+  add("pressure",
+      measure([&] {
+        batch::calculate_isa_pressure<double>(fleet.altitude, pressures);
+      }),
+      measure([&] { isa.calculate_isa_pressure(h, out); }), pressures,
+      F.pressure);
+  add("altitude",
+      measure([&] { batch::calculate_isa_altitude<double>(pressures, altitudes); }),
+      measure([&] { isa.calculate_isa_altitude(p, out); }), altitudes,
+      F.altitude);
+
+  const auto d{fixed(fleet.delta_temperature, F.temperature)};
+  add("temperature",
+      measure([&] {
+        batch::calculate_isa_temperature<double>(
+            fleet.altitude, fleet.delta_temperature, temperatures);
+      }),
+      measure([&] { isa.calculate_isa_temperature(h, d, out); }), temperatures,
+      F.temperature);
+  add("density",
+      measure([&] {
+        batch::calculate_density<double>(pressures, temperatures, densities);
+      }),
+      measure([&] { isa.calculate_density(p, t, out); }), densities,
+      F.density);
+  add("true_air_speed",
+      measure([&] {
+        batch::calculate_true_air_speed<double>(fleet.cas, pressures,
+                                                temperatures, tas);
+      }),
+      measure([&] { isa.calculate_true_air_speed(c, p, t, out); }), tas,
+      F.speed);
+  add("calibrated_air_speed",
+      measure([&] {
+        batch::calculate_calibrated_air_speed<double>(tas, pressures,
+                                                      temperatures, cas);
+      }),
+      measure([&] { isa.calculate_calibrated_air_speed(v, p, t, out); }), cas,
+      F.speed);
+
+  if (!json_file.empty())
+    std::ofstream(json_file) << results.to_json();
+  return 0;
+}
@@ -0,0 +1,181 @@
+
+//////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2024 Ken Barker
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//////////////////////////////////////////////////////////////////////////////
+/// @file
+/// @brief A benchmark of the MicroBatcher against direct scalar calls.
+///
+/// Client threads, like request handlers, each make requests of a few ISA
+/// pressure calculations. The requests are calculated either directly with
+/// the scalar function or by a `MicroBatcher` with different latency
+/// budgets. The benchmark reports the throughput and the latency of the
+/// requests, and the latency added by the MicroBatcher.
+/// The results are written in the Google Benchmark JSON format, e.g.:
+///
+///     bench_microbatch --clients 64 --json results.json
+//////////////////////////////////////////////////////////////////////////////
+#include "results.hpp"
+#include "via/isa/microbatch.hpp"
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace via::isa;
+using namespace via::units::si;
+
+namespace {
+using Clock = std::chrono::steady_clock;
+
+/// The number of values calculated in each request.
+constexpr std::size_t VALUES_PER_REQUEST{4};
+
+/// The throughput and latencies of requests.
+struct Result {
+  double real_time;
+  double mean_latency;
+  double p99_latency;
+  double checksum;
+};
+
+/// Run `requests` requests on each of `clients` threads.
+template <typename Request>
+auto measure(const std::size_t clients, const std::size_t requests,
+             Request request) -> Result {
+  std::vector<std::vector<double>> latencies(clients);
+  std::vector<double> checksums(clients);
+  const auto start{Clock::now()};
+  {
+    std::vector<std::jthread> threads;
+    for (std::size_t c{}; c < clients; ++c)
+      threads.emplace_back([&, c] {
+        auto &latency{latencies[c]};
+        latency.reserve(requests);
+        for (std::size_t r{}; r < requests; ++r) {
+          const auto request_start{Clock::now()};
+          checksums[c] += request(static_cast<double>((c * 7919 + r) % 12000));
+          latency.push_back(static_cast<double>(
+              std::chrono::duration_cast<std::chrono::nanoseconds>(
+                  Clock::now() - request_start)
+                  .count()));
+        }
+      });
+  }
+  const auto real_time{static_cast<double>(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() -
+                                                           start)
+          .count())};
+
+  std::vector<double> all;
+  for (const auto &latency : latencies)
+    all.insert(all.end(), latency.begin(), latency.end());
+  std::sort(all.begin(), all.end());
+  double sum{};
+  for (const auto value : all)
+    sum += value;
+  double checksum{};
+  for (const auto value : checksums)
+    checksum += value;
+  return {real_time, sum / static_cast<double>(all.size()),
+          all[std::min(all.size() - 1, all.size() * 99 / 100)], checksum};
+}
+} // namespace
+
+auto main(int argc, char *argv[]) -> int {
+  std::size_t max_clients{64};
+  std::size_t requests{2000};
+  std::string json_file;
+  for (int i{1}; i < argc; ++i) {
+    const std::string arg{argv[i]};
+    if ((arg == "--json") && (i + 1 < argc))
+      json_file = argv[++i];
+    else if ((arg == "--clients") && (i + 1 < argc))
+      max_clients = std::stoul(argv[++i]);
+    else if ((arg == "--requests") && (i + 1 < argc))
+      requests = std::stoul(argv[++i]);
+    else {
+      std::cerr << "usage: bench_microbatch [--clients N] [--requests N] "
+                   "[--json FILE]\n";
+      return 1;
+    }
+  }
+
+  benchmarks::Results results;
+  const auto add{[&](const std::string &name, const std::size_t clients,
+                     const Result &result, const double direct_latency,
+                     const double mean_batch_size) {
+    const auto values{static_cast<double>(clients * requests *
+                                          VALUES_PER_REQUEST)};
+    results.add(name, clients, result.real_time, result.real_time,
+                {{"items_per_second", values * 1e9 / result.real_time},
+                 {"mean_latency_ns", result.mean_latency},
+                 {"p99_latency_ns", result.p99_latency},
+                 {"added_latency_ns", result.mean_latency - direct_latency},
+                 {"mean_batch_size", mean_batch_size}});
+  }};
+
+  for (std::size_t clients{1}; clients <= max_clients; clients *= 4) {
+    const auto suffix{"/clients:" + std::to_string(clients)};
+
+    const auto direct{measure(clients, requests, [](const double altitude) {
+      double sum{};
+      for (std::size_t i{}; i < VALUES_PER_REQUEST; ++i)
+        sum += calculate_isa_pressure(
+                   Metres<double>(altitude + static_cast<double>(i)))
+                   .v();
+      return sum;
+    })};
+    add("BM_direct" + suffix, clients, direct, direct.mean_latency, 1.0);
+
+    for (const int budget : {10, 50, 200}) {
+      MicroBatcher<double> batcher(
+          {.latency_budget = std::chrono::microseconds(budget),
+           .max_batch_size = clients * VALUES_PER_REQUEST});
+      const auto batched{
+          measure(clients, requests, [&batcher](const double altitude) {
+            std::array<std::future<Pascals<double>>, VALUES_PER_REQUEST>
+                futures;
+            for (std::size_t i{}; i < VALUES_PER_REQUEST; ++i)
+              futures[i] = batcher.calculate_isa_pressure(
+                  Metres<double>(altitude + static_cast<double>(i)));
+            double sum{};
+            for (auto &future : futures)
+              sum += future.get().v();
+            return sum;
+          })};
+      if (batched.checksum != direct.checksum) {
+        std::cerr << "Error: MicroBatcher results differ\n";
+        return 1;
+      }
+      add("BM_microbatch_" + std::to_string(budget) + "us" + suffix, clients,
+          batched, direct.mean_latency,
+          batcher.statistics().mean_batch_size());
+    }
+  }
+
+  if (!json_file.empty())
+    std::ofstream(json_file) << results.to_json();
+  return 0;
+}
@@ -0,0 +1,237 @@
+
+//////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2024 Ken Barker
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//////////////////////////////////////////////////////////////////////////////
+/// @file
+/// @brief A benchmark of the parallel schedulers on trajectories with a
+/// skewed distribution of lengths.
+///
+/// The trajectory lengths are log-uniformly distributed between 10 and
+/// 100,000 samples, so a few long-haul trajectories contain most of the
+/// samples. The same kernel is run over all of the samples with:
+///
+/// - static: an equal number of consecutive trajectories per thread;
+/// - dynamic: `parallel_for` over the trajectories;
+/// - work_stealing: `parallel_for_trajectories`.
+///
+/// The utilization is the time that the threads spent running the kernel
+/// divided by the number of threads multiplied by the elapsed time.
+/// The results are written in the Google Benchmark JSON format, e.g.:
+///
+///     bench_scheduler --threads 16 --json results.json
+//////////////////////////////////////////////////////////////////////////////
+#include "results.hpp"
+#include "via/isa/batch.hpp"
+#include "via/isa/parallel.hpp"
+#include "via/isa/synthetic_fleet.hpp"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace via::isa;
+
+namespace {
+using Clock = std::chrono::steady_clock;
+
+constexpr std::size_t MIN_LENGTH{10};
+constexpr std::size_t MAX_LENGTH{100'000};
+constexpr std::size_t GRAIN{4096};
+constexpr int REPETITIONS{5};
+
+/// Columns of trajectory samples.
+struct Trajectories {
+  std::vector<std::size_t> offsets{0};
+  std::vector<double> altitudes;
+  std::vector<double> cas;
+  std::vector<double> machs;
+};
+
+/// Generate trajectories with log-uniformly distributed lengths.
+auto generate_trajectories(const std::size_t count, const std::uint64_t seed)
+    -> Trajectories {
+  detail::SplitMix64 rng{seed};
+  Trajectories trajectories;
+  for (std::size_t i{}; i < count; ++i) {
+    const auto length{static_cast<std::size_t>(
+        static_cast<double>(MIN_LENGTH) *
+        std::pow(static_cast<double>(MAX_LENGTH) / MIN_LENGTH,
+                 rng.uniform<double>()))};
+    for (std::size_t j{}; j < length; ++j) {
+      trajectories.altitudes.push_back(rng.uniform(0.0, 12000.0));
+      trajectories.cas.push_back(rng.uniform(100.0, 180.0));
+    }
+    trajectories.offsets.push_back(trajectories.altitudes.size());
+  }
+  trajectories.machs.resize(trajectories.altitudes.size());
+  return trajectories;
+}
+
+/// The kernel: the Mach numbers of the samples in [begin, end).
+void kernel(Trajectories &trajectories, const std::size_t begin,
+            const std::size_t end) {
+  constexpr std::size_t BLOCK_SIZE{512};
+  std::array<double, BLOCK_SIZE> pressures;
+  for (auto first{begin}; first < end; first += BLOCK_SIZE) {
+    const auto n{std::min(BLOCK_SIZE, end - first)};
+    const auto block{std::span<double>(pressures).first(n)};
+    batch::calculate_isa_pressure<double>(
+        std::span<const double>(trajectories.altitudes).subspan(first, n),
+        block);
+    batch::calibrated_air_speed_mach<double>(
+        std::span<const double>(trajectories.cas).subspan(first, n), block,
+        std::span<double>(trajectories.machs).subspan(first, n));
+  }
+}
+
+/// The results of a run of a scheduler.
+struct Result {
+  double real_time;
+  double cpu_time;
+  double utilization;
+};
+
+/// Run a scheduler and measure its elapsed time and utilization.
+template <typename Scheduler>
+auto measure(Trajectories &trajectories, Scheduler scheduler,
+             const std::size_t threads) -> Result {
+  Result best{1e300, 0.0, 0.0};
+  for (int r{}; r < REPETITIONS; ++r) {
+    std::atomic<std::int64_t> busy{0};
+    const auto timed_kernel{[&](const std::size_t begin,
+                                const std::size_t end) {
+      const auto start{Clock::now()};
+      kernel(trajectories, begin, end);
+      busy += std::chrono::duration_cast<std::chrono::nanoseconds>(
+                  Clock::now() - start)
+                  .count();
+    }};
+
+    const auto start{Clock::now()};
+    scheduler(timed_kernel, threads);
+    const auto real_time{static_cast<double>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() -
+                                                             start)
+            .count())};
+    if (real_time < best.real_time)
+      best = {real_time, static_cast<double>(busy.load()),
+              static_cast<double>(busy.load()) /
+                  (static_cast<double>(threads) * real_time)};
+  }
+  return best;
+}
+} // namespace
+
+auto main(int argc, char *argv[]) -> int {
+  std::size_t count{500};
+  std::size_t max_threads{0};
+  std::string json_file;
+  for (int i{1}; i < argc; ++i) {
+    const std::string arg{argv[i]};
+    if ((arg == "--json") && (i + 1 < argc))
+      json_file = argv[++i];
+    else if ((arg == "--trajectories") && (i + 1 < argc))
+      count = std::stoul(argv[++i]);
+    else if ((arg == "--threads") && (i + 1 < argc))
+      max_threads = std::stoul(argv[++i]);
+    else {
+      std::cerr << "usage: bench_scheduler [--trajectories N] [--threads N] "
+                   "[--json FILE]\n";
+      return 1;
+    }
+  }
+
+  auto trajectories{generate_trajectories(count, 42)};
+  const auto &offsets{trajectories.offsets};
+  const auto samples{trajectories.altitudes.size()};
+
+  std::vector<std::size_t> thread_counts;
+  max_threads = thread_count(max_threads, count);
+  for (std::size_t threads{1}; threads < max_threads; threads *= 2)
+    thread_counts.push_back(threads);
+  thread_counts.push_back(max_threads);
+
+  benchmarks::Results results;
+  const auto add{[&](const std::string &name, const std::size_t threads,
+                     const Result &result) {
+    results.add(name, threads, result.real_time, result.cpu_time,
+                {{"items_per_second",
+                  static_cast<double>(samples) * 1e9 / result.real_time},
+                 {"utilization", result.utilization}});
+  }};
+
+  for (const auto threads : thread_counts)
+    add(
+        "BM_static/threads:" + std::to_string(threads), threads,
+        measure(
+            trajectories,
+            [&](const auto &function, const std::size_t workers) {
+              parallel_for(
+                  workers,
+                  [&](const std::size_t w) {
+                    const auto first{count * w / workers};
+                    const auto last{count * (w + 1) / workers};
+                    for (auto i{first}; i < last; ++i)
+                      function(offsets[i], offsets[i + 1]);
+                  },
+                  workers);
+            },
+            threads));
+
+  for (const auto threads : thread_counts)
+    add(
+        "BM_dynamic/threads:" + std::to_string(threads), threads,
+        measure(
+            trajectories,
+            [&](const auto &function, const std::size_t workers) {
+              parallel_for(
+                  count,
+                  [&](const std::size_t i) {
+                    function(offsets[i], offsets[i + 1]);
+                  },
+                  workers);
+            },
+            threads));
+
+  for (const auto threads : thread_counts)
+    add(
+        "BM_work_stealing/threads:" + std::to_string(threads), threads,
+        measure(
+            trajectories,
+            [&](const auto &function, const std::size_t workers) {
+              parallel_for_trajectories(
+                  offsets,
+                  [&](const std::size_t, const std::size_t begin,
+                      const std::size_t end) { function(begin, end); },
+                  GRAIN, workers);
+            },
+            threads));
+
+  if (!json_file.empty())
+    std::ofstream(json_file) << results.to_json();
+  return 0;
+}
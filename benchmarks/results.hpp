@@ -0,0 +1,111 @@
+#pragma once
+
+
+//////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2024 Ken Barker
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//////////////////////////////////////////////////////////////////////////////
+/// @file
+/// @brief Benchmark results in the Google Benchmark JSON format, so that the
+/// C++ benchmarks can be compared with Google Benchmark's `compare.py`.
+//////////////////////////////////////////////////////////////////////////////
+#include <algorithm>
+#include <cstdio>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace benchmarks {
+
+/// Benchmark results in the Google Benchmark JSON format.
+class Results {
+  std::vector<std::string> entries_;
+  /// The name and number of instances of each benchmark family.
+  std::vector<std::pair<std::string, std::size_t>> families_;
+
+  [[nodiscard]] static auto number(const double value) -> std::string {
+    char buffer[32];
+    std::snprintf(buffer, sizeof(buffer), "%.6g", value);
+    return buffer;
+  }
+
+public:
+  /// Add the result of a benchmark.
+  /// @param name the name of the benchmark, e.g. "BM_static/threads:4".
+  /// @param threads the number of threads.
+  /// @param real_time the elapsed time in nanoseconds.
+  /// @param cpu_time the CPU time in nanoseconds.
+  /// @param counters the names and values of user counters.
+  void add(const std::string &name, const std::size_t threads,
+           const double real_time, const double cpu_time,
+           const std::vector<std::pair<std::string_view, double>> &counters) {
+    const auto family{name.substr(0, name.find('/'))};
+    auto it{std::find_if(families_.begin(), families_.end(),
+                         [&](const auto &f) { return f.first == family; })};
+    if (it == families_.end())
+      it = families_.insert(it, {family, 0});
+    const auto family_index{static_cast<std::size_t>(it - families_.begin())};
+    const auto instance_index{it->second++};
+
+    std::string entry{"    {\n"
+                      "      \"name\": \"" + name + "\",\n"
+                      "      \"family_index\": " + std::to_string(family_index) +
+                      ",\n"
+                      "      \"per_family_instance_index\": " +
+                      std::to_string(instance_index) + ",\n"
+                      "      \"run_name\": \"" + name + "\",\n"
+                      "      \"run_type\": \"iteration\",\n"
+                      "      \"repetitions\": 1,\n"
+                      "      \"repetition_index\": 0,\n"
+                      "      \"threads\": " + std::to_string(threads) + ",\n"
+                      "      \"iterations\": 1,\n"
+                      "      \"real_time\": " + number(real_time) + ",\n"
+                      "      \"cpu_time\": " + number(cpu_time) + ",\n"
+                      "      \"time_unit\": \"ns\""};
+    std::string extra;
+    for (const auto &[counter, value] : counters) {
+      entry += ",\n      \"" + std::string(counter) + "\": " + number(value);
+      extra += " " + std::string(counter) + "=" + number(value);
+    }
+    entries_.push_back(entry + "\n    }");
+
+    std::printf("%-50s %14.0f ns%s\n", name.c_str(), real_time, extra.c_str());
+  }
+
+  /// @return the results as a JSON string.
+  [[nodiscard]] auto to_json() const -> std::string {
+    std::string json{"{\n  \"context\": {\n"
+                     "    \"num_cpus\": " +
+                     std::to_string(std::thread::hardware_concurrency()) +
+                     ",\n"
+                     "    \"mhz_per_cpu\": 0,\n"
+                     "    \"cpu_scaling_enabled\": false,\n"
+                     "    \"caches\": [],\n"
+                     "    \"library_build_type\": \"release\"\n"
+                     "  },\n  \"benchmarks\": [\n"};
+    for (std::size_t i{}; i < entries_.size(); ++i)
+      json += entries_[i] + (i + 1 < entries_.size() ? ",\n" : "\n");
+    return json + "  ]\n}\n";
+  }
+};
+
+} // namespace benchmarks
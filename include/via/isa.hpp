@@ -41,6 +41,10 @@
 /// - CAS from TAS, pressure and temperature;
 /// - TAS from [Mach number](https://en.wikipedia.org/wiki/Mach_number) and
 /// temperature;
+/// - Mach number from TAS and temperature;
+/// - the impact pressure of CAS;
+/// - Mach number from impact pressure and pressure, or from CAS and pressure;
+/// - CAS from Mach number and pressure;
 /// - and the crossover altitude between CAS / MACH flight regimes.
 ///
 /// The equations for the functions above are from
@@ -338,6 +342,110 @@ constexpr auto mach_true_air_speed(const T mach,
                                        speed_of_sound<T>(temperature).v());
 }
 
+/// Calculate the Mach number from the True Air Speed (TAS) at the given
+/// temperature.
+/// See BADA Rev 3.12, Eq 3.1.22
+/// @pre temperature > 0
+/// @param tas the True Air Speed in metres per second.
+/// @param temperature the temperature in Kelvin.
+/// @return the Mach number.
+template <typename T>
+  requires std::floating_point<T>
+[[nodiscard("Pure Function")]]
+constexpr auto true_air_speed_mach(const units::si::MetresPerSecond<T> tas,
+                                   const units::si::Kelvin<T> temperature)
+    -> T {
+  return tas.v() / speed_of_sound<T>(temperature).v();
+}
+
+/// Calculate the impact pressure, i.e. the difference between the total and
+/// static pressures, corresponding to the Calibrated Air Speed (CAS).
+/// I.e. the impact pressure at Sea level of the CAS.
+/// See BADA Rev 3.12, Eq 3.1.23
+/// @param cas the Calibrated Air Speed in metres per second.
+/// @return the impact pressure in Pascals.
+template <typename T>
+  requires std::floating_point<T>
+[[nodiscard("Pure Function")]]
+constexpr auto calculate_impact_pressure(const units::si::MetresPerSecond<T> cas)
+    -> units::si::Pascals<T> {
+  constexpr T INNER_FACTOR{U<T> / (T(2) * constants::R<T> *
+                                   constants::SEA_LEVEL_TEMPERATURE<T>.v())};
+
+  return units::si::Pascals<T>(
+      constants::SEA_LEVEL_PRESSURE<T>.v() *
+      (std::pow(T(1) + INNER_FACTOR * cas.v() * cas.v(), INV_U<T>) - T(1)));
+}
+
+/// Calculate the subsonic Mach number from the impact and static pressures.
+/// See BADA Rev 3.12, Eq 3.1.22 & Eq 3.1.23
+/// @pre 0 <= impact_pressure and 0 < static_pressure
+/// @param impact_pressure the impact pressure in Pascals.
+/// @param static_pressure the static pressure in Pascals.
+/// @return the Mach number.
+template <typename T>
+  requires std::floating_point<T>
+[[nodiscard("Pure Function")]]
+constexpr auto impact_pressure_mach(const units::si::Pascals<T> impact_pressure,
+                                    const units::si::Pascals<T> static_pressure)
+    -> T {
+  constexpr T MACH_FACTOR{T(2) / (constants::K<T> - T(1))};
+
+  Expects(static_pressure.v() > T());
+
+  return std::sqrt(
+      MACH_FACTOR *
+      (std::pow(T(1) + impact_pressure.v() / static_pressure.v(), U<T>) -
+       T(1)));
+}
+
+/// Calculate the Mach number from the Calibrated Air Speed (CAS) at the
+/// given pressure, through the impact pressure.
+/// Note: the Mach number does not depend upon temperature.
+/// See BADA Rev 3.12, Eq 3.1.22 & Eq 3.1.23
+/// @pre pressure > 0
+/// @param cas the Calibrated Air Speed in metres per second.
+/// @param pressure the pressure in Pascals.
+/// @return the Mach number.
+template <typename T>
+  requires std::floating_point<T>
+[[nodiscard("Pure Function")]]
+constexpr auto calibrated_air_speed_mach(const units::si::MetresPerSecond<T> cas,
+                                         const units::si::Pascals<T> pressure)
+    -> T {
+  return impact_pressure_mach(calculate_impact_pressure(cas), pressure);
+}
+
+/// Calculate the Calibrated Air Speed (CAS) from the Mach number at the
+/// given pressure, through the impact pressure.
+/// Note: the Calibrated Air Speed does not depend upon temperature.
+/// See BADA Rev 3.12, Eq 3.1.22 & Eq 3.1.24
+/// @pre pressure > 0
+/// @param mach the Mach number.
+/// @param pressure the pressure in Pascals.
+/// @return the Calibrated Air Speed in metres per second.
+template <typename T>
+  requires std::floating_point<T>
+[[nodiscard("Pure Function")]]
+constexpr auto mach_calibrated_air_speed(const T mach,
+                                         const units::si::Pascals<T> pressure)
+    -> units::si::MetresPerSecond<T> {
+  constexpr T K_MINUS_1_OVER_2{(constants::K<T> - T(1)) / T(2)};
+  constexpr T OUTER_FACTOR{T(2) * constants::R<T> *
+                           constants::SEA_LEVEL_TEMPERATURE<T>.v() / U<T>};
+
+  Expects(pressure.v() > T());
+
+  const T impact_pressure{
+      pressure.v() *
+      (std::pow(T(1) + K_MINUS_1_OVER_2 * mach * mach, INV_U<T>) - T(1))};
+  return units::si::MetresPerSecond<T>(std::sqrt(
+      OUTER_FACTOR *
+      (std::pow(T(1) + impact_pressure / constants::SEA_LEVEL_PRESSURE<T>.v(),
+                U<T>) -
+       T(1))));
+}
+
 /// This function calculates the crossover pressure ratio between the
 /// Calibrated Air Speed and Mach number.
 /// See BADA Rev 3.12, Eq 3.1-29
@@ -0,0 +1,192 @@
+#pragma once
+
+//////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2024 Ken Barker
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//////////////////////////////////////////////////////////////////////////////
+/// @file
+/// @brief An air data computer: the reduction of static pressure, impact
+/// pressure and total air temperature measurements to pressure altitude,
+/// Calibrated Air Speed, Mach number, static air temperature and True Air
+/// Speed.
+///
+/// The impact pressure is the difference between the total (pitot) and
+/// static pressures, so for subsonic flow:
+///
+///     CAS  = sqrt(2 R T0 / U * ((1 + qc / P0)^U - 1))
+///     Mach = sqrt(2 / (K - 1) * ((1 + qc / ps)^U - 1))
+///
+/// where U is (K - 1) / K, see `calculate_impact_pressure` and
+/// `impact_pressure_mach`.
+/// A total air temperature probe measures the static air temperature plus
+/// the recovered fraction of the adiabatic temperature rise:
+///
+///     TAT = SAT * (1 + r * (K - 1) / 2 * Mach^2)
+///
+/// The batch function reduces each sample in a single loop.
+//////////////////////////////////////////////////////////////////////////////
+#include "../isa.hpp"
+#include <span>
+
+namespace via {
+namespace isa {
+
+/// Calculate the Calibrated Air Speed corresponding to an impact pressure.
+/// The inverse of `calculate_impact_pressure`.
+/// @pre impact_pressure >= 0
+/// @param impact_pressure the impact pressure in Pascals.
+/// @return the Calibrated Air Speed in metres per second.
+template <typename T>
+  requires std::floating_point<T>
+[[nodiscard("Pure Function")]]
+constexpr auto
+impact_pressure_calibrated_air_speed(const units::si::Pascals<T> impact_pressure)
+    -> units::si::MetresPerSecond<T> {
+  constexpr T OUTER_FACTOR{T(2) * constants::R<T> *
+                           constants::SEA_LEVEL_TEMPERATURE<T>.v() / U<T>};
+
+  return units::si::MetresPerSecond<T>(std::sqrt(
+      OUTER_FACTOR *
+      (std::pow(T(1) + impact_pressure.v() /
+                           constants::SEA_LEVEL_PRESSURE<T>.v(),
+                U<T>) -
+       T(1))));
+}
+
+/// Calculate the static air temperature from the total air temperature.
+/// @pre total_temperature > 0
+/// @param total_temperature the total air temperature in Kelvin.
+/// @param mach the Mach number.
+/// @param recovery_factor the recovery factor of the temperature probe,
+/// default 1.
+/// @return the static air temperature in Kelvin.
+template <typename T>
+  requires std::floating_point<T>
+[[nodiscard("Pure Function")]]
+constexpr auto
+calculate_static_air_temperature(const units::si::Kelvin<T> total_temperature,
+                                 const T mach, const T recovery_factor = T(1))
+    -> units::si::Kelvin<T> {
+  constexpr T K_MINUS_1_OVER_2{(constants::K<T> - T(1)) / T(2)};
+
+  return units::si::Kelvin<T>(
+      total_temperature.v() /
+      (T(1) + recovery_factor * K_MINUS_1_OVER_2 * mach * mach));
+}
+
+/// The air data reduced from a sample of air data measurements.
+template <typename T>
+  requires std::floating_point<T>
+struct AirData {
+  /// The pressure altitude in metres.
+  units::si::Metres<T> pressure_altitude;
+  /// The Calibrated Air Speed in metres per second.
+  units::si::MetresPerSecond<T> cas;
+  /// The Mach number.
+  T mach;
+  /// The static air temperature in Kelvin.
+  units::si::Kelvin<T> static_temperature;
+  /// The True Air Speed in metres per second.
+  units::si::MetresPerSecond<T> tas;
+};
+
+/// Calculate the air data from static pressure, impact pressure and total
+/// air temperature measurements in subsonic flight.
+/// @pre 0 < static_pressure, 0 <= impact_pressure and 0 < total_temperature
+/// @param static_pressure the static pressure in Pascals.
+/// @param impact_pressure the impact pressure in Pascals.
+/// @param total_temperature the total air temperature in Kelvin.
+/// @param recovery_factor the recovery factor of the temperature probe,
+/// default 1.
+/// @return the air data.
+template <typename T>
+  requires std::floating_point<T>
+[[nodiscard("Pure Function")]]
+constexpr auto calculate_air_data(const units::si::Pascals<T> static_pressure,
+                                  const units::si::Pascals<T> impact_pressure,
+                                  const units::si::Kelvin<T> total_temperature,
+                                  const T recovery_factor = T(1))
+    -> AirData<T> {
+  const T mach{impact_pressure_mach(impact_pressure, static_pressure)};
+  const auto static_temperature{calculate_static_air_temperature(
+      total_temperature, mach, recovery_factor)};
+  return AirData<T>{calculate_isa_altitude(static_pressure),
+                    impact_pressure_calibrated_air_speed(impact_pressure),
+                    mach, static_temperature,
+                    units::si::MetresPerSecond<T>(
+                        mach * speed_of_sound(static_temperature).v())};
+}
+
+/// The columns of air data reduced from air data measurements.
+template <typename T>
+  requires std::floating_point<T>
+struct AirDataColumns {
+  /// The pressure altitudes in metres.
+  std::span<T> pressure_altitudes;
+  /// The Calibrated Air Speeds in metres per second.
+  std::span<T> cas;
+  /// The Mach numbers.
+  std::span<T> machs;
+  /// The static air temperatures in Kelvin.
+  std::span<T> static_temperatures;
+  /// The True Air Speeds in metres per second.
+  std::span<T> tas;
+};
+
+/// Calculate the air data from columns of static pressure, impact pressure
+/// and total air temperature measurements in subsonic flight.
+/// @pre the spans are the same size.
+/// @param static_pressures the static pressures in Pascals.
+/// @param impact_pressures the impact pressures in Pascals.
+/// @param total_temperatures the total air temperatures in Kelvin.
+/// @param air_data the columns of air data.
+/// @param recovery_factor the recovery factor of the temperature probe,
+/// default 1.
+template <typename T>
+  requires std::floating_point<T>
+constexpr void calculate_air_data(std::span<const T> static_pressures,
+                                  std::span<const T> impact_pressures,
+                                  std::span<const T> total_temperatures,
+                                  const AirDataColumns<T> &air_data,
+                                  const T recovery_factor = T(1)) {
+  const auto size{static_pressures.size()};
+  Expects(impact_pressures.size() == size);
+  Expects(total_temperatures.size() == size);
+  Expects(air_data.pressure_altitudes.size() == size);
+  Expects(air_data.cas.size() == size);
+  Expects(air_data.machs.size() == size);
+  Expects(air_data.static_temperatures.size() == size);
+  Expects(air_data.tas.size() == size);
+
+  for (std::size_t i{}; i < size; ++i) {
+    const auto values{calculate_air_data(
+        units::si::Pascals<T>(static_pressures[i]),
+        units::si::Pascals<T>(impact_pressures[i]),
+        units::si::Kelvin<T>(total_temperatures[i]), recovery_factor)};
+    air_data.pressure_altitudes[i] = values.pressure_altitude.v();
+    air_data.cas[i] = values.cas.v();
+    air_data.machs[i] = values.mach;
+    air_data.static_temperatures[i] = values.static_temperature.v();
+    air_data.tas[i] = values.tas.v();
+  }
+}
+
+} // namespace isa
+} // namespace via
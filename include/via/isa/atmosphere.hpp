@@ -0,0 +1,283 @@
+#pragma once
+
+//////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2024 Ken Barker
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//////////////////////////////////////////////////////////////////////////////
+/// @file
+/// @brief Non-standard day atmosphere models and a handle to the current
+/// model which can be updated while many threads read it.
+///
+/// An `Atmosphere` holds a QNH and a temperature deviation from ISA with
+/// the coefficients which convert between QNH (indicated) altitudes and
+/// pressure altitudes. Below the tropopause, the conversion is linear:
+///
+///     pressure_altitude = offset + factor * qnh_altitude
+///
+/// where `factor = (QNH / P0)^(-L R / g)` and `offset` is the pressure
+/// altitude of QNH.
+///
+/// An `AtmosphereHandle` holds the current Atmosphere using read, copy,
+/// update (RCU) with epoch based reclamation: readers increment a counter
+/// of the current epoch, read the current model and decrement the counter,
+/// without blocking or taking a lock. An update replaces the current model
+/// atomically, so readers see it immediately, then advances the epoch and
+/// waits for the readers of the previous epoch to finish before deleting the
+/// previous model.
+//////////////////////////////////////////////////////////////////////////////
+#include "../isa.hpp"
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+namespace via {
+namespace isa {
+
+/// A non-standard day atmosphere.
+template <typename T>
+  requires std::floating_point<T>
+class Atmosphere {
+  units::si::Pascals<T> qnh_;
+  units::si::Kelvin<T> delta_temperature_;
+  /// The pressure altitude of QNH in metres.
+  T offset_;
+  /// The ratio of pressure altitude to QNH altitude.
+  T factor_;
+
+public:
+  /// Constructor.
+  /// @pre qnh > 0
+  /// @param qnh the pressure at mean sea level in Pascals.
+  /// @param delta_temperature the difference from ISA temperature at Sea
+  /// level in Kelvin.
+  explicit Atmosphere(
+      const units::si::Pascals<T> qnh = constants::SEA_LEVEL_PRESSURE<T>,
+      const units::si::Kelvin<T> delta_temperature = units::si::Kelvin<T>(0))
+      : qnh_{qnh}, delta_temperature_{delta_temperature},
+        offset_{calculate_troposphere_altitude(qnh).v()},
+        factor_{std::pow(qnh.v() / constants::SEA_LEVEL_PRESSURE<T>.v(),
+                         TEMPERATURE_POWER<T>)} {
+    Expects(qnh.v() > T());
+  }
+
+  /// @return the pressure at mean sea level in Pascals.
+  [[nodiscard]] auto qnh() const noexcept -> units::si::Pascals<T> {
+    return qnh_;
+  }
+
+  /// @return the difference from ISA temperature at Sea level in Kelvin.
+  [[nodiscard]] auto delta_temperature() const noexcept
+      -> units::si::Kelvin<T> {
+    return delta_temperature_;
+  }
+
+  /// @return the pressure altitude of QNH in metres.
+  [[nodiscard]] auto offset() const noexcept -> units::si::Metres<T> {
+    return units::si::Metres<T>(offset_);
+  }
+
+  /// @return the ratio of pressure altitude to QNH altitude.
+  [[nodiscard]] auto factor() const noexcept -> T { return factor_; }
+
+  /// Calculate the pressure altitude of an altitude indicated by an
+  /// altimeter set to QNH.
+  /// @pre the altitude is below the tropopause.
+  /// @param qnh_altitude the indicated altitude in metres.
+  /// @return the pressure altitude in metres.
+  [[nodiscard("Pure Function")]]
+  auto pressure_altitude(const units::si::Metres<T> qnh_altitude) const noexcept
+      -> units::si::Metres<T> {
+    return units::si::Metres<T>(offset_ + factor_ * qnh_altitude.v());
+  }
+
+  /// Calculate the altitude indicated by an altimeter set to QNH.
+  /// @pre the altitude is below the tropopause.
+  /// @param pressure_altitude the pressure altitude in metres.
+  /// @return the indicated altitude in metres.
+  [[nodiscard("Pure Function")]]
+  auto qnh_altitude(const units::si::Metres<T> pressure_altitude) const noexcept
+      -> units::si::Metres<T> {
+    return units::si::Metres<T>((pressure_altitude.v() - offset_) / factor_);
+  }
+
+  /// Calculate the pressure at a pressure altitude.
+  /// @param pressure_altitude the pressure altitude in metres.
+  /// @return the pressure in Pascals.
+  [[nodiscard("Pure Function")]]
+  auto pressure(const units::si::Metres<T> pressure_altitude) const
+      -> units::si::Pascals<T> {
+    return calculate_isa_pressure(pressure_altitude);
+  }
+
+  /// Calculate the temperature at a pressure altitude.
+  /// @param pressure_altitude the pressure altitude in metres.
+  /// @return the temperature in Kelvin.
+  [[nodiscard("Pure Function")]]
+  auto temperature(const units::si::Metres<T> pressure_altitude) const
+      -> units::si::Kelvin<T> {
+    return calculate_isa_temperature(pressure_altitude, delta_temperature_);
+  }
+
+  /// Calculate the air density at a pressure altitude.
+  /// @param pressure_altitude the pressure altitude in metres.
+  /// @return the density in Kg per cubic metre.
+  [[nodiscard("Pure Function")]]
+  auto density(const units::si::Metres<T> pressure_altitude) const
+      -> units::si::KilogramsPerCubicMetre<T> {
+    return calculate_density(pressure(pressure_altitude),
+                             temperature(pressure_altitude));
+  }
+
+  /// Calculate the True Air Speed from the Calibrated Air Speed.
+  /// @param cas the Calibrated Air Speed in metres per second.
+  /// @param pressure_altitude the pressure altitude in metres.
+  /// @return the True Air Speed in metres per second.
+  [[nodiscard("Pure Function")]]
+  auto true_air_speed(const units::si::MetresPerSecond<T> cas,
+                      const units::si::Metres<T> pressure_altitude) const
+      -> units::si::MetresPerSecond<T> {
+    return calculate_true_air_speed(cas, pressure(pressure_altitude),
+                                    temperature(pressure_altitude));
+  }
+
+  /// Calculate the Calibrated Air Speed from the True Air Speed.
+  /// @param tas the True Air Speed in metres per second.
+  /// @param pressure_altitude the pressure altitude in metres.
+  /// @return the Calibrated Air Speed in metres per second.
+  [[nodiscard("Pure Function")]]
+  auto calibrated_air_speed(const units::si::MetresPerSecond<T> tas,
+                            const units::si::Metres<T> pressure_altitude) const
+      -> units::si::MetresPerSecond<T> {
+    return calculate_calibrated_air_speed(tas, pressure(pressure_altitude),
+                                          temperature(pressure_altitude));
+  }
+};
+
+/// A handle to the current Atmosphere, which may be updated while other
+/// threads read it.
+template <typename T>
+  requires std::floating_point<T>
+class AtmosphereHandle {
+  /// The number of reader counters of each epoch, so that readers on
+  /// different threads do not usually share a cache line.
+  static constexpr std::size_t SHARDS{64};
+
+  struct alignas(64) Counter {
+    std::atomic<std::int64_t> readers{0};
+  };
+
+  std::atomic<const Atmosphere<T> *> current_;
+  std::atomic<std::uint64_t> epoch_{0};
+  /// The reader counters of even and odd epochs.
+  std::array<std::array<Counter, SHARDS>, 2> counters_{};
+  std::mutex update_mutex_;
+
+  /// @return the counter shard of the calling thread.
+  [[nodiscard]] static auto shard() noexcept -> std::size_t {
+    static std::atomic<std::size_t> next{0};
+    thread_local const std::size_t index{
+        next.fetch_add(1, std::memory_order_relaxed) % SHARDS};
+    return index;
+  }
+
+public:
+  /// Holds the Atmosphere of an epoch while it is read.
+  class ReadGuard {
+    std::atomic<std::int64_t> &readers_;
+    const Atmosphere<T> *atmosphere_;
+
+  public:
+    ReadGuard(std::atomic<std::int64_t> &readers,
+              const Atmosphere<T> *atmosphere) noexcept
+        : readers_{readers}, atmosphere_{atmosphere} {}
+
+    ~ReadGuard() { readers_.fetch_sub(1, std::memory_order_release); }
+
+    ReadGuard(const ReadGuard &) = delete;
+    ReadGuard &operator=(const ReadGuard &) = delete;
+
+    [[nodiscard]] auto operator*() const noexcept -> const Atmosphere<T> & {
+      return *atmosphere_;
+    }
+
+    [[nodiscard]] auto operator->() const noexcept -> const Atmosphere<T> * {
+      return atmosphere_;
+    }
+  };
+
+  /// Constructor.
+  /// @param atmosphere the initial Atmosphere.
+  explicit AtmosphereHandle(const Atmosphere<T> &atmosphere = Atmosphere<T>())
+      : current_{new Atmosphere<T>(atmosphere)} {}
+
+  /// Destructor.
+  /// @pre there are no readers.
+  ~AtmosphereHandle() { delete current_.load(); }
+
+  AtmosphereHandle(const AtmosphereHandle &) = delete;
+  AtmosphereHandle &operator=(const AtmosphereHandle &) = delete;
+
+  /// Read the current Atmosphere.
+  /// The Atmosphere is valid while the guard exists, so guards should not be
+  /// held for long, since they delay the next update.
+  /// @return a guard holding the current Atmosphere.
+  [[nodiscard]] auto read() noexcept -> ReadGuard {
+    const auto index{shard()};
+    while (true) {
+      const auto epoch{epoch_.load(std::memory_order_seq_cst)};
+      auto &readers{counters_[epoch & 1][index].readers};
+      readers.fetch_add(1, std::memory_order_seq_cst);
+      // If an update advanced the epoch meanwhile, it may not wait for this
+      // reader, so read again in the new epoch.
+      if (epoch_.load(std::memory_order_seq_cst) == epoch)
+        return ReadGuard(readers, current_.load(std::memory_order_seq_cst));
+      readers.fetch_sub(1, std::memory_order_release);
+    }
+  }
+
+  /// Replace the current Atmosphere.
+  /// New readers see the new Atmosphere immediately. The call waits for
+  /// the readers of the previous Atmosphere to finish before deleting it.
+  /// @param atmosphere the new Atmosphere.
+  void update(const Atmosphere<T> &atmosphere) {
+    auto next{std::make_unique<const Atmosphere<T>>(atmosphere)};
+
+    const std::lock_guard lock{update_mutex_};
+    const std::unique_ptr<const Atmosphere<T>> previous{
+        current_.exchange(next.release(), std::memory_order_seq_cst)};
+    const auto epoch{epoch_.fetch_add(1, std::memory_order_seq_cst)};
+
+    // Wait for the readers of the previous epoch
+    for (auto &counter : counters_[epoch & 1])
+      while (counter.readers.load(std::memory_order_acquire))
+        std::this_thread::yield();
+  }
+
+  /// @return the number of updates.
+  [[nodiscard]] auto epoch() const noexcept -> std::uint64_t {
+    return epoch_.load(std::memory_order_acquire);
+  }
+};
+
+} // namespace isa
+} // namespace via
@@ -0,0 +1,307 @@
+#pragma once
+
+//////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2024 Ken Barker
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//////////////////////////////////////////////////////////////////////////////
+/// @file
+/// @brief Batch versions of the via::isa functions.
+///
+/// The batch functions take contiguous columns of values in the SI units of
+/// the corresponding scalar functions and write their results to a column of
+/// the same size.
+/// They are simple loops over the scalar functions, so their results are
+/// identical to the scalar functions and compilers are free to vectorise
+/// them.
+//////////////////////////////////////////////////////////////////////////////
+#include "../isa.hpp"
+#include <span>
+
+namespace via {
+namespace isa {
+namespace batch {
+
+/// Calculate the ISA pressures corresponding to the given altitudes.
+/// @param altitudes the pressure altitudes in metres.
+/// @param pressures the pressures in Pascals.
+template <typename T>
+  requires std::floating_point<T>
+constexpr void calculate_isa_pressure(std::span<const T> altitudes,
+                                      std::span<T> pressures) {
+  Expects(altitudes.size() == pressures.size());
+
+  for (std::size_t i{}; i < altitudes.size(); ++i)
+    pressures[i] =
+        isa::calculate_isa_pressure(units::si::Metres<T>(altitudes[i])).v();
+}
+
+/// Calculate the altitudes corresponding to the given pressures.
+/// @param pressures the pressures in Pascals.
+/// @param altitudes the pressure altitudes in metres.
+template <typename T>
+  requires std::floating_point<T>
+constexpr void calculate_isa_altitude(std::span<const T> pressures,
+                                      std::span<T> altitudes) {
+  Expects(pressures.size() == altitudes.size());
+
+  for (std::size_t i{}; i < pressures.size(); ++i)
+    altitudes[i] =
+        isa::calculate_isa_altitude(units::si::Pascals<T>(pressures[i])).v();
+}
+
+/// Calculate the ISA temperatures corresponding to the given altitudes and
+/// difference in Sea level temperature.
+/// @param altitudes the pressure altitudes in metres.
+/// @param delta_temperature the difference from ISA temperature at Sea level
+/// in Kelvin.
+/// @param temperatures the temperatures in Kelvin.
+template <typename T>
+  requires std::floating_point<T>
+constexpr void calculate_isa_temperature(std::span<const T> altitudes,
+                                         const T delta_temperature,
+                                         std::span<T> temperatures) {
+  Expects(altitudes.size() == temperatures.size());
+
+  const auto delta{units::si::Kelvin<T>(delta_temperature)};
+  for (std::size_t i{}; i < altitudes.size(); ++i)
+    temperatures[i] = isa::calculate_isa_temperature(
+                          units::si::Metres<T>(altitudes[i]), delta)
+                          .v();
+}
+
+/// Calculate the ISA temperatures corresponding to the given altitudes and
+/// differences in Sea level temperature.
+/// @param altitudes the pressure altitudes in metres.
+/// @param delta_temperatures the differences from ISA temperature at Sea
+/// level in Kelvin.
+/// @param temperatures the temperatures in Kelvin.
+template <typename T>
+  requires std::floating_point<T>
+constexpr void calculate_isa_temperature(std::span<const T> altitudes,
+                                         std::span<const T> delta_temperatures,
+                                         std::span<T> temperatures) {
+  Expects(altitudes.size() == delta_temperatures.size());
+  Expects(altitudes.size() == temperatures.size());
+
+  for (std::size_t i{}; i < altitudes.size(); ++i)
+    temperatures[i] = isa::calculate_isa_temperature(
+                          units::si::Metres<T>(altitudes[i]),
+                          units::si::Kelvin<T>(delta_temperatures[i]))
+                          .v();
+}
+
+/// Calculate the air densities given the air pressures and temperatures.
+/// @pre temperatures > 0
+/// @param pressures the pressures in Pascals.
+/// @param temperatures the temperatures in Kelvin.
+/// @param densities the densities in Kg per cubic metre.
+template <typename T>
+  requires std::floating_point<T>
+constexpr void calculate_density(std::span<const T> pressures,
+                                 std::span<const T> temperatures,
+                                 std::span<T> densities) {
+  Expects(pressures.size() == temperatures.size());
+  Expects(pressures.size() == densities.size());
+
+  for (std::size_t i{}; i < pressures.size(); ++i)
+    densities[i] =
+        isa::calculate_density(units::si::Pascals<T>(pressures[i]),
+                               units::si::Kelvin<T>(temperatures[i]))
+            .v();
+}
+
+/// Calculate the True Air Speeds (TAS) from the Calibrated Air Speeds (CAS)
+/// at the given pressures and temperatures.
+/// @param cas the Calibrated Air Speeds in metres per second.
+/// @param pressures the pressures in Pascals.
+/// @param temperatures the temperatures in Kelvin.
+/// @param tas the True Air Speeds in metres per second.
+template <typename T>
+  requires std::floating_point<T>
+constexpr void calculate_true_air_speed(std::span<const T> cas,
+                                        std::span<const T> pressures,
+                                        std::span<const T> temperatures,
+                                        std::span<T> tas) {
+  Expects(cas.size() == pressures.size());
+  Expects(cas.size() == temperatures.size());
+  Expects(cas.size() == tas.size());
+
+  for (std::size_t i{}; i < cas.size(); ++i)
+    tas[i] = isa::calculate_true_air_speed(
+                 units::si::MetresPerSecond<T>(cas[i]),
+                 units::si::Pascals<T>(pressures[i]),
+                 units::si::Kelvin<T>(temperatures[i]))
+                 .v();
+}
+
+/// Calculate the Calibrated Air Speeds (CAS) from the True Air Speeds (TAS)
+/// at the given pressures and temperatures.
+/// @param tas the True Air Speeds in metres per second.
+/// @param pressures the pressures in Pascals.
+/// @param temperatures the temperatures in Kelvin.
+/// @param cas the Calibrated Air Speeds in metres per second.
+template <typename T>
+  requires std::floating_point<T>
+constexpr void calculate_calibrated_air_speed(std::span<const T> tas,
+                                              std::span<const T> pressures,
+                                              std::span<const T> temperatures,
+                                              std::span<T> cas) {
+  Expects(tas.size() == pressures.size());
+  Expects(tas.size() == temperatures.size());
+  Expects(tas.size() == cas.size());
+
+  for (std::size_t i{}; i < tas.size(); ++i)
+    cas[i] = isa::calculate_calibrated_air_speed(
+                 units::si::MetresPerSecond<T>(tas[i]),
+                 units::si::Pascals<T>(pressures[i]),
+                 units::si::Kelvin<T>(temperatures[i]))
+                 .v();
+}
+
+/// Calculate the speeds of sound for the given temperatures.
+/// @pre temperatures > 0
+/// @param temperatures the temperatures in Kelvin.
+/// @param speeds the speeds of sound in metres per second.
+template <typename T>
+  requires std::floating_point<T>
+constexpr void speed_of_sound(std::span<const T> temperatures,
+                              std::span<T> speeds) {
+  Expects(temperatures.size() == speeds.size());
+
+  for (std::size_t i{}; i < temperatures.size(); ++i)
+    speeds[i] =
+        isa::speed_of_sound(units::si::Kelvin<T>(temperatures[i])).v();
+}
+
+/// Calculate the True Air Speeds (TAS) from the Mach numbers at the given
+/// temperatures.
+/// @pre machs > 0
+/// @param machs the Mach numbers.
+/// @param temperatures the temperatures in Kelvin.
+/// @param tas the True Air Speeds in metres per second.
+template <typename T>
+  requires std::floating_point<T>
+constexpr void mach_true_air_speed(std::span<const T> machs,
+                                   std::span<const T> temperatures,
+                                   std::span<T> tas) {
+  Expects(machs.size() == temperatures.size());
+  Expects(machs.size() == tas.size());
+
+  for (std::size_t i{}; i < machs.size(); ++i)
+    tas[i] = isa::mach_true_air_speed(machs[i],
+                                      units::si::Kelvin<T>(temperatures[i]))
+                 .v();
+}
+
+/// Calculate the Mach numbers from the True Air Speeds (TAS) at the given
+/// temperatures.
+/// @param tas the True Air Speeds in metres per second.
+/// @param temperatures the temperatures in Kelvin.
+/// @param machs the Mach numbers.
+template <typename T>
+  requires std::floating_point<T>
+constexpr void true_air_speed_mach(std::span<const T> tas,
+                                   std::span<const T> temperatures,
+                                   std::span<T> machs) {
+  Expects(tas.size() == temperatures.size());
+  Expects(tas.size() == machs.size());
+
+  for (std::size_t i{}; i < tas.size(); ++i)
+    machs[i] = isa::true_air_speed_mach(units::si::MetresPerSecond<T>(tas[i]),
+                                        units::si::Kelvin<T>(temperatures[i]));
+}
+
+/// Calculate the impact pressures corresponding to the Calibrated Air Speeds
+/// (CAS).
+/// @param cas the Calibrated Air Speeds in metres per second.
+/// @param pressures the impact pressures in Pascals.
+template <typename T>
+  requires std::floating_point<T>
+constexpr void calculate_impact_pressure(std::span<const T> cas,
+                                         std::span<T> pressures) {
+  Expects(cas.size() == pressures.size());
+
+  for (std::size_t i{}; i < cas.size(); ++i)
+    pressures[i] =
+        isa::calculate_impact_pressure(units::si::MetresPerSecond<T>(cas[i]))
+            .v();
+}
+
+/// Calculate the Mach numbers from the Calibrated Air Speeds (CAS) at the
+/// given pressures.
+/// @param cas the Calibrated Air Speeds in metres per second.
+/// @param pressures the pressures in Pascals.
+/// @param machs the Mach numbers.
+template <typename T>
+  requires std::floating_point<T>
+constexpr void calibrated_air_speed_mach(std::span<const T> cas,
+                                         std::span<const T> pressures,
+                                         std::span<T> machs) {
+  Expects(cas.size() == pressures.size());
+  Expects(cas.size() == machs.size());
+
+  for (std::size_t i{}; i < cas.size(); ++i)
+    machs[i] = isa::calibrated_air_speed_mach(
+        units::si::MetresPerSecond<T>(cas[i]),
+        units::si::Pascals<T>(pressures[i]));
+}
+
+/// Calculate the Calibrated Air Speeds (CAS) from the Mach numbers at the
+/// given pressures.
+/// @param machs the Mach numbers.
+/// @param pressures the pressures in Pascals.
+/// @param cas the Calibrated Air Speeds in metres per second.
+template <typename T>
+  requires std::floating_point<T>
+constexpr void mach_calibrated_air_speed(std::span<const T> machs,
+                                         std::span<const T> pressures,
+                                         std::span<T> cas) {
+  Expects(machs.size() == pressures.size());
+  Expects(machs.size() == cas.size());
+
+  for (std::size_t i{}; i < machs.size(); ++i)
+    cas[i] = isa::mach_calibrated_air_speed(
+                 machs[i], units::si::Pascals<T>(pressures[i]))
+                 .v();
+}
+
+/// Calculate the crossover altitudes for the given Calibrated Air Speeds
+/// (CAS) and Mach numbers.
+/// @pre machs > 0
+/// @param cas the Calibrated Air Speeds in metres per second.
+/// @param machs the Mach numbers.
+/// @param altitudes the crossover altitudes in metres.
+template <typename T>
+  requires std::floating_point<T>
+constexpr void calculate_crossover_altitude(std::span<const T> cas,
+                                            std::span<const T> machs,
+                                            std::span<T> altitudes) {
+  Expects(cas.size() == machs.size());
+  Expects(cas.size() == altitudes.size());
+
+  for (std::size_t i{}; i < cas.size(); ++i)
+    altitudes[i] = isa::calculate_crossover_altitude(
+                       units::si::MetresPerSecond<T>(cas[i]), machs[i])
+                       .v();
+}
+
+} // namespace batch
+} // namespace isa
+} // namespace via
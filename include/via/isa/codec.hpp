@@ -0,0 +1,319 @@
+#pragma once
+
+//////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2024 Ken Barker
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//////////////////////////////////////////////////////////////////////////////
+/// @file
+/// @brief A lossy codec for smooth columns of air data, e.g. pressure,
+/// density, TAS and Mach number per sample.
+///
+/// Values are quantized to a tolerance, i.e. `q = round(v / step)` where
+/// `step = 2 * tolerance`, so a decoded value is within the tolerance of
+/// the original value.
+/// The quantized values are encoded in independent blocks of 128 values:
+/// the differences (first order) or the differences of differences (second
+/// order) between consecutive values are zigzag encoded, so that small
+/// negative differences are small unsigned numbers, and bit packed with the
+/// smallest bit width of the block.
+///
+/// A block is stored in 64 bit words: the first quantized value, a word
+/// containing the bit width, the order and the first difference, then
+/// `2 * width` words of packed values.
+/// The packed values are unpacked by a function instantiated for each bit
+/// width, so the shifts and masks are constants and the loops can be
+/// unrolled and vectorised by the compiler.
+/// Blocks are decoded directly into spans, e.g. the input spans of the batch
+/// functions.
+//////////////////////////////////////////////////////////////////////////////
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cmath>
+#include <concepts>
+#include <cstdint>
+#include <gsl/assert>
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace via {
+namespace isa {
+namespace codec {
+
+/// The number of values in a block.
+constexpr std::size_t BLOCK_SIZE{128};
+
+/// The number of header words of a block.
+constexpr std::size_t HEADER_WORDS{2};
+
+/// The largest magnitude of a quantized value, so that the differences of
+/// differences cannot overflow.
+constexpr std::int64_t MAX_QUANTIZED{std::int64_t(1) << 60};
+
+/// The number of bits of the header word used by the bit width and order.
+constexpr unsigned HEADER_BITS{16};
+
+/// A column of encoded values.
+template <typename T>
+  requires std::floating_point<T>
+struct EncodedColumn {
+  /// The quantization step: twice the tolerance.
+  T step{};
+  /// The number of values.
+  std::size_t size{};
+  /// The index of the first word of each block, plus the number of words.
+  /// It is an index which can be rebuilt from the block headers.
+  std::vector<std::size_t> offsets{0};
+  /// The encoded blocks.
+  std::vector<std::uint64_t> words;
+
+  /// @return the number of blocks.
+  [[nodiscard]] auto blocks() const noexcept -> std::size_t {
+    return offsets.size() - 1;
+  }
+
+  /// @return the number of bytes of the encoded blocks.
+  [[nodiscard]] auto bytes() const noexcept -> std::size_t {
+    return words.size() * sizeof(std::uint64_t);
+  }
+
+  /// @return the size of the values divided by the size of the encoded
+  /// blocks.
+  [[nodiscard]] auto compression_ratio() const noexcept -> double {
+    return bytes() ? static_cast<double>(size * sizeof(T)) /
+                         static_cast<double>(bytes())
+                   : 0.0;
+  }
+};
+
+namespace detail {
+/// @return the zigzag encoding of a signed value.
+[[nodiscard]] constexpr auto zigzag(const std::uint64_t value) noexcept
+    -> std::uint64_t {
+  return (value << 1) ^
+         static_cast<std::uint64_t>(static_cast<std::int64_t>(value) >> 63);
+}
+
+/// @return the signed value of a zigzag encoding, as an unsigned value.
+[[nodiscard]] constexpr auto unzigzag(const std::uint64_t value) noexcept
+    -> std::uint64_t {
+  return (value >> 1) ^ (0 - (value & 1));
+}
+
+/// Pack BLOCK_SIZE values into `2 * width` words.
+inline void pack(std::span<const std::uint64_t, BLOCK_SIZE> values,
+                 const unsigned width, std::span<std::uint64_t> words) {
+  std::fill(words.begin(), words.end(), 0);
+  if (width == 0)
+    return;
+
+  for (std::size_t i{}; i < BLOCK_SIZE; ++i) {
+    const auto bit{i * width};
+    const auto word{bit / 64};
+    const auto shift{bit % 64};
+    words[word] |= values[i] << shift;
+    if (shift + width > 64)
+      words[word + 1] |= values[i] >> (64 - shift);
+  }
+}
+
+/// Unpack BLOCK_SIZE values of a constant bit width from `2 * WIDTH` words.
+template <unsigned WIDTH>
+void unpack(const std::uint64_t *words,
+            std::span<std::uint64_t, BLOCK_SIZE> values) noexcept {
+  if constexpr (WIDTH == 0) {
+    std::fill(values.begin(), values.end(), 0);
+  } else {
+    constexpr auto MASK{WIDTH == 64 ? ~std::uint64_t()
+                                    : (std::uint64_t(1) << WIDTH) - 1};
+    for (std::size_t i{}; i < BLOCK_SIZE; ++i) {
+      const auto bit{i * WIDTH};
+      const auto word{bit / 64};
+      const auto shift{bit % 64};
+      auto value{words[word] >> shift};
+      if (shift + WIDTH > 64)
+        value |= words[word + 1] << (64 - shift);
+      values[i] = value & MASK;
+    }
+  }
+}
+
+using Unpack = void (*)(const std::uint64_t *,
+                        std::span<std::uint64_t, BLOCK_SIZE>) noexcept;
+
+/// The unpack functions of each bit width.
+inline constexpr auto UNPACK{[]<unsigned... W>(
+                                 std::integer_sequence<unsigned, W...>) {
+  return std::array<Unpack, sizeof...(W)>{&unpack<W>...};
+}(std::make_integer_sequence<unsigned, 65>{})};
+
+/// Encode a block of quantized values.
+inline void encode_block(std::span<const std::int64_t> quantized,
+                         std::vector<std::uint64_t> &words) {
+  const auto n{quantized.size()};
+  std::array<std::uint64_t, BLOCK_SIZE> first{};
+  std::array<std::uint64_t, BLOCK_SIZE> second{};
+  std::uint64_t first_max{};
+  std::uint64_t second_max{};
+  const auto q{[&](const std::size_t i) {
+    return static_cast<std::uint64_t>(quantized[i]);
+  }};
+  for (std::size_t i{1}; i < n; ++i) {
+    first[i - 1] = zigzag(q(i) - q(i - 1));
+    first_max |= first[i - 1];
+  }
+  for (std::size_t i{2}; i < n; ++i) {
+    second[i - 2] = zigzag(q(i) - q(i - 1) - (q(i - 1) - q(i - 2)));
+    second_max |= second[i - 2];
+  }
+
+  // Use second order if it is narrower and the first difference fits
+  const auto first_difference{n > 1 ? first[0] : 0};
+  const bool second_order{
+      (std::bit_width(second_max) < std::bit_width(first_max)) &&
+      (std::bit_width(first_difference) <= 64 - HEADER_BITS)};
+  const auto width{static_cast<unsigned>(
+      std::bit_width(second_order ? second_max : first_max))};
+
+  words.push_back(q(0));
+  words.push_back(width | (std::uint64_t(second_order) << 8) |
+                  (second_order ? first_difference << HEADER_BITS : 0));
+  const auto begin{words.size()};
+  words.resize(begin + 2 * width);
+  pack(second_order ? second : first, width,
+       std::span<std::uint64_t>(words).subspan(begin));
+}
+
+/// Decode a block of values.
+template <typename T>
+void decode_block(const std::uint64_t *words, const T step,
+                  std::span<T> values) noexcept {
+  const auto header{words[1]};
+  const auto width{static_cast<unsigned>(header & 0xff)};
+  const bool second_order{((header >> 8) & 1) != 0};
+
+  std::array<std::uint64_t, BLOCK_SIZE> residuals;
+  UNPACK[width](words + HEADER_WORDS, residuals);
+
+  // Integrate the differences
+  auto q{words[0]};
+  values[0] = static_cast<T>(static_cast<std::int64_t>(q)) * step;
+  if (second_order) {
+    auto difference{unzigzag(header >> HEADER_BITS)};
+    if (values.size() > 1) {
+      q += difference;
+      values[1] = static_cast<T>(static_cast<std::int64_t>(q)) * step;
+    }
+    for (std::size_t i{2}; i < values.size(); ++i) {
+      difference += unzigzag(residuals[i - 2]);
+      q += difference;
+      values[i] = static_cast<T>(static_cast<std::int64_t>(q)) * step;
+    }
+  } else {
+    for (std::size_t i{1}; i < values.size(); ++i) {
+      q += unzigzag(residuals[i - 1]);
+      values[i] = static_cast<T>(static_cast<std::int64_t>(q)) * step;
+    }
+  }
+}
+} // namespace detail
+
+/// Encode a column of values.
+/// @pre tolerance > 0 and the values are finite and less than 2^60 times
+/// the quantization step.
+/// @param values the values to encode.
+/// @param tolerance the largest difference between a value and its decoded
+/// value.
+/// @return the encoded column.
+template <typename T>
+  requires std::floating_point<T>
+[[nodiscard]] auto encode(std::span<const T> values, const T tolerance)
+    -> EncodedColumn<T> {
+  Expects(tolerance > T());
+
+  EncodedColumn<T> column{T(2) * tolerance, values.size(), {0}, {}};
+  column.offsets.reserve((values.size() + BLOCK_SIZE - 1) / BLOCK_SIZE + 1);
+
+  std::array<std::int64_t, BLOCK_SIZE> quantized;
+  for (std::size_t begin{}; begin < values.size(); begin += BLOCK_SIZE) {
+    const auto n{std::min(BLOCK_SIZE, values.size() - begin)};
+    for (std::size_t i{}; i < n; ++i) {
+      const T q{std::round(values[begin + i] / column.step)};
+      Expects(std::abs(q) < static_cast<T>(MAX_QUANTIZED));
+      quantized[i] = static_cast<std::int64_t>(q);
+    }
+    detail::encode_block(std::span<const std::int64_t>(quantized).first(n),
+                         column.words);
+    column.offsets.push_back(column.words.size());
+  }
+
+  return column;
+}
+
+/// Decode values from an encoded column.
+/// @pre begin + values.size() <= column.size
+/// @param column the encoded column.
+/// @param begin the index of the first value to decode.
+/// @param values the decoded values, e.g. the input span of a batch function.
+template <typename T>
+  requires std::floating_point<T>
+void decode(const EncodedColumn<T> &column, const std::size_t begin,
+            std::span<T> values) {
+  Expects(begin + values.size() <= column.size);
+
+  std::array<T, BLOCK_SIZE> buffer;
+  auto index{begin};
+  const auto end{begin + values.size()};
+  while (index < end) {
+    const auto block{index / BLOCK_SIZE};
+    const auto block_begin{block * BLOCK_SIZE};
+    const auto block_size{std::min(BLOCK_SIZE, column.size - block_begin)};
+    const auto first{index - block_begin};
+    const auto n{std::min(block_size - first, end - index)};
+    const auto *words{column.words.data() + column.offsets[block]};
+
+    // Decode whole blocks in place, partial blocks via the buffer
+    const auto output{values.subspan(index - begin)};
+    if ((first == 0) && (n == block_size))
+      detail::decode_block(words, column.step, output.first(n));
+    else {
+      detail::decode_block(words, column.step,
+                           std::span<T>(buffer).first(block_size));
+      std::copy_n(buffer.begin() + first, n, output.begin());
+    }
+    index += n;
+  }
+}
+
+/// Decode all of the values of an encoded column.
+/// @pre values.size() == column.size
+/// @param column the encoded column.
+/// @param values the decoded values.
+template <typename T>
+  requires std::floating_point<T>
+void decode(const EncodedColumn<T> &column, std::span<T> values) {
+  Expects(values.size() == column.size);
+  decode(column, 0, values);
+}
+
+} // namespace codec
+} // namespace isa
+} // namespace via
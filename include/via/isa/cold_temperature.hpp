@@ -0,0 +1,178 @@
+#pragma once
+
+//////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2024 Ken Barker
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//////////////////////////////////////////////////////////////////////////////
+/// @file
+/// @brief Cold temperature altimeter corrections, see ICAO Doc 8168
+/// PANS-OPS Volume I, Part III, Section 1, Chapter 4.
+///
+/// An altimeter set to the aerodrome QNH over-reads when the air is colder
+/// than ISA, so procedure minimum altitudes must be increased by a
+/// correction.
+/// Assuming that the temperature deviation at the aerodrome is constant
+/// with height and the lapse rate is the ISA lapse rate, the correction is
+/// the integral of `-delta_temperature / T(h)` over the height above the
+/// aerodrome, where `T(h)` is the ISA temperature:
+///
+///     correction = (-delta_temperature / L) * ln(1 + L * height / T_aerodrome)
+///
+/// The approximate correction is the simpler formula from PANS-OPS which
+/// is used where tables are not available.
+///
+/// Since the logarithm above does not depend upon the temperature, the
+/// batch functions calculate it once per height, so the corrections of all
+/// of the heights and temperatures are an outer product.
+//////////////////////////////////////////////////////////////////////////////
+#include "../isa.hpp"
+#include <span>
+#include <vector>
+
+namespace via {
+namespace isa {
+
+/// Calculate the height factor of the exact cold temperature correction:
+/// `ln(1 + L * height / T_aerodrome) / L`.
+/// @pre the heights are below the tropopause.
+/// @param height the height above the aerodrome in metres.
+/// @param aerodrome_elevation the aerodrome elevation in metres.
+/// @return the height factor in metres per Kelvin.
+template <typename T>
+  requires std::floating_point<T>
+[[nodiscard("Pure Function")]]
+auto cold_temperature_height_factor(const units::si::Metres<T> height,
+                                    const units::si::Metres<T> aerodrome_elevation)
+    -> T {
+  const T aerodrome_temperature{
+      calculate_isa_temperature(aerodrome_elevation).v()};
+  return std::log1p(constants::TEMPERATURE_GRADIENT<T> * height.v() /
+                    aerodrome_temperature) /
+         constants::TEMPERATURE_GRADIENT<T>;
+}
+
+/// Calculate the exact cold temperature correction of a height above an
+/// aerodrome.
+/// The correction is negative when the aerodrome is warmer than ISA.
+/// @pre the heights are below the tropopause.
+/// @param height the height above the aerodrome in metres.
+/// @param aerodrome_elevation the aerodrome elevation in metres.
+/// @param delta_temperature the difference from ISA temperature at the
+/// aerodrome in Kelvin.
+/// @return the correction to add to the height in metres.
+template <typename T>
+  requires std::floating_point<T>
+[[nodiscard("Pure Function")]]
+auto calculate_cold_temperature_correction(
+    const units::si::Metres<T> height,
+    const units::si::Metres<T> aerodrome_elevation,
+    const units::si::Kelvin<T> delta_temperature) -> units::si::Metres<T> {
+  return units::si::Metres<T>(
+      -delta_temperature.v() *
+      cold_temperature_height_factor(height, aerodrome_elevation));
+}
+
+/// Calculate the approximate cold temperature correction of a height above
+/// an aerodrome using the PANS-OPS formula:
+///
+///     correction = height * (15 - t0) / (273 + t0 - 0.5 * L0 * (height + elevation))
+///
+/// where t0 is the aerodrome temperature adjusted to sea level in °C, i.e.
+/// `15 + delta_temperature`, and L0 is 0.0065 K/m.
+/// @param height the height above the aerodrome in metres.
+/// @param aerodrome_elevation the aerodrome elevation in metres.
+/// @param delta_temperature the difference from ISA temperature at the
+/// aerodrome in Kelvin.
+/// @return the correction to add to the height in metres.
+template <typename T>
+  requires std::floating_point<T>
+[[nodiscard("Pure Function")]]
+constexpr auto approximate_cold_temperature_correction(
+    const units::si::Metres<T> height,
+    const units::si::Metres<T> aerodrome_elevation,
+    const units::si::Kelvin<T> delta_temperature) -> units::si::Metres<T> {
+  const T celsius{T(15) + delta_temperature.v()};
+  return units::si::Metres<T>(
+      height.v() * (T(15) - celsius) /
+      (T(273) + celsius +
+       T(0.5) * constants::TEMPERATURE_GRADIENT<T> *
+           (height.v() + aerodrome_elevation.v())));
+}
+
+/// Calculate the exact cold temperature corrections over a grid of heights
+/// and temperature deviations at an aerodrome.
+/// @pre the heights are below the tropopause.
+/// @param heights the heights above the aerodrome in metres, e.g. of the
+/// fixes of its procedures.
+/// @param aerodrome_elevation the aerodrome elevation in metres.
+/// @param delta_temperatures the differences from ISA temperature at the
+/// aerodrome in Kelvin.
+/// @param corrections the corrections in metres, by temperature deviation
+/// then height, i.e. corrections[d * heights.size() + h].
+template <typename T>
+  requires std::floating_point<T>
+void calculate_cold_temperature_corrections(
+    std::span<const T> heights, const units::si::Metres<T> aerodrome_elevation,
+    std::span<const T> delta_temperatures, std::span<T> corrections) {
+  const auto size{heights.size()};
+  Expects(corrections.size() == size * delta_temperatures.size());
+
+  std::vector<T> factors(size);
+  for (std::size_t i{}; i < size; ++i)
+    factors[i] = cold_temperature_height_factor(
+        units::si::Metres<T>(heights[i]), aerodrome_elevation);
+
+  for (std::size_t d{}; d < delta_temperatures.size(); ++d) {
+    const T delta_temperature{delta_temperatures[d]};
+    const auto row{corrections.subspan(d * size, size)};
+    for (std::size_t i{}; i < size; ++i)
+      row[i] = -delta_temperature * factors[i];
+  }
+}
+
+/// Calculate the approximate cold temperature corrections over a grid of
+/// heights and temperature deviations at an aerodrome.
+/// @param heights the heights above the aerodrome in metres.
+/// @param aerodrome_elevation the aerodrome elevation in metres.
+/// @param delta_temperatures the differences from ISA temperature at the
+/// aerodrome in Kelvin.
+/// @param corrections the corrections in metres, by temperature deviation
+/// then height, i.e. corrections[d * heights.size() + h].
+template <typename T>
+  requires std::floating_point<T>
+constexpr void approximate_cold_temperature_corrections(
+    std::span<const T> heights, const units::si::Metres<T> aerodrome_elevation,
+    std::span<const T> delta_temperatures, std::span<T> corrections) {
+  const auto size{heights.size()};
+  Expects(corrections.size() == size * delta_temperatures.size());
+
+  for (std::size_t d{}; d < delta_temperatures.size(); ++d) {
+    const auto delta_temperature{units::si::Kelvin<T>(delta_temperatures[d])};
+    const auto row{corrections.subspan(d * size, size)};
+    for (std::size_t i{}; i < size; ++i)
+      row[i] = approximate_cold_temperature_correction(
+                   units::si::Metres<T>(heights[i]), aerodrome_elevation,
+                   delta_temperature)
+                   .v();
+  }
+}
+
+} // namespace isa
+} // namespace via
@@ -0,0 +1,284 @@
+#pragma once
+
+//////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2024 Ken Barker
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//////////////////////////////////////////////////////////////////////////////
+/// @file
+/// @brief The Schmidt-Appleman criterion for the formation of contrails,
+/// see: Schumann, U. 1996: On conditions for contrail formation from
+/// aircraft exhausts.
+///
+/// As the hot, moist exhaust of an engine mixes with the ambient air, the
+/// temperature and vapour pressure of the mixture follow a straight line
+/// with a slope of:
+///
+///     G = EI_H2O * cp * p / (epsilon * Q * (1 - eta))
+///
+/// A contrail forms if the mixing line reaches water saturation. The
+/// saturation curve is convex, so the mixing line from the ambient air
+/// reaches it if and only if it reaches the point where the slope of the
+/// curve is G: the maximum threshold temperature, T_LM. So a contrail forms
+/// where the ambient temperature T and vapour pressure e satisfy:
+///
+///     T <= T_LM and e + G * (T_LM - T) >= e_sat_water(T_LM)
+///
+/// It persists if the ambient air is also saturated with respect to ice.
+///
+/// G and T_LM depend only upon pressure, so `calculate_contrails`
+/// calculates them once per flight level and then tests all of the points
+/// of the weather grid at that level in simple loops over blocks, which are
+/// shared between threads.
+//////////////////////////////////////////////////////////////////////////////
+#include "humidity.hpp"
+#include "parallel.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace via {
+namespace isa {
+
+/// The parameters of the aircraft engines and fuel.
+template <typename T>
+  requires std::floating_point<T>
+struct ContrailParameters {
+  /// The mass of water emitted per mass of fuel burnt, kg/kg.
+  T emission_index{1.25};
+  /// The specific heat capacity of air at constant pressure, J/(kg K).
+  T specific_heat{1004.0};
+  /// The specific combustion heat of the fuel, J/kg.
+  T combustion_heat{43.2e6};
+  /// The overall propulsion efficiency of the engines.
+  T propulsion_efficiency{0.3};
+};
+
+/// The contrail forms.
+constexpr std::uint8_t CONTRAIL_FORMS{1};
+/// The contrail persists: it forms and the air is saturated over ice.
+constexpr std::uint8_t CONTRAIL_PERSISTS{2};
+
+/// Calculate the slope of the mixing line of exhaust and ambient air.
+/// @param pressure the ambient pressure in Pascals.
+/// @param parameters the engine and fuel parameters.
+/// @return the slope in Pascals per Kelvin.
+template <typename T>
+  requires std::floating_point<T>
+[[nodiscard("Pure Function")]]
+constexpr auto
+calculate_mixing_line_slope(const units::si::Pascals<T> pressure,
+                            const ContrailParameters<T> &parameters = {})
+    -> T {
+  return parameters.emission_index * parameters.specific_heat * pressure.v() /
+         (humidity::EPSILON<T> * parameters.combustion_heat *
+          (T(1) - parameters.propulsion_efficiency));
+}
+
+/// Calculate the maximum threshold temperature: where the slope of the
+/// water saturation curve is the slope of the mixing line.
+/// Starts from the approximation of Schumann (1996) and refines it with
+/// Newton's method.
+/// @pre slope > 0.053
+/// @param slope the slope of the mixing line in Pascals per Kelvin.
+/// @return the maximum threshold temperature in Kelvin.
+template <typename T>
+  requires std::floating_point<T>
+[[nodiscard("Pure Function")]]
+auto calculate_maximum_threshold_temperature(const T slope)
+    -> units::si::Kelvin<T> {
+  constexpr T B{humidity::MAGNUS_B<T>};
+  constexpr T C{humidity::MAGNUS_C<T>};
+  Expects(slope > T(0.053));
+
+  const T log_slope{std::log(slope - T(0.053))};
+  T celsius{T(-46.46) + T(9.43) * log_slope + T(0.72) * log_slope * log_slope};
+
+  // Solve ln(de_sat/dt) = ln(slope), where
+  // de_sat/dt = e_sat * B * C / (t + C)^2
+  const T target{std::log(slope / (humidity::MAGNUS_PRESSURE<T> * B * C))};
+  for (int i{}; i < 20; ++i) {
+    const T t_c{celsius + C};
+    const T residual{B * celsius / t_c - T(2) * std::log(t_c) - target};
+    const T derivative{B * C / (t_c * t_c) - T(2) / t_c};
+    const T step{residual / derivative};
+    celsius -= step;
+    if (std::abs(step) < T(1e-9))
+      break;
+  }
+  return units::si::Kelvin<T>(celsius + humidity::ZERO_CELSIUS<T>);
+}
+
+/// Calculate the critical temperature below which a contrail forms in air
+/// with the given relative humidity over water.
+/// @pre 0 <= relative_humidity <= 1
+/// @param slope the slope of the mixing line in Pascals per Kelvin.
+/// @param relative_humidity the relative humidity over water, from 0 to 1.
+/// @return the critical temperature in Kelvin.
+template <typename T>
+  requires std::floating_point<T>
+[[nodiscard("Pure Function")]]
+auto calculate_critical_temperature(const T slope, const T relative_humidity)
+    -> units::si::Kelvin<T> {
+  constexpr T B{humidity::MAGNUS_B<T>};
+  constexpr T C{humidity::MAGNUS_C<T>};
+  Expects((T() <= relative_humidity) && (relative_humidity <= T(1)));
+
+  const T maximum{calculate_maximum_threshold_temperature(slope).v()};
+  const T saturation{
+      humidity::saturation_vapour_pressure(units::si::Kelvin<T>(maximum)).v()};
+
+  // Solve: saturation - slope * (maximum - x) = U * e_sat(x)
+  T x{maximum - (T(1) - relative_humidity) * saturation / slope};
+  for (int i{}; i < 20; ++i) {
+    const T vapour_pressure{
+        relative_humidity *
+        humidity::saturation_vapour_pressure(units::si::Kelvin<T>(x)).v()};
+    const T t_c{x - humidity::ZERO_CELSIUS<T> + C};
+    const T residual{saturation - slope * (maximum - x) - vapour_pressure};
+    const T derivative{slope - vapour_pressure * B * C / (t_c * t_c)};
+    const T step{residual / derivative};
+    x -= step;
+    if (std::abs(step) < T(1e-9))
+      break;
+  }
+  return units::si::Kelvin<T>(x);
+}
+
+/// The contrail properties of a flight level.
+template <typename T>
+  requires std::floating_point<T>
+struct ContrailLevel {
+  /// The pressure in Pascals.
+  T pressure;
+  /// The slope of the mixing line in Pascals per Kelvin.
+  T slope;
+  /// The maximum threshold temperature in Kelvin.
+  T threshold_temperature;
+  /// The saturation vapour pressure over water at the maximum threshold
+  /// temperature in Pascals.
+  T threshold_vapour_pressure;
+};
+
+/// Calculate the contrail properties of a flight level.
+/// @param altitude the pressure altitude of the flight level in metres.
+/// @param parameters the engine and fuel parameters.
+/// @return the contrail properties.
+template <typename T>
+  requires std::floating_point<T>
+[[nodiscard("Pure Function")]]
+auto calculate_contrail_level(const units::si::Metres<T> altitude,
+                              const ContrailParameters<T> &parameters = {})
+    -> ContrailLevel<T> {
+  const auto pressure{calculate_isa_pressure(altitude)};
+  const T slope{calculate_mixing_line_slope(pressure, parameters)};
+  const auto threshold{calculate_maximum_threshold_temperature(slope)};
+  return ContrailLevel<T>{pressure.v(), slope, threshold.v(),
+                          humidity::saturation_vapour_pressure(threshold).v()};
+}
+
+/// Test whether a contrail forms and persists in ambient air.
+/// @param level the contrail properties of the flight level.
+/// @param temperature the ambient temperature in Kelvin.
+/// @param specific_humidity the ambient specific humidity in kg/kg.
+/// @return the contrail flags: CONTRAIL_FORMS and CONTRAIL_PERSISTS.
+template <typename T>
+  requires std::floating_point<T>
+[[nodiscard("Pure Function")]]
+constexpr auto calculate_contrail_flags(const ContrailLevel<T> &level,
+                                        const T temperature,
+                                        const T specific_humidity)
+    -> std::uint8_t {
+  const T vapour_pressure{
+      specific_humidity * level.pressure /
+      (humidity::EPSILON<T> +
+       (T(1) - humidity::EPSILON<T>) * specific_humidity)};
+  const bool forms{(temperature <= level.threshold_temperature) &&
+                   (vapour_pressure +
+                        level.slope * (level.threshold_temperature - temperature) >=
+                    level.threshold_vapour_pressure)};
+  const bool ice_saturated{
+      vapour_pressure >=
+      humidity::saturation_vapour_pressure_ice(units::si::Kelvin<T>(temperature))
+          .v()};
+  return static_cast<std::uint8_t>(forms * CONTRAIL_FORMS |
+                                   (forms & ice_saturated) * CONTRAIL_PERSISTS);
+}
+
+/// The number of points of a weather grid tested together.
+constexpr std::size_t CONTRAIL_BLOCK_SIZE{4096};
+
+/// Calculate the contrail flags over flight levels and weather grids.
+/// @pre the spans of the weather grids are levels * points in size.
+/// @param altitudes the pressure altitudes of the flight levels in metres.
+/// @param temperatures the ambient temperatures in Kelvin, by flight level
+/// then point, i.e. temperatures[l * points + p].
+/// @param specific_humidities the ambient specific humidities in kg/kg, by
+/// flight level then point.
+/// @param flags the contrail flags, by flight level then point.
+/// @param parameters the engine and fuel parameters.
+/// @param threads the number of threads, zero for the hardware concurrency.
+/// @return the contrail properties of the flight levels.
+template <typename T>
+  requires std::floating_point<T>
+auto calculate_contrails(std::span<const T> altitudes,
+                         std::span<const T> temperatures,
+                         std::span<const T> specific_humidities,
+                         std::span<std::uint8_t> flags,
+                         const ContrailParameters<T> &parameters = {},
+                         const std::size_t threads = 0)
+    -> std::vector<ContrailLevel<T>> {
+  const auto levels{altitudes.size()};
+  Expects(temperatures.size() == specific_humidities.size());
+  Expects(temperatures.size() == flags.size());
+
+  std::vector<ContrailLevel<T>> contrail_levels(levels);
+  for (std::size_t l{}; l < levels; ++l)
+    contrail_levels[l] = calculate_contrail_level(
+        units::si::Metres<T>(altitudes[l]), parameters);
+  if (!levels) {
+    Expects(temperatures.empty());
+    return contrail_levels;
+  }
+
+  const auto points{temperatures.size() / levels};
+  Expects(points * levels == temperatures.size());
+  const auto blocks{(points + CONTRAIL_BLOCK_SIZE - 1) / CONTRAIL_BLOCK_SIZE};
+
+  parallel_for(
+      levels * blocks,
+      [&](const std::size_t task) {
+        const auto l{task / blocks};
+        const auto begin{(task % blocks) * CONTRAIL_BLOCK_SIZE};
+        const auto end{std::min(begin + CONTRAIL_BLOCK_SIZE, points)};
+        const auto level{contrail_levels[l]};
+        const auto offset{l * points};
+        for (auto i{offset + begin}; i < offset + end; ++i)
+          flags[i] = calculate_contrail_flags(level, temperatures[i],
+                                              specific_humidities[i]);
+      },
+      threads);
+
+  return contrail_levels;
+}
+
+} // namespace isa
+} // namespace via
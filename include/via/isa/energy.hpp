@@ -0,0 +1,176 @@
+#pragma once
+
+//////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2024 Ken Barker
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//////////////////////////////////////////////////////////////////////////////
+/// @file
+/// @brief Energy share factors and total energy for trajectory prediction.
+///
+/// The total energy model of BADA balances the rate of work done by the
+/// thrust minus the drag against the rate of change of the potential and
+/// kinetic energy of the aircraft. The energy share factor is the fraction
+/// of the total energy rate that is used to climb while holding a constant
+/// Calibrated Air Speed or Mach number:
+///
+///     f = 1 / (1 + (V / g) * dV/dh)
+///
+/// See BADA Rev 3.12, Section 3.8, Eq 3.8-8 to 3.8-11.
+///
+/// Below the tropopause, the speed of sound decreases with altitude at a
+/// constant Mach number, so f > 1 when climbing at a constant Mach number.
+/// Above the tropopause, the temperature is constant so f = 1 at a constant
+/// Mach number. At a constant CAS, the True Air Speed increases with
+/// altitude on both sides of the tropopause, so f < 1.
+///
+/// Note: `calculate_isa_temperature` limits temperatures to the tropopause
+/// temperature, so on a non-standard day the temperature gradient changes
+/// at the altitude where the temperature reaches the tropopause temperature,
+/// not at `TROPOPAUSE_ALTITUDE`. The factors are consistent with it.
+//////////////////////////////////////////////////////////////////////////////
+#include "../isa.hpp"
+#include <cstdint>
+#include <span>
+
+namespace via {
+namespace isa {
+
+/// The speed held by an aircraft during a flight segment.
+enum class SpeedHold : std::uint8_t {
+  /// A constant Calibrated Air Speed.
+  CAS,
+  /// A constant Mach number.
+  MACH
+};
+
+/// Calculate the energy share factor of a climb or descent.
+/// See BADA Rev 3.12, Eq 3.8-8 to 3.8-11.
+/// @param hold the speed held.
+/// @param mach the Mach number.
+/// @param altitude the pressure altitude in metres.
+/// @param delta_temperature the difference from ISA temperature at Sea
+/// level in Kelvin.
+/// @return the energy share factor.
+template <typename T>
+  requires std::floating_point<T>
+[[nodiscard("Pure Function")]]
+constexpr auto calculate_energy_share_factor(
+    const SpeedHold hold, const T mach, const units::si::Metres<T> altitude,
+    const units::si::Kelvin<T> delta_temperature = units::si::Kelvin<T>(0))
+    -> T {
+  constexpr T K_MINUS_1_OVER_2{(constants::K<T> - T(1)) / T(2)};
+  constexpr T CAS_POWER{T(-1) / (constants::K<T> - T(1))};
+  constexpr T MACH_FACTOR{constants::K<T> * constants::R<T> *
+                          constants::TEMPERATURE_GRADIENT<T> /
+                          (T(2) * constants::g<T>.v())};
+
+  // The temperature gradient is zero where the temperature is the
+  // tropopause temperature.
+  // The ratio of the ISA and actual temperatures is the rate of change of
+  // pressure altitude with true height.
+  const T temperature{
+      calculate_isa_temperature(altitude, delta_temperature).v()};
+  const T mach_2{mach * mach};
+  const T mach_term{
+      (temperature > constants::TROPOPAUSE_TEMPERATURE<T>.v())
+          ? MACH_FACTOR * mach_2 * calculate_isa_temperature(altitude).v() /
+                temperature
+          : T()};
+
+  T cas_term{};
+  if (hold == SpeedHold::CAS) {
+    const T ratio{T(1) + K_MINUS_1_OVER_2 * mach_2};
+    cas_term = std::pow(ratio, CAS_POWER) *
+               (std::pow(ratio, INV_U<T>) - T(1));
+  }
+
+  return T(1) / (T(1) + mach_term + cas_term);
+}
+
+/// Calculate the specific total energy of an aircraft: the sum of its
+/// potential and kinetic energy per unit mass.
+/// @param altitude the altitude in metres.
+/// @param tas the True Air Speed in metres per second.
+/// @return the specific total energy in Joules per kilogram.
+template <typename T>
+  requires std::floating_point<T>
+[[nodiscard("Pure Function")]]
+constexpr auto
+calculate_specific_total_energy(const units::si::Metres<T> altitude,
+                                const units::si::MetresPerSecond<T> tas) -> T {
+  return constants::g<T>.v() * altitude.v() + T(0.5) * tas.v() * tas.v();
+}
+
+/// The columns of the energy of a flight segment.
+template <typename T>
+  requires std::floating_point<T>
+struct EnergyColumns {
+  /// The energy share factors.
+  std::span<T> energy_share_factors;
+  /// The specific total energies in Joules per kilogram.
+  std::span<T> energies;
+  /// The rates of change of the specific total energies in Watts per
+  /// kilogram.
+  std::span<T> energy_rates;
+};
+
+/// Calculate the energy share factors, specific total energies and their
+/// rates of an aircraft holding a constant CAS or Mach number.
+/// The energy rates are the vertical speeds multiplied by g and divided by
+/// the energy share factors.
+/// @pre the spans are the same size.
+/// @param hold the speed held.
+/// @param altitudes the pressure altitudes in metres.
+/// @param tas the True Air Speeds in metres per second.
+/// @param vertical_speeds the true vertical speeds in metres per second.
+/// @param delta_temperature the difference from ISA temperature at Sea
+/// level in Kelvin.
+/// @param energy the columns of the energy.
+template <typename T>
+  requires std::floating_point<T>
+constexpr void calculate_total_energy(const SpeedHold hold,
+                                      std::span<const T> altitudes,
+                                      std::span<const T> tas,
+                                      std::span<const T> vertical_speeds,
+                                      const units::si::Kelvin<T> delta_temperature,
+                                      const EnergyColumns<T> &energy) {
+  const auto size{altitudes.size()};
+  Expects(tas.size() == size);
+  Expects(vertical_speeds.size() == size);
+  Expects(energy.energy_share_factors.size() == size);
+  Expects(energy.energies.size() == size);
+  Expects(energy.energy_rates.size() == size);
+
+  for (std::size_t i{}; i < size; ++i) {
+    const auto altitude{units::si::Metres<T>(altitudes[i])};
+    const auto speed{units::si::MetresPerSecond<T>(tas[i])};
+    const T mach{true_air_speed_mach(
+        speed, calculate_isa_temperature(altitude, delta_temperature))};
+    const T factor{
+        calculate_energy_share_factor(hold, mach, altitude, delta_temperature)};
+    energy.energy_share_factors[i] = factor;
+    energy.energies[i] = calculate_specific_total_energy(altitude, speed);
+    energy.energy_rates[i] =
+        constants::g<T>.v() * vertical_speeds[i] / factor;
+  }
+}
+
+} // namespace isa
+} // namespace via
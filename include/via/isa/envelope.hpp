@@ -0,0 +1,188 @@
+#pragma once
+
+//////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2024 Ken Barker
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//////////////////////////////////////////////////////////////////////////////
+/// @file
+/// @brief Maximum operating speed envelopes over grids of flight levels and
+/// temperature deviations.
+///
+/// The maximum operating speed of an aircraft is limited by its maximum
+/// operating Calibrated Air Speed (Vmo) below the crossover altitude and by
+/// its maximum operating Mach number (Mmo) above it.
+///
+/// The Mach number corresponding to a CAS depends only upon pressure, so the
+/// crossover altitude does not depend upon the temperature deviation and the
+/// limiting Mach number at a flight level is the lesser of Mmo and the Mach
+/// number of Vmo. It is calculated once per flight level and the True Air
+/// Speed at each temperature deviation is just the limiting Mach number
+/// multiplied by the speed of sound, without a branch at the crossover.
+//////////////////////////////////////////////////////////////////////////////
+#include "../isa.hpp"
+#include <algorithm>
+#include <span>
+#include <vector>
+
+namespace via {
+namespace isa {
+
+/// Calculate the limiting Mach numbers of a speed envelope at the given
+/// altitudes.
+/// @pre mmo > 0.0
+/// @param vmo the maximum operating Calibrated Air Speed in metres per
+/// second.
+/// @param mmo the maximum operating Mach number.
+/// @param altitudes the pressure altitudes in metres.
+/// @param machs the limiting Mach numbers.
+template <typename T>
+  requires std::floating_point<T>
+constexpr void calculate_envelope_machs(const units::si::MetresPerSecond<T> vmo,
+                                        const T mmo,
+                                        std::span<const T> altitudes,
+                                        std::span<T> machs) {
+  Expects(mmo > T());
+  Expects(altitudes.size() == machs.size());
+
+  for (std::size_t i{}; i < altitudes.size(); ++i) {
+    const auto altitude{units::si::Metres<T>(altitudes[i])};
+    const auto temperature{calculate_isa_temperature(altitude)};
+    const T vmo_mach{calculate_true_air_speed(
+                         vmo, calculate_isa_pressure(altitude), temperature)
+                         .v() /
+                     speed_of_sound(temperature).v()};
+    machs[i] = std::min(vmo_mach, mmo);
+  }
+}
+
+/// Calculate the maximum operating True Air Speeds over a grid of altitudes
+/// and temperature deviations.
+/// @pre the Mach numbers are positive
+/// @param machs the limiting Mach numbers at the altitudes, see
+/// `calculate_envelope_machs`.
+/// @param altitudes the pressure altitudes in metres.
+/// @param delta_temperatures the differences from ISA temperature at Sea
+/// level in Kelvin.
+/// @param tas the True Air Speeds in metres per second, by temperature
+/// deviation then altitude, i.e. tas[d * altitudes.size() + a].
+template <typename T>
+  requires std::floating_point<T>
+constexpr void calculate_envelope_true_air_speeds(
+    std::span<const T> machs, std::span<const T> altitudes,
+    std::span<const T> delta_temperatures, std::span<T> tas) {
+  const auto levels{altitudes.size()};
+  Expects(machs.size() == levels);
+  Expects(tas.size() == levels * delta_temperatures.size());
+
+  for (std::size_t d{}; d < delta_temperatures.size(); ++d) {
+    const auto delta_temperature{units::si::Kelvin<T>(delta_temperatures[d])};
+    const auto row{tas.subspan(d * levels, levels)};
+    for (std::size_t i{}; i < levels; ++i)
+      row[i] = mach_true_air_speed(
+                   machs[i], calculate_isa_temperature(
+                                 units::si::Metres<T>(altitudes[i]),
+                                 delta_temperature))
+                   .v();
+  }
+}
+
+/// A maximum operating speed envelope over a grid of altitudes and
+/// temperature deviations.
+template <typename T>
+  requires std::floating_point<T>
+struct SpeedEnvelope {
+  /// The number of altitudes.
+  std::size_t levels{};
+  /// The number of temperature deviations.
+  std::size_t deviations{};
+  /// The crossover altitude of Vmo and Mmo in metres.
+  units::si::Metres<T> crossover_altitude;
+  /// The limiting Mach number at each altitude.
+  std::vector<T> machs;
+  /// The maximum operating True Air Speeds in metres per second, by
+  /// temperature deviation then altitude.
+  std::vector<T> true_air_speeds;
+  /// The maximum operating ground speeds in metres per second, by
+  /// temperature deviation then altitude.
+  std::vector<T> ground_speeds;
+
+  /// @return the True Air Speed at a temperature deviation and altitude.
+  [[nodiscard]] constexpr auto true_air_speed(const std::size_t deviation,
+                                              const std::size_t level) const
+      -> units::si::MetresPerSecond<T> {
+    return units::si::MetresPerSecond<T>(
+        true_air_speeds[deviation * levels + level]);
+  }
+
+  /// @return the ground speed at a temperature deviation and altitude.
+  [[nodiscard]] constexpr auto ground_speed(const std::size_t deviation,
+                                            const std::size_t level) const
+      -> units::si::MetresPerSecond<T> {
+    return units::si::MetresPerSecond<T>(
+        ground_speeds[deviation * levels + level]);
+  }
+};
+
+/// Calculate a maximum operating speed envelope over a grid of altitudes and
+/// temperature deviations.
+/// @pre mmo > 0.0
+/// @param vmo the maximum operating Calibrated Air Speed in metres per
+/// second.
+/// @param mmo the maximum operating Mach number.
+/// @param altitudes the pressure altitudes in metres.
+/// @param delta_temperatures the differences from ISA temperature at Sea
+/// level in Kelvin.
+/// @param wind_speeds the along track wind speed components at the
+/// altitudes in metres per second, positive for tail winds, empty for none.
+/// @return the speed envelope.
+template <typename T>
+  requires std::floating_point<T>
+auto calculate_speed_envelope(const units::si::MetresPerSecond<T> vmo,
+                              const T mmo, std::span<const T> altitudes,
+                              std::span<const T> delta_temperatures,
+                              std::span<const T> wind_speeds = {})
+    -> SpeedEnvelope<T> {
+  Expects(wind_speeds.empty() || (wind_speeds.size() == altitudes.size()));
+
+  const auto levels{altitudes.size()};
+  const auto deviations{delta_temperatures.size()};
+  SpeedEnvelope<T> envelope{levels,
+                            deviations,
+                            calculate_crossover_altitude(vmo, mmo),
+                            std::vector<T>(levels),
+                            std::vector<T>(levels * deviations),
+                            {}};
+
+  calculate_envelope_machs<T>(vmo, mmo, altitudes, envelope.machs);
+  calculate_envelope_true_air_speeds<T>(envelope.machs, altitudes,
+                                        delta_temperatures,
+                                        envelope.true_air_speeds);
+
+  envelope.ground_speeds = envelope.true_air_speeds;
+  if (!wind_speeds.empty())
+    for (std::size_t d{}; d < deviations; ++d)
+      for (std::size_t i{}; i < levels; ++i)
+        envelope.ground_speeds[d * levels + i] += wind_speeds[i];
+
+  return envelope;
+}
+
+} // namespace isa
+} // namespace via
@@ -0,0 +1,204 @@
+#pragma once
+
+//////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2024 Ken Barker
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//////////////////////////////////////////////////////////////////////////////
+/// @file
+/// @brief A streaming detector of air data events: crossing the crossover
+/// altitude or the tropopause and exceeding CAS or Mach limits.
+///
+/// The detector processes samples in blocks: the margins of each sample from
+/// the thresholds are calculated in simple loops over a block into fixed
+/// size arrays, together with a bit mask of the thresholds that each sample
+/// is above. Events are only rare changes in the masks of consecutive
+/// samples, where the time of the event is interpolated linearly between
+/// the samples from their margins.
+/// So samples are processed in a single pass, without intermediate columns
+/// or memory allocation.
+//////////////////////////////////////////////////////////////////////////////
+#include "../isa.hpp"
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <span>
+
+namespace via {
+namespace isa {
+
+/// The types of air data event.
+enum class EventType : std::uint8_t {
+  /// The aircraft crossed the crossover altitude of the filed CAS and Mach.
+  CROSSOVER,
+  /// The aircraft crossed the tropopause.
+  TROPOPAUSE,
+  /// The CAS crossed the maximum operating CAS.
+  OVERSPEED_CAS,
+  /// The Mach number crossed the maximum operating Mach number.
+  OVERSPEED_MACH
+};
+
+/// The number of event types.
+constexpr std::size_t EVENT_TYPES{4};
+
+/// An air data event.
+template <typename T>
+  requires std::floating_point<T>
+struct Event {
+  /// The interpolated time of the event.
+  T time;
+  /// The index of the first sample after the event.
+  std::size_t sample;
+  /// The type of the event.
+  EventType type;
+  /// True if the value rose above the threshold, false if it fell below it.
+  bool rising;
+};
+
+/// The thresholds of the air data events.
+template <typename T>
+  requires std::floating_point<T>
+struct EventThresholds {
+  /// The filed Calibrated Air Speed in metres per second.
+  units::si::MetresPerSecond<T> filed_cas;
+  /// The filed Mach number.
+  T filed_mach;
+  /// The maximum operating Calibrated Air Speed in metres per second.
+  units::si::MetresPerSecond<T> vmo;
+  /// The maximum operating Mach number.
+  T mmo;
+};
+
+/// A streaming detector of the air data events of an aircraft.
+template <typename T>
+  requires std::floating_point<T>
+class EventDetector {
+public:
+  /// The number of samples processed together.
+  static constexpr std::size_t BLOCK_SIZE{256};
+
+private:
+  std::array<T, EVENT_TYPES> thresholds_;
+
+  std::size_t samples_{};
+  T previous_time_{};
+  std::array<T, EVENT_TYPES> previous_margins_{};
+  std::uint8_t previous_mask_{};
+
+  /// Calculate the margins of a block of samples from the thresholds.
+  void calculate_margins(
+      std::span<const T> altitudes, std::span<const T> cas,
+      std::array<std::array<T, BLOCK_SIZE>, EVENT_TYPES> &margins,
+      std::array<std::uint8_t, BLOCK_SIZE> &masks) const {
+    const auto n{altitudes.size()};
+    for (std::size_t i{}; i < n; ++i) {
+      margins[0][i] = altitudes[i] - thresholds_[0];
+      margins[1][i] = altitudes[i] - thresholds_[1];
+      margins[2][i] = cas[i] - thresholds_[2];
+    }
+    for (std::size_t i{}; i < n; ++i)
+      margins[3][i] =
+          calibrated_air_speed_mach(
+              units::si::MetresPerSecond<T>(cas[i]),
+              calculate_isa_pressure(units::si::Metres<T>(altitudes[i]))) -
+          thresholds_[3];
+    for (std::size_t i{}; i < n; ++i)
+      masks[i] = static_cast<std::uint8_t>(
+          (margins[0][i] >= T()) | ((margins[1][i] >= T()) << 1) |
+          ((margins[2][i] >= T()) << 2) | ((margins[3][i] >= T()) << 3));
+  }
+
+public:
+  /// Constructor.
+  /// @pre thresholds.filed_mach > 0
+  /// @param thresholds the thresholds of the events.
+  explicit EventDetector(const EventThresholds<T> &thresholds)
+      : thresholds_{calculate_crossover_altitude(thresholds.filed_cas,
+                                                 thresholds.filed_mach)
+                        .v(),
+                    constants::TROPOPAUSE_ALTITUDE<T>.v(),
+                    thresholds.vmo.v(), thresholds.mmo} {}
+
+  /// @return the crossover altitude of the filed CAS and Mach in metres.
+  [[nodiscard]] auto crossover_altitude() const noexcept
+      -> units::si::Metres<T> {
+    return units::si::Metres<T>(thresholds_[0]);
+  }
+
+  /// @return the number of samples processed.
+  [[nodiscard]] auto samples() const noexcept -> std::size_t {
+    return samples_;
+  }
+
+  /// Reset the detector for a new aircraft.
+  void reset() noexcept { samples_ = 0; }
+
+  /// Process the next samples of the aircraft.
+  /// No events are reported for the first sample of the aircraft.
+  /// @pre the columns are the same size and times are increasing.
+  /// @param times the times of the samples, e.g. in seconds.
+  /// @param altitudes the pressure altitudes in metres.
+  /// @param cas the Calibrated Air Speeds in metres per second.
+  /// @param output a function called with each Event.
+  template <typename Output>
+  void process(std::span<const T> times, std::span<const T> altitudes,
+               std::span<const T> cas, Output &&output) {
+    Expects(times.size() == altitudes.size());
+    Expects(times.size() == cas.size());
+
+    std::array<std::array<T, BLOCK_SIZE>, EVENT_TYPES> margins;
+    std::array<std::uint8_t, BLOCK_SIZE> masks;
+    for (std::size_t begin{}; begin < times.size(); begin += BLOCK_SIZE) {
+      const auto n{std::min(BLOCK_SIZE, times.size() - begin)};
+      calculate_margins(altitudes.subspan(begin, n), cas.subspan(begin, n),
+                        margins, masks);
+
+      for (std::size_t i{}; i < n; ++i) {
+        const auto previous_mask{i ? masks[i - 1] : previous_mask_};
+        const auto changes{static_cast<unsigned>(masks[i] ^ previous_mask)};
+        if (!changes || (samples_ + i == 0))
+          continue;
+
+        const T time{times[begin + i]};
+        const T previous_time{i ? times[begin + i - 1] : previous_time_};
+        for (std::size_t e{}; e < EVENT_TYPES; ++e) {
+          if (changes & (1u << e)) {
+            const T margin{margins[e][i]};
+            const T previous_margin{i ? margins[e][i - 1]
+                                      : previous_margins_[e]};
+            const T fraction{previous_margin / (previous_margin - margin)};
+            output(Event<T>{previous_time + fraction * (time - previous_time),
+                            samples_ + i, static_cast<EventType>(e),
+                            margin >= T()});
+          }
+        }
+      }
+
+      previous_mask_ = masks[n - 1];
+      for (std::size_t e{}; e < EVENT_TYPES; ++e)
+        previous_margins_[e] = margins[e][n - 1];
+      previous_time_ = times[begin + n - 1];
+      samples_ += n;
+    }
+  }
+};
+
+} // namespace isa
+} // namespace via
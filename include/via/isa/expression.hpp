@@ -0,0 +1,480 @@
+#pragma once
+
+//////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2024 Ken Barker
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//////////////////////////////////////////////////////////////////////////////
+/// @file
+/// @brief Lazily evaluated expressions of the via::isa functions over
+/// columns of values.
+///
+/// Composing the batch functions, e.g.:
+///
+///     batch::calculate_isa_pressure<double>(altitudes, pressures);
+///     batch::calculate_isa_temperature<double>(altitudes, 0.0, temperatures);
+///     batch::calculate_density<double>(pressures, temperatures, densities);
+///
+/// makes a pass over memory and an intermediate column for every function.
+/// The equivalent expression:
+///
+///     const auto h{expression::column(altitudes)};
+///     expression::evaluate(densities, expression::calculate_density(
+///         expression::calculate_isa_pressure(h),
+///         expression::calculate_isa_temperature(h)));
+///
+/// is evaluated in a single pass over memory: in blocks of `BLOCK_SIZE`
+/// values, where each function of the expression is evaluated over the block
+/// in a simple loop and its results stay in cache.
+///
+/// Sub-expressions which are named (i.e. lvalues) are referenced by the
+/// expressions that use them, rather than copied, and are evaluated once per
+/// block however many times they are used, e.g. `t` below:
+///
+///     const auto t{expression::calculate_isa_temperature(h)};
+///     expression::evaluate(
+///         expression::output(densities, expression::calculate_density(p, t)),
+///         expression::output(speeds, expression::speed_of_sound(t)));
+///
+/// So named sub-expressions must outlive the expressions that use them.
+/// Expressions cache their latest block, so an expression must not be
+/// evaluated by more than one thread at a time.
+//////////////////////////////////////////////////////////////////////////////
+#include "../isa.hpp"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <ranges>
+#include <span>
+#include <tuple>
+#include <type_traits>
+
+namespace via {
+namespace isa {
+namespace expression {
+
+/// The number of values evaluated together.
+constexpr std::size_t BLOCK_SIZE{256};
+
+/// The block of values being evaluated.
+struct Block {
+  /// A unique identifier of the evaluation.
+  std::uint64_t evaluation;
+  /// The index of the first value of the block.
+  std::size_t begin;
+  /// The number of values in the block.
+  std::size_t count;
+};
+
+/// An expression type.
+template <typename E>
+concept Expression = std::remove_cvref_t<E>::IS_EXPRESSION;
+
+/// The value type of an expression.
+template <typename E>
+using value_t = typename std::remove_cvref_t<E>::value_type;
+
+/// How an expression stores a sub-expression: named sub-expressions are
+/// referenced, temporary sub-expressions are moved into the expression.
+template <typename E>
+using stored_t =
+    std::conditional_t<std::is_lvalue_reference_v<E>,
+                       const std::remove_reference_t<E> &,
+                       std::remove_cvref_t<E>>;
+
+/// A column of values: the leaves of an expression.
+template <typename T>
+  requires std::floating_point<T>
+class Column {
+  std::span<const T> values_;
+
+public:
+  static constexpr bool IS_EXPRESSION{true};
+  using value_type = T;
+
+  explicit constexpr Column(std::span<const T> values) noexcept
+      : values_{values} {}
+
+  /// @return the number of values.
+  [[nodiscard]] constexpr auto size() const noexcept -> std::size_t {
+    return values_.size();
+  }
+
+  /// @return the values of the block.
+  [[nodiscard]] constexpr auto block(const Block &b) const noexcept
+      -> const T * {
+    return values_.data() + b.begin;
+  }
+};
+
+/// A value which is the same for every element, e.g. a temperature deviation.
+template <typename T>
+  requires std::floating_point<T>
+class Constant {
+  T value_;
+
+public:
+  static constexpr bool IS_EXPRESSION{true};
+  using value_type = T;
+
+  /// An accessor which returns the value for every index.
+  struct Broadcast {
+    T value;
+    constexpr auto operator[](std::size_t) const noexcept -> T {
+      return value;
+    }
+  };
+
+  explicit constexpr Constant(const T value) noexcept : value_{value} {}
+
+  /// @return zero: a constant matches an expression of any size.
+  [[nodiscard]] constexpr auto size() const noexcept -> std::size_t {
+    return 0;
+  }
+
+  /// @return the value for every element of the block.
+  [[nodiscard]] constexpr auto block(const Block &) const noexcept
+      -> Broadcast {
+    return {value_};
+  }
+};
+
+/// A function of sub-expressions.
+/// @tparam F the function object type, called with the sub-expression values.
+/// @tparam Args the stored sub-expression types, see `stored_t`.
+template <typename F, typename... Args> class Function {
+  std::tuple<Args...> args_;
+  std::size_t size_{};
+
+  mutable std::array<value_t<std::tuple_element_t<0, std::tuple<Args...>>>,
+                     BLOCK_SIZE>
+      cache_;
+  mutable std::uint64_t cached_evaluation_{};
+  mutable std::size_t cached_begin_{};
+
+public:
+  static constexpr bool IS_EXPRESSION{true};
+  using value_type = value_t<std::tuple_element_t<0, std::tuple<Args...>>>;
+
+  template <typename... A>
+  explicit constexpr Function(A &&...args) : args_{std::forward<A>(args)...} {
+    std::apply(
+        [this](const auto &...a) {
+          size_ = std::max({std::size_t{}, a.size()...});
+          // All the sub-expressions that are not constants are the same size.
+          Expects(((a.size() == 0 || a.size() == size_) && ...));
+        },
+        args_);
+  }
+
+  /// @return the number of values.
+  [[nodiscard]] constexpr auto size() const noexcept -> std::size_t {
+    return size_;
+  }
+
+  /// Evaluate the function over a block, unless it has already been
+  /// evaluated as a sub-expression of another expression.
+  /// @return the values of the block.
+  [[nodiscard]] auto block(const Block &b) const -> const value_type * {
+    if ((cached_evaluation_ != b.evaluation) || (cached_begin_ != b.begin)) {
+      std::apply(
+          [&](const auto &...args) {
+            const auto compute{[&](const auto... values) {
+              const F function{};
+              for (std::size_t i{}; i < b.count; ++i)
+                cache_[i] = function(values[i]...);
+            }};
+            compute(args.block(b)...);
+          },
+          args_);
+      cached_evaluation_ = b.evaluation;
+      cached_begin_ = b.begin;
+    }
+    return cache_.data();
+  }
+};
+
+/// Create a function expression of sub-expressions.
+template <typename F, typename... Args>
+  requires(Expression<Args> && ...)
+[[nodiscard]] constexpr auto make_function(Args &&...args) {
+  return Function<F, stored_t<Args &&>...>(std::forward<Args>(args)...);
+}
+
+/// Create a column expression.
+/// @param values the values of the column, they must outlive the expression.
+template <typename T>
+  requires std::floating_point<T>
+[[nodiscard]] constexpr auto column(std::span<const T> values) noexcept {
+  return Column<T>(values);
+}
+
+/// Create a column expression from a contiguous range, e.g. a std::vector.
+template <typename R>
+  requires std::ranges::contiguous_range<R> &&
+           std::floating_point<std::ranges::range_value_t<R>>
+[[nodiscard]] constexpr auto column(const R &values) noexcept {
+  return Column<std::ranges::range_value_t<R>>(
+      std::span<const std::ranges::range_value_t<R>>(values));
+}
+
+/// Create a constant expression.
+template <typename T>
+  requires std::floating_point<T>
+[[nodiscard]] constexpr auto constant(const T value) noexcept {
+  return Constant<T>(value);
+}
+
+namespace functions {
+/// Function objects calling the via::isa functions with SI values.
+struct IsaPressure {
+  template <typename T> constexpr auto operator()(const T altitude) const {
+    return isa::calculate_isa_pressure(units::si::Metres<T>(altitude)).v();
+  }
+};
+
+struct IsaAltitude {
+  template <typename T> constexpr auto operator()(const T pressure) const {
+    return isa::calculate_isa_altitude(units::si::Pascals<T>(pressure)).v();
+  }
+};
+
+struct IsaTemperature {
+  template <typename T>
+  constexpr auto operator()(const T altitude, const T delta) const {
+    return isa::calculate_isa_temperature(units::si::Metres<T>(altitude),
+                                          units::si::Kelvin<T>(delta))
+        .v();
+  }
+};
+
+struct Density {
+  template <typename T>
+  constexpr auto operator()(const T pressure, const T temperature) const {
+    return isa::calculate_density(units::si::Pascals<T>(pressure),
+                                  units::si::Kelvin<T>(temperature))
+        .v();
+  }
+};
+
+struct TrueAirSpeed {
+  template <typename T>
+  constexpr auto operator()(const T cas, const T pressure,
+                            const T temperature) const {
+    return isa::calculate_true_air_speed(units::si::MetresPerSecond<T>(cas),
+                                         units::si::Pascals<T>(pressure),
+                                         units::si::Kelvin<T>(temperature))
+        .v();
+  }
+};
+
+struct CalibratedAirSpeed {
+  template <typename T>
+  constexpr auto operator()(const T tas, const T pressure,
+                            const T temperature) const {
+    return isa::calculate_calibrated_air_speed(
+               units::si::MetresPerSecond<T>(tas),
+               units::si::Pascals<T>(pressure),
+               units::si::Kelvin<T>(temperature))
+        .v();
+  }
+};
+
+struct SpeedOfSound {
+  template <typename T> constexpr auto operator()(const T temperature) const {
+    return isa::speed_of_sound(units::si::Kelvin<T>(temperature)).v();
+  }
+};
+
+struct MachTrueAirSpeed {
+  template <typename T>
+  constexpr auto operator()(const T mach, const T temperature) const {
+    return isa::mach_true_air_speed(mach, units::si::Kelvin<T>(temperature))
+        .v();
+  }
+};
+
+struct CrossoverAltitude {
+  template <typename T>
+  constexpr auto operator()(const T cas, const T mach) const {
+    return isa::calculate_crossover_altitude(
+               units::si::MetresPerSecond<T>(cas), mach)
+        .v();
+  }
+};
+} // namespace functions
+
+/// The ISA pressures in Pascals of an expression of altitudes in metres.
+template <Expression E>
+[[nodiscard]] constexpr auto calculate_isa_pressure(E &&altitude) {
+  return make_function<functions::IsaPressure>(std::forward<E>(altitude));
+}
+
+/// The ISA altitudes in metres of an expression of pressures in Pascals.
+template <Expression E>
+[[nodiscard]] constexpr auto calculate_isa_altitude(E &&pressure) {
+  return make_function<functions::IsaAltitude>(std::forward<E>(pressure));
+}
+
+/// The ISA temperatures in Kelvin of expressions of altitudes in metres and
+/// differences from ISA Sea level temperature in Kelvin.
+template <Expression E, Expression D>
+[[nodiscard]] constexpr auto calculate_isa_temperature(E &&altitude,
+                                                       D &&delta_temperature) {
+  return make_function<functions::IsaTemperature>(
+      std::forward<E>(altitude), std::forward<D>(delta_temperature));
+}
+
+/// The ISA temperatures in Kelvin of an expression of altitudes in metres.
+template <Expression E>
+[[nodiscard]] constexpr auto calculate_isa_temperature(E &&altitude) {
+  return calculate_isa_temperature(std::forward<E>(altitude),
+                                   constant(value_t<E>()));
+}
+
+/// The air densities of expressions of pressures and temperatures.
+template <Expression P, Expression K>
+[[nodiscard]] constexpr auto calculate_density(P &&pressure, K &&temperature) {
+  return make_function<functions::Density>(std::forward<P>(pressure),
+                                           std::forward<K>(temperature));
+}
+
+/// The True Air Speeds of expressions of Calibrated Air Speeds, pressures
+/// and temperatures.
+template <Expression C, Expression P, Expression K>
+[[nodiscard]] constexpr auto calculate_true_air_speed(C &&cas, P &&pressure,
+                                                      K &&temperature) {
+  return make_function<functions::TrueAirSpeed>(std::forward<C>(cas),
+                                                std::forward<P>(pressure),
+                                                std::forward<K>(temperature));
+}
+
+/// The Calibrated Air Speeds of expressions of True Air Speeds, pressures
+/// and temperatures.
+template <Expression S, Expression P, Expression K>
+[[nodiscard]] constexpr auto
+calculate_calibrated_air_speed(S &&tas, P &&pressure, K &&temperature) {
+  return make_function<functions::CalibratedAirSpeed>(
+      std::forward<S>(tas), std::forward<P>(pressure),
+      std::forward<K>(temperature));
+}
+
+/// The speeds of sound of an expression of temperatures.
+template <Expression K>
+[[nodiscard]] constexpr auto speed_of_sound(K &&temperature) {
+  return make_function<functions::SpeedOfSound>(std::forward<K>(temperature));
+}
+
+/// The True Air Speeds of expressions of Mach numbers and temperatures.
+template <Expression M, Expression K>
+[[nodiscard]] constexpr auto mach_true_air_speed(M &&mach, K &&temperature) {
+  return make_function<functions::MachTrueAirSpeed>(
+      std::forward<M>(mach), std::forward<K>(temperature));
+}
+
+/// The crossover altitudes of expressions of Calibrated Air Speeds and Mach
+/// numbers.
+template <Expression C, Expression M>
+[[nodiscard]] constexpr auto calculate_crossover_altitude(C &&cas, M &&mach) {
+  return make_function<functions::CrossoverAltitude>(std::forward<C>(cas),
+                                                     std::forward<M>(mach));
+}
+
+/// Arithmetic operators of expressions and values.
+#define VIA_ISA_EXPRESSION_OPERATOR(OP, FUNCTION)                              \
+  template <Expression A, Expression B>                                        \
+  [[nodiscard]] constexpr auto operator OP(A &&a, B &&b) {                     \
+    return make_function<FUNCTION>(std::forward<A>(a), std::forward<B>(b));    \
+  }                                                                            \
+  template <Expression A>                                                      \
+  [[nodiscard]] constexpr auto operator OP(A &&a, const value_t<A> b) {        \
+    return make_function<FUNCTION>(std::forward<A>(a), constant(b));           \
+  }                                                                            \
+  template <Expression B>                                                      \
+  [[nodiscard]] constexpr auto operator OP(const value_t<B> a, B &&b) {        \
+    return make_function<FUNCTION>(constant(a), std::forward<B>(b));           \
+  }
+
+VIA_ISA_EXPRESSION_OPERATOR(+, std::plus<>)
+VIA_ISA_EXPRESSION_OPERATOR(-, std::minus<>)
+VIA_ISA_EXPRESSION_OPERATOR(*, std::multiplies<>)
+VIA_ISA_EXPRESSION_OPERATOR(/, std::divides<>)
+
+#undef VIA_ISA_EXPRESSION_OPERATOR
+
+/// An expression and the column to write its values to.
+template <typename E>
+  requires Expression<E>
+struct Output {
+  std::span<value_t<E>> values;
+  const E &expression;
+};
+
+/// Pair an expression with the column to write its values to.
+/// @param values the column, the same size as the expression.
+/// @param expression the expression.
+template <Expression E>
+[[nodiscard]] constexpr auto output(std::span<value_t<E>> values,
+                                    const E &expression) noexcept {
+  return Output<std::remove_cvref_t<E>>{values, expression};
+}
+
+/// @return a new unique evaluation identifier.
+inline auto next_evaluation() noexcept -> std::uint64_t {
+  static std::atomic<std::uint64_t> evaluations{0};
+  return evaluations.fetch_add(1, std::memory_order_relaxed) + 1;
+}
+
+/// Evaluate expressions and write their values to their columns in a single
+/// pass.
+/// Sub-expressions shared by the expressions are evaluated once per block.
+/// @pre the columns and expressions are all the same size.
+/// @param outputs the expressions and their columns, see `output`.
+template <typename E, typename... Es>
+void evaluate(const Output<E> &first, const Output<Es> &...outputs) {
+  const auto size{first.values.size()};
+  Expects(first.expression.size() == size);
+  Expects(((outputs.values.size() == size) && ...));
+  Expects(((outputs.expression.size() == size) && ...));
+
+  const auto evaluation{next_evaluation()};
+  for (std::size_t begin{}; begin < size; begin += BLOCK_SIZE) {
+    const Block b{evaluation, begin, std::min(BLOCK_SIZE, size - begin)};
+    std::ranges::copy_n(first.expression.block(b), b.count,
+                        first.values.begin() + begin);
+    (std::ranges::copy_n(outputs.expression.block(b), b.count,
+                         outputs.values.begin() + begin),
+     ...);
+  }
+}
+
+/// Evaluate an expression and write its values to a column.
+/// @pre values is the same size as the expression.
+/// @param values the column for the values of the expression.
+/// @param expression the expression.
+template <Expression E>
+void evaluate(std::span<value_t<E>> values, const E &expression) {
+  evaluate(output(values, expression));
+}
+
+} // namespace expression
+} // namespace isa
+} // namespace via
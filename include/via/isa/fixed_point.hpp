@@ -0,0 +1,719 @@
+#pragma once
+
+//////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2024 Ken Barker
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//////////////////////////////////////////////////////////////////////////////
+/// @file
+/// @brief Fixed point (Q format) ISA and air speed functions, for bit exact
+/// models of embedded or FPGA air data computers.
+///
+/// Values are stored in signed integers of a configurable word length with
+/// a configurable number of fraction bits for each quantity, e.g. Q23.8
+/// Pascals in 32 bits. The functions only use integer additions,
+/// multiplications, shifts, divisions and square roots, so they give the
+/// same results on every platform from the same tables.
+///
+/// The transcendental functions are calculated from tables of quadratic
+/// polynomials over equal segments of their inputs: the segment is selected
+/// by the upper bits of the input and the polynomial is evaluated in Horner
+/// form on the lower bits, see `PolynomialTable`.
+/// By default, the tables are calculated from the floating point functions
+/// when a `FixedPointIsa` is constructed. Since they use `std::pow`, the
+/// last bits of a coefficient may depend upon the maths library, so the
+/// tables can be exported with `rom`, compared with `checksum` and loaded
+/// from fixed ROM contents.
+///
+/// The batch functions are plain loops over the scalar functions. Only the
+/// temperature loop is simple enough for a compiler to vectorise, the others
+/// look up a table segment for each value.
+///
+/// `error_report` compares fixed point values with floating point values.
+//////////////////////////////////////////////////////////////////////////////
+#include "../isa.hpp"
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cmath>
+#include <concepts>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace via {
+namespace isa {
+namespace fixed_point {
+
+/// The number of extra fraction bits of the polynomial coefficients.
+constexpr int GUARD_BITS{8};
+
+/// The number of bits of the position within a table segment.
+constexpr int POSITION_BITS{16};
+
+/// The number of fraction bits of pressure ratios and Mach numbers.
+constexpr int RATIO_BITS{24};
+
+/// The number of fraction bits of the reciprocal of R * T.
+constexpr int RECIPROCAL_BITS{40};
+
+/// The largest magnitude of a polynomial coefficient, so that Horner's
+/// method cannot overflow 64 bits.
+constexpr std::int64_t MAX_COEFFICIENT{std::int64_t(1) << 45};
+
+/// Shift a value right by n bits, rounding to nearest.
+/// @pre 0 <= n < 63
+[[nodiscard("Pure Function")]]
+constexpr auto round_shift(const std::int64_t value, const int n) noexcept
+    -> std::int64_t {
+  return n ? (value + (std::int64_t(1) << (n - 1))) >> n : value;
+}
+
+/// @return the largest integer whose square is not greater than value.
+/// The floating point square root is correctly rounded, so the corrected
+/// result is exact on every platform.
+[[nodiscard("Pure Function")]]
+inline auto isqrt(const std::uint64_t value) noexcept -> std::uint64_t {
+  constexpr std::uint64_t MAX_ROOT{0xffff'ffff};
+  auto root{std::min(
+      static_cast<std::uint64_t>(std::sqrt(static_cast<double>(value))),
+      MAX_ROOT)};
+  while (root * root > value)
+    --root;
+  while ((root < MAX_ROOT) && ((root + 1) * (root + 1) <= value))
+    ++root;
+  return root;
+}
+
+/// Saturate a 64 bit value to a word length.
+template <std::signed_integral Int>
+[[nodiscard("Pure Function")]]
+constexpr auto saturate(const std::int64_t value) noexcept -> Int {
+  return static_cast<Int>(std::clamp<std::int64_t>(
+      value, std::numeric_limits<Int>::min(), std::numeric_limits<Int>::max()));
+}
+
+/// Convert a floating point value to fixed point, rounding to nearest and
+/// saturating.
+/// @param value the floating point value.
+/// @param fraction the number of fraction bits.
+/// @return the fixed point value.
+template <std::signed_integral Int>
+[[nodiscard("Pure Function")]]
+auto to_fixed(const double value, const int fraction) noexcept -> Int {
+  const double scaled{std::round(std::ldexp(value, fraction))};
+  return static_cast<Int>(
+      std::clamp(scaled, static_cast<double>(std::numeric_limits<Int>::min()),
+                 static_cast<double>(std::numeric_limits<Int>::max())));
+}
+
+/// Convert a fixed point value to floating point.
+/// @param value the fixed point value.
+/// @param fraction the number of fraction bits.
+/// @return the floating point value.
+[[nodiscard("Pure Function")]]
+inline auto to_double(const std::int64_t value, const int fraction) noexcept
+    -> double {
+  return std::ldexp(static_cast<double>(value), -fraction);
+}
+
+/// Convert floating point values to fixed point.
+template <std::signed_integral Int>
+void to_fixed(std::span<const double> values, const int fraction,
+              std::span<Int> fixed) {
+  Expects(values.size() == fixed.size());
+  for (std::size_t i{}; i < values.size(); ++i)
+    fixed[i] = to_fixed<Int>(values[i], fraction);
+}
+
+/// Convert fixed point values to floating point.
+template <std::signed_integral Int>
+void to_double(std::span<const Int> fixed, const int fraction,
+               std::span<double> values) {
+  Expects(values.size() == fixed.size());
+  for (std::size_t i{}; i < values.size(); ++i)
+    values[i] = to_double(fixed[i], fraction);
+}
+
+/// A table of quadratic polynomials approximating a function over equal
+/// segments of its fixed point input.
+/// The number of segments is at most 2^segment_bits and the width of a
+/// segment is a power of two, so the segment of an input is given by a
+/// shift and the position within the segment by a mask.
+/// Each polynomial interpolates the function at the start, middle and end
+/// of its segment.
+class PolynomialTable {
+public:
+  /// The coefficients of the polynomial of a segment.
+  using Coefficients = std::array<std::int64_t, 3>;
+
+private:
+  std::int64_t x_min_;
+  std::int64_t x_max_;
+  int shift_{};
+  std::size_t segments_{};
+  std::vector<Coefficients> coefficients_;
+
+  /// Constructor, calculates the segments of the input range.
+  /// @pre x_min < x_max
+  PolynomialTable(const double x_min, const double x_max,
+                  const int in_fraction, const unsigned segment_bits)
+      : x_min_{std::llround(std::ldexp(x_min, in_fraction))},
+        x_max_{std::llround(std::ldexp(x_max, in_fraction))} {
+    Expects(x_min_ < x_max_);
+
+    const auto range{static_cast<std::uint64_t>(x_max_ - x_min_)};
+    while ((range >> shift_) >= (std::uint64_t(1) << segment_bits))
+      ++shift_;
+    segments_ = static_cast<std::size_t>(range >> shift_) + 1;
+  }
+
+public:
+  /// Constructor, calculates the coefficients from a function.
+  /// @pre x_min < x_max and the coefficients are less than 2^45.
+  /// @param function the function to approximate.
+  /// @param x_min, x_max the range of the input, inputs are clamped to it.
+  /// @param in_fraction the number of fraction bits of the input.
+  /// @param out_fraction the number of fraction bits of the output.
+  /// @param segment_bits the log2 of the maximum number of segments.
+  template <typename Function>
+  PolynomialTable(Function function, const double x_min, const double x_max,
+                  const int in_fraction, const int out_fraction,
+                  const unsigned segment_bits)
+      : PolynomialTable(x_min, x_max, in_fraction, segment_bits) {
+    coefficients_.reserve(segments_);
+
+    const double width{std::ldexp(1.0, shift_ - in_fraction)};
+    const double scale{std::ldexp(1.0, out_fraction + GUARD_BITS)};
+    for (std::size_t s{}; s < segments_; ++s) {
+      const double x0{std::ldexp(
+          static_cast<double>(x_min_ + (static_cast<std::int64_t>(s) << shift_)),
+          -in_fraction)};
+      const double y0{function(x0)};
+      const double y1{function(x0 + 0.5 * width)};
+      const double y2{function(x0 + width)};
+      const std::array<std::int64_t, 3> c{
+          std::llround(y0 * scale),
+          std::llround((-3.0 * y0 + 4.0 * y1 - y2) * scale),
+          std::llround((2.0 * y0 - 4.0 * y1 + 2.0 * y2) * scale)};
+      for (const auto coefficient : c)
+        Expects((-MAX_COEFFICIENT < coefficient) &&
+                (coefficient < MAX_COEFFICIENT));
+      coefficients_.push_back(c);
+    }
+  }
+
+  /// Constructor, loads the coefficients, e.g. from the contents of a ROM.
+  /// @pre x_min < x_max, there are coefficients for every segment and they
+  /// are less than 2^45.
+  /// @param x_min, x_max the range of the input, inputs are clamped to it.
+  /// @param in_fraction the number of fraction bits of the input.
+  /// @param segment_bits the log2 of the maximum number of segments.
+  /// @param coefficients the coefficients of the segments.
+  PolynomialTable(const double x_min, const double x_max,
+                  const int in_fraction, const unsigned segment_bits,
+                  std::vector<Coefficients> coefficients)
+      : PolynomialTable(x_min, x_max, in_fraction, segment_bits) {
+    Expects(coefficients.size() == segments_);
+    Expects(std::ranges::all_of(coefficients, [](const Coefficients &c) {
+      return std::ranges::all_of(c, [](const auto coefficient) {
+        return (-MAX_COEFFICIENT < coefficient) &&
+               (coefficient < MAX_COEFFICIENT);
+      });
+    }));
+    coefficients_ = std::move(coefficients);
+  }
+
+  /// @return the number of segments.
+  [[nodiscard]] auto segments() const noexcept -> std::size_t {
+    return coefficients_.size();
+  }
+
+  /// @return the coefficients of the segments.
+  [[nodiscard]] auto coefficients() const noexcept
+      -> const std::vector<Coefficients> & {
+    return coefficients_;
+  }
+
+  /// Evaluate the table.
+  /// @param x the fixed point input.
+  /// @return the fixed point output.
+  [[nodiscard]] auto operator()(const std::int64_t x) const noexcept
+      -> std::int64_t {
+    const auto offset{std::clamp(x, x_min_, x_max_) - x_min_};
+    const auto &c{coefficients_[static_cast<std::size_t>(offset >> shift_)]};
+    const auto position{offset & ((std::int64_t(1) << shift_) - 1)};
+    const auto t{(shift_ > POSITION_BITS)
+                     ? position >> (shift_ - POSITION_BITS)
+                     : position << (POSITION_BITS - shift_)};
+    const auto y{c[0] + (((c[1] + ((c[2] * t) >> POSITION_BITS)) * t) >>
+                         POSITION_BITS)};
+    return round_shift(y, GUARD_BITS);
+  }
+};
+
+/// The numbers of fraction bits of the fixed point quantities.
+struct Formats {
+  /// Pressure altitude in metres.
+  int altitude{4};
+  /// Pressure in Pascals.
+  int pressure{8};
+  /// Temperature in Kelvin.
+  int temperature{16};
+  /// Density in Kg per cubic metre.
+  int density{24};
+  /// Air speeds in metres per second.
+  int speed{16};
+  /// The log2 of the maximum number of segments of a table.
+  unsigned segment_bits{8};
+};
+
+/// The ranges of the tables, inputs outside of them are clamped.
+constexpr double MIN_ALTITUDE{-1000.0};
+constexpr double MAX_ALTITUDE{20000.0};
+constexpr double MIN_PRESSURE{5000.0};
+constexpr double MAX_PRESSURE{115000.0};
+constexpr double MIN_TEMPERATURE{150.0};
+constexpr double MAX_TEMPERATURE{350.0};
+constexpr double MAX_SPEED{400.0};
+constexpr double MAX_IMPACT_PRESSURE{200000.0};
+constexpr double MAX_IMPACT_PRESSURE_RATIO{8.0};
+/// The largest (K - 1) / 2 * Mach^2, i.e. Mach 2.2.
+constexpr double MAX_MACH_TERM{1.0};
+
+/// Fixed point ISA and air speed functions.
+/// @tparam Int the signed integer type of the values, i.e. the word length.
+/// @tparam F the numbers of fraction bits of the quantities.
+template <std::signed_integral Int = std::int32_t, Formats F = Formats{}>
+class FixedPointIsa {
+  static constexpr int WORD_BITS{std::numeric_limits<Int>::digits};
+  static_assert(F.altitude <= 16 && F.pressure <= 16 && F.temperature <= 24 &&
+                    F.speed <= 20 && F.density <= F.pressure + RECIPROCAL_BITS,
+                "The fraction bits would overflow the 64 bit calculations");
+  static_assert(std::bit_width(static_cast<std::uint64_t>(MAX_ALTITUDE)) +
+                        F.altitude <=
+                    WORD_BITS,
+                "The altitude format does not fit the word length");
+  static_assert(std::bit_width(static_cast<std::uint64_t>(MAX_PRESSURE)) +
+                        F.pressure <=
+                    WORD_BITS,
+                "The pressure format does not fit the word length");
+  static_assert(std::bit_width(static_cast<std::uint64_t>(MAX_TEMPERATURE)) +
+                        F.temperature <=
+                    WORD_BITS,
+                "The temperature format does not fit the word length");
+  static_assert(std::bit_width(static_cast<std::uint64_t>(MAX_SPEED)) +
+                        F.speed <=
+                    WORD_BITS,
+                "The speed format does not fit the word length");
+  static_assert(1 + F.density <= WORD_BITS,
+                "The density format does not fit the word length");
+
+  /// The number of fraction bits of the squares of Calibrated Air Speeds.
+  static constexpr int SPEED_SQUARED_BITS{16};
+  /// The number of fraction bits of the temperature gradient.
+  static constexpr int GRADIENT_BITS{32};
+
+  /// The input range of a table.
+  struct Range {
+    double x_min;
+    double x_max;
+    int fraction;
+  };
+
+  /// The input ranges of the tables, in the order of the Rom.
+  static constexpr std::array<Range, 8> RANGES{
+      {{MIN_ALTITUDE, MAX_ALTITUDE, F.altitude},
+       {MIN_PRESSURE, MAX_PRESSURE, F.pressure},
+       {0.0, MAX_SPEED, F.speed},
+       {0.0, MAX_IMPACT_PRESSURE_RATIO, RATIO_BITS},
+       {MIN_TEMPERATURE, MAX_TEMPERATURE, F.temperature},
+       {0.0, MAX_MACH_TERM, RATIO_BITS},
+       {0.0, MAX_IMPACT_PRESSURE, F.pressure},
+       {MIN_TEMPERATURE, MAX_TEMPERATURE, F.temperature}}};
+
+  PolynomialTable pressure_;
+  PolynomialTable altitude_;
+  PolynomialTable impact_pressure_;
+  PolynomialTable mach_squared_;
+  PolynomialTable speed_of_sound_;
+  PolynomialTable impact_pressure_factor_;
+  PolynomialTable cas_squared_;
+  PolynomialTable reciprocal_rt_;
+  std::int64_t sea_level_temperature_{to_fixed<std::int64_t>(
+      constants::SEA_LEVEL_TEMPERATURE<double>.v(), F.temperature)};
+  std::int64_t tropopause_temperature_{to_fixed<std::int64_t>(
+      constants::TROPOPAUSE_TEMPERATURE<double>.v(), F.temperature)};
+  std::int64_t temperature_gradient_{to_fixed<std::int64_t>(
+      constants::TEMPERATURE_GRADIENT<double>, GRADIENT_BITS)};
+  std::int64_t mach_term_factor_{
+      to_fixed<std::int64_t>((constants::K<double> - 1.0) / 2.0, RATIO_BITS)};
+
+  /// Calculate a table from a function.
+  /// @param index the index of the table in the Rom.
+  /// @param function the function to approximate.
+  /// @param out_fraction the number of fraction bits of the output.
+  template <typename Function>
+  [[nodiscard]] static auto make_table(const std::size_t index,
+                                       Function function,
+                                       const int out_fraction)
+      -> PolynomialTable {
+    const auto &range{RANGES[index]};
+    return {function, range.x_min, range.x_max, range.fraction, out_fraction,
+            F.segment_bits};
+  }
+
+  /// Load a table from the contents of a ROM.
+  /// @param index the index of the table in the Rom.
+  /// @param coefficients the coefficients of the table.
+  [[nodiscard]] static auto
+  make_table(const std::size_t index,
+             std::vector<PolynomialTable::Coefficients> coefficients)
+      -> PolynomialTable {
+    const auto &range{RANGES[index]};
+    return {range.x_min, range.x_max, range.fraction, F.segment_bits,
+            std::move(coefficients)};
+  }
+
+  /// @return the tables, in the order of the Rom.
+  [[nodiscard]] auto tables() const noexcept
+      -> std::array<const PolynomialTable *, RANGES.size()> {
+    return {&pressure_,       &altitude_,
+            &impact_pressure_, &mach_squared_,
+            &speed_of_sound_, &impact_pressure_factor_,
+            &cas_squared_,    &reciprocal_rt_};
+  }
+
+public:
+  using value_type = Int;
+
+  /// The numbers of fraction bits of the quantities.
+  static constexpr Formats FORMATS{F};
+
+  /// The coefficients of the tables, i.e. the contents of a ROM.
+  using Rom =
+      std::array<std::vector<PolynomialTable::Coefficients>, RANGES.size()>;
+
+  /// Constructor, calculates the tables.
+  FixedPointIsa()
+      : pressure_{make_table(
+            0,
+            [](const double h) {
+              return isa::calculate_isa_pressure(units::si::Metres<double>(h))
+                  .v();
+            },
+            F.pressure)},
+        altitude_{make_table(
+            1,
+            [](const double p) {
+              return isa::calculate_isa_altitude(units::si::Pascals<double>(p))
+                  .v();
+            },
+            F.altitude)},
+        impact_pressure_{make_table(
+            2,
+            [](const double cas) {
+              return isa::calculate_impact_pressure(
+                         units::si::MetresPerSecond<double>(cas))
+                  .v();
+            },
+            F.pressure)},
+        // Mach^2 of an impact pressure ratio
+        mach_squared_{make_table(
+            3,
+            [](const double ratio) {
+              return 2.0 / (constants::K<double> - 1.0) *
+                     (std::pow(1.0 + ratio, U<double>) - 1.0);
+            },
+            RATIO_BITS)},
+        speed_of_sound_{make_table(
+            4,
+            [](const double t) {
+              return isa::speed_of_sound(units::si::Kelvin<double>(t)).v();
+            },
+            F.speed)},
+        // The impact pressure ratio of (K - 1) / 2 * Mach^2
+        impact_pressure_factor_{make_table(
+            5,
+            [](const double x) {
+              return std::pow(1.0 + x, INV_U<double>) - 1.0;
+            },
+            RATIO_BITS)},
+        // CAS^2 of an impact pressure
+        cas_squared_{make_table(
+            6,
+            [](const double qc) {
+              const double a0{constants::SEA_LEVEL_SPEED_OF_SOUND<double>.v()};
+              const double p0{constants::SEA_LEVEL_PRESSURE<double>.v()};
+              return 2.0 / (constants::K<double> - 1.0) * a0 * a0 *
+                     (std::pow(1.0 + qc / p0, U<double>) - 1.0);
+            },
+            SPEED_SQUARED_BITS)},
+        reciprocal_rt_{make_table(
+            7,
+            [](const double t) { return 1.0 / (constants::R<double> * t); },
+            RECIPROCAL_BITS)} {}
+
+  /// Constructor, loads the tables from the contents of a ROM, e.g. exported
+  /// by `rom` on a reference platform.
+  /// @pre the Rom has the coefficients of every segment of every table.
+  /// @param rom the contents of the ROM.
+  explicit FixedPointIsa(const Rom &rom)
+      : pressure_{make_table(0, rom[0])}, altitude_{make_table(1, rom[1])},
+        impact_pressure_{make_table(2, rom[2])},
+        mach_squared_{make_table(3, rom[3])},
+        speed_of_sound_{make_table(4, rom[4])},
+        impact_pressure_factor_{make_table(5, rom[5])},
+        cas_squared_{make_table(6, rom[6])},
+        reciprocal_rt_{make_table(7, rom[7])} {}
+
+  /// @return the coefficients of the tables, i.e. the contents of a ROM.
+  [[nodiscard]] auto rom() const -> Rom {
+    Rom contents;
+    const auto all_tables{tables()};
+    for (std::size_t i{}; i < all_tables.size(); ++i)
+      contents[i] = all_tables[i]->coefficients();
+    return contents;
+  }
+
+  /// A checksum of the tables, to compare them with known ROM contents.
+  /// @return the 64 bit FNV-1a hash of the coefficients.
+  [[nodiscard]] auto checksum() const noexcept -> std::uint64_t {
+    constexpr std::uint64_t FNV_PRIME{0x100'0000'01b3};
+    std::uint64_t hash{0xcbf2'9ce4'8422'2325};
+    for (const auto *table : tables())
+      for (const auto &c : table->coefficients())
+        for (const auto coefficient : c)
+          for (int byte{}; byte < 8; ++byte) {
+            hash ^= (static_cast<std::uint64_t>(coefficient) >> (8 * byte)) &
+                    0xff;
+            hash *= FNV_PRIME;
+          }
+    return hash;
+  }
+
+  /// Calculate the ISA pressure at a pressure altitude.
+  /// @param altitude the pressure altitude in metres.
+  /// @return the pressure in Pascals.
+  [[nodiscard]] auto calculate_isa_pressure(const Int altitude) const noexcept
+      -> Int {
+    return saturate<Int>(pressure_(altitude));
+  }
+
+  /// Calculate the ISA pressure altitude of a pressure.
+  /// @param pressure the pressure in Pascals.
+  /// @return the pressure altitude in metres.
+  [[nodiscard]] auto calculate_isa_altitude(const Int pressure) const noexcept
+      -> Int {
+    return saturate<Int>(altitude_(pressure));
+  }
+
+  /// Calculate the ISA temperature at a pressure altitude.
+  /// @param altitude the pressure altitude in metres.
+  /// @param delta_temperature the difference from ISA temperature at Sea
+  /// level in Kelvin.
+  /// @return the temperature in Kelvin.
+  [[nodiscard]] auto
+  calculate_isa_temperature(const Int altitude,
+                            const Int delta_temperature) const noexcept -> Int {
+    const auto temperature{
+        sea_level_temperature_ + delta_temperature +
+        round_shift(temperature_gradient_ * altitude,
+                    GRADIENT_BITS + F.altitude - F.temperature)};
+    return saturate<Int>(std::max(temperature, tropopause_temperature_));
+  }
+
+  /// Calculate the air density.
+  /// @param pressure the pressure in Pascals.
+  /// @param temperature the temperature in Kelvin.
+  /// @return the density in Kg per cubic metre.
+  [[nodiscard]] auto calculate_density(const Int pressure,
+                                       const Int temperature) const noexcept
+      -> Int {
+    return saturate<Int>(
+        round_shift(pressure * reciprocal_rt_(temperature),
+                    F.pressure + RECIPROCAL_BITS - F.density));
+  }
+
+  /// Calculate the Mach number from the Calibrated Air Speed.
+  /// @param cas the Calibrated Air Speed in metres per second.
+  /// @param pressure the pressure in Pascals.
+  /// @return the Mach number with RATIO_BITS fraction bits.
+  [[nodiscard]] auto calibrated_air_speed_mach(const Int cas,
+                                               const Int pressure) const noexcept
+      -> std::int64_t {
+    const auto impact_pressure{impact_pressure_(cas)};
+    const auto ratio{(impact_pressure << RATIO_BITS) /
+                     std::max<std::int64_t>(pressure, 1)};
+    const auto mach_squared{std::max<std::int64_t>(mach_squared_(ratio), 0)};
+    return static_cast<std::int64_t>(
+        isqrt(static_cast<std::uint64_t>(mach_squared) << RATIO_BITS));
+  }
+
+  /// Calculate the True Air Speed from the Calibrated Air Speed.
+  /// @param cas the Calibrated Air Speed in metres per second.
+  /// @param pressure the pressure in Pascals.
+  /// @param temperature the temperature in Kelvin.
+  /// @return the True Air Speed in metres per second.
+  [[nodiscard]] auto calculate_true_air_speed(const Int cas,
+                                              const Int pressure,
+                                              const Int temperature) const noexcept
+      -> Int {
+    const auto mach{calibrated_air_speed_mach(cas, pressure)};
+    return saturate<Int>(
+        round_shift(mach * speed_of_sound_(temperature), RATIO_BITS));
+  }
+
+  /// Calculate the Calibrated Air Speed from the True Air Speed.
+  /// @param tas the True Air Speed in metres per second.
+  /// @param pressure the pressure in Pascals.
+  /// @param temperature the temperature in Kelvin.
+  /// @return the Calibrated Air Speed in metres per second.
+  [[nodiscard]] auto
+  calculate_calibrated_air_speed(const Int tas, const Int pressure,
+                                 const Int temperature) const noexcept -> Int {
+    const auto mach{(std::max<std::int64_t>(tas, 0) << RATIO_BITS) /
+                    speed_of_sound_(temperature)};
+    const auto mach_term{round_shift(
+        round_shift(mach * mach, RATIO_BITS) * mach_term_factor_,
+        RATIO_BITS)};
+    const auto impact_pressure{
+        round_shift(std::int64_t(pressure) * impact_pressure_factor_(mach_term),
+                    RATIO_BITS)};
+    const auto cas_squared{
+        std::max<std::int64_t>(cas_squared_(impact_pressure), 0)};
+    constexpr int SHIFT{2 * F.speed - SPEED_SQUARED_BITS};
+    const auto scaled{SHIFT >= 0
+                          ? static_cast<std::uint64_t>(cas_squared) << SHIFT
+                          : static_cast<std::uint64_t>(cas_squared) >> -SHIFT};
+    return saturate<Int>(static_cast<std::int64_t>(isqrt(scaled)));
+  }
+
+  /// Calculate ISA pressures at pressure altitudes.
+  void calculate_isa_pressure(std::span<const Int> altitudes,
+                              std::span<Int> pressures) const {
+    Expects(altitudes.size() == pressures.size());
+    for (std::size_t i{}; i < altitudes.size(); ++i)
+      pressures[i] = calculate_isa_pressure(altitudes[i]);
+  }
+
+  /// Calculate ISA pressure altitudes of pressures.
+  void calculate_isa_altitude(std::span<const Int> pressures,
+                              std::span<Int> altitudes) const {
+    Expects(pressures.size() == altitudes.size());
+    for (std::size_t i{}; i < pressures.size(); ++i)
+      altitudes[i] = calculate_isa_altitude(pressures[i]);
+  }
+
+  /// Calculate ISA temperatures at pressure altitudes.
+  void calculate_isa_temperature(std::span<const Int> altitudes,
+                                 std::span<const Int> delta_temperatures,
+                                 std::span<Int> temperatures) const {
+    Expects(altitudes.size() == delta_temperatures.size());
+    Expects(altitudes.size() == temperatures.size());
+    for (std::size_t i{}; i < altitudes.size(); ++i)
+      temperatures[i] =
+          calculate_isa_temperature(altitudes[i], delta_temperatures[i]);
+  }
+
+  /// Calculate air densities.
+  void calculate_density(std::span<const Int> pressures,
+                         std::span<const Int> temperatures,
+                         std::span<Int> densities) const {
+    Expects(pressures.size() == temperatures.size());
+    Expects(pressures.size() == densities.size());
+    for (std::size_t i{}; i < pressures.size(); ++i)
+      densities[i] = calculate_density(pressures[i], temperatures[i]);
+  }
+
+  /// Calculate True Air Speeds from Calibrated Air Speeds.
+  void calculate_true_air_speed(std::span<const Int> cas,
+                                std::span<const Int> pressures,
+                                std::span<const Int> temperatures,
+                                std::span<Int> tas) const {
+    Expects(cas.size() == pressures.size());
+    Expects(cas.size() == temperatures.size());
+    Expects(cas.size() == tas.size());
+    for (std::size_t i{}; i < cas.size(); ++i)
+      tas[i] = calculate_true_air_speed(cas[i], pressures[i], temperatures[i]);
+  }
+
+  /// Calculate Calibrated Air Speeds from True Air Speeds.
+  void calculate_calibrated_air_speed(std::span<const Int> tas,
+                                      std::span<const Int> pressures,
+                                      std::span<const Int> temperatures,
+                                      std::span<Int> cas) const {
+    Expects(tas.size() == pressures.size());
+    Expects(tas.size() == temperatures.size());
+    Expects(tas.size() == cas.size());
+    for (std::size_t i{}; i < tas.size(); ++i)
+      cas[i] =
+          calculate_calibrated_air_speed(tas[i], pressures[i], temperatures[i]);
+  }
+};
+
+/// The differences between fixed point values and reference values.
+struct ErrorReport {
+  /// The number of values.
+  std::size_t count{};
+  /// The largest absolute difference.
+  double max_error{};
+  /// The index of the largest absolute difference.
+  std::size_t max_index{};
+  /// The root mean square difference.
+  double rms_error{};
+  /// The mean difference.
+  double mean_error{};
+};
+
+/// Compare fixed point values with reference values, e.g. calculated by the
+/// floating point functions.
+/// @param reference the reference values.
+/// @param values the fixed point values.
+/// @param fraction the number of fraction bits of the fixed point values.
+/// @return the differences between the values.
+template <std::signed_integral Int>
+auto error_report(std::span<const double> reference, std::span<const Int> values,
+                  const int fraction) -> ErrorReport {
+  Expects(reference.size() == values.size());
+
+  ErrorReport report{reference.size(), 0.0, 0, 0.0, 0.0};
+  double sum{};
+  double sum_squares{};
+  for (std::size_t i{}; i < values.size(); ++i) {
+    const double error{to_double(values[i], fraction) - reference[i]};
+    sum += error;
+    sum_squares += error * error;
+    if (std::abs(error) > report.max_error) {
+      report.max_error = std::abs(error);
+      report.max_index = i;
+    }
+  }
+  if (report.count) {
+    report.mean_error = sum / static_cast<double>(report.count);
+    report.rms_error = std::sqrt(sum_squares / static_cast<double>(report.count));
+  }
+  return report;
+}
+
+} // namespace fixed_point
+} // namespace isa
+} // namespace via
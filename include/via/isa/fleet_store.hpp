@@ -0,0 +1,234 @@
+#pragma once
+
+//////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2024 Ken Barker
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//////////////////////////////////////////////////////////////////////////////
+/// @file
+/// @brief An incremental store of the air data of a fleet of aircraft.
+///
+/// Between simulation ticks most aircraft do not change altitude or speed
+/// by more than sensor noise. The store keeps the inputs from which each
+/// aircraft's air data was last calculated and, on each tick, only
+/// recalculates the aircraft whose inputs have changed by more than a
+/// tolerance since then.
+/// The indices of the changed aircraft are compacted into a list, their
+/// inputs are gathered into contiguous columns, the batch functions are run
+/// over the columns and the results are scattered back into the store.
+//////////////////////////////////////////////////////////////////////////////
+#include "batch.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <limits>
+#include <span>
+#include <vector>
+
+namespace via {
+namespace isa {
+
+/// The tolerances of the inputs of a FleetStore.
+template <typename T>
+  requires std::floating_point<T>
+struct FleetTolerances {
+  /// The pressure altitude tolerance in metres.
+  T altitude{1};
+  /// The Calibrated Air Speed tolerance in metres per second.
+  T cas{0.1};
+  /// The temperature deviation tolerance in Kelvin.
+  T delta_temperature{0.1};
+};
+
+/// The report of a FleetStore update.
+struct FleetTickReport {
+  /// The number of aircraft.
+  std::size_t size{};
+  /// The number of aircraft recalculated.
+  std::size_t recalculated{};
+  /// The time taken by the update.
+  std::chrono::nanoseconds duration{};
+
+  /// @return the fraction of the aircraft recalculated.
+  [[nodiscard]] constexpr auto recalculated_fraction() const noexcept
+      -> double {
+    return size ? static_cast<double>(recalculated) / static_cast<double>(size)
+                : 0.0;
+  }
+};
+
+/// The air data of a fleet of aircraft, recalculated incrementally.
+template <typename T>
+  requires std::floating_point<T>
+class FleetStore {
+  FleetTolerances<T> tolerances_;
+
+  // The inputs of the current air data
+  std::vector<T> altitudes_;
+  std::vector<T> cas_;
+  std::vector<T> delta_temperatures_;
+
+  // The air data
+  std::vector<T> pressures_;
+  std::vector<T> temperatures_;
+  std::vector<T> tas_;
+
+  // The indices of the aircraft to recalculate and their compacted columns,
+  // kept between updates to avoid allocation.
+  std::vector<std::size_t> dirty_;
+  std::vector<T> altitude_batch_;
+  std::vector<T> cas_batch_;
+  std::vector<T> delta_batch_;
+  std::vector<T> pressure_batch_;
+  std::vector<T> temperature_batch_;
+  std::vector<T> tas_batch_;
+
+public:
+  /// Constructor.
+  /// @param size the number of aircraft.
+  /// @param tolerances the input tolerances.
+  explicit FleetStore(const std::size_t size,
+                      const FleetTolerances<T> &tolerances = {})
+      : tolerances_{tolerances},
+        // NaN inputs are always different, so the first update
+        // calculates every aircraft.
+        altitudes_(size, std::numeric_limits<T>::quiet_NaN()),
+        cas_(size, std::numeric_limits<T>::quiet_NaN()),
+        delta_temperatures_(size, std::numeric_limits<T>::quiet_NaN()),
+        pressures_(size), temperatures_(size), tas_(size) {
+    dirty_.reserve(size);
+  }
+
+  /// @return the number of aircraft.
+  [[nodiscard]] auto size() const noexcept -> std::size_t {
+    return altitudes_.size();
+  }
+
+  /// @return the input tolerances.
+  [[nodiscard]] auto tolerances() const noexcept -> const FleetTolerances<T> & {
+    return tolerances_;
+  }
+
+  /// Recalculate every aircraft on the next update.
+  void invalidate() noexcept {
+    std::fill(altitudes_.begin(), altitudes_.end(),
+              std::numeric_limits<T>::quiet_NaN());
+  }
+
+  /// Update the air data of the aircraft with new inputs.
+  /// Only the aircraft with an input which differs from the input of its
+  /// current air data by more than its tolerance are recalculated.
+  /// @pre the inputs are the size of the store.
+  /// @param altitudes the pressure altitudes in metres.
+  /// @param cas the Calibrated Air Speeds in metres per second.
+  /// @param delta_temperatures the differences from ISA temperature at Sea
+  /// level in Kelvin.
+  /// @return the report of the update.
+  auto update(std::span<const T> altitudes, std::span<const T> cas,
+              std::span<const T> delta_temperatures) -> FleetTickReport {
+    Expects(altitudes.size() == size());
+    Expects(cas.size() == size());
+    Expects(delta_temperatures.size() == size());
+
+    const auto start{std::chrono::steady_clock::now()};
+
+    // Compact the indices of the changed aircraft, without branches
+    dirty_.resize(size());
+    std::size_t n{};
+    for (std::size_t i{}; i < size(); ++i) {
+      dirty_[n] = i;
+      // Note: a comparison with NaN is false, so NaN inputs are changed
+      const bool unchanged{
+          (std::abs(altitudes[i] - altitudes_[i]) <= tolerances_.altitude) &&
+          (std::abs(cas[i] - cas_[i]) <= tolerances_.cas) &&
+          (std::abs(delta_temperatures[i] - delta_temperatures_[i]) <=
+           tolerances_.delta_temperature)};
+      n += !unchanged;
+    }
+    dirty_.resize(n);
+
+    if (n) {
+      altitude_batch_.resize(n);
+      cas_batch_.resize(n);
+      delta_batch_.resize(n);
+      pressure_batch_.resize(n);
+      temperature_batch_.resize(n);
+      tas_batch_.resize(n);
+
+      for (std::size_t j{}; j < n; ++j) {
+        const auto i{dirty_[j]};
+        altitude_batch_[j] = altitudes_[i] = altitudes[i];
+        cas_batch_[j] = cas_[i] = cas[i];
+        delta_batch_[j] = delta_temperatures_[i] = delta_temperatures[i];
+      }
+
+      batch::calculate_isa_pressure<T>(altitude_batch_, pressure_batch_);
+      batch::calculate_isa_temperature<T>(altitude_batch_, delta_batch_,
+                                          temperature_batch_);
+      batch::calculate_true_air_speed<T>(cas_batch_, pressure_batch_,
+                                         temperature_batch_, tas_batch_);
+
+      for (std::size_t j{}; j < n; ++j) {
+        const auto i{dirty_[j]};
+        pressures_[i] = pressure_batch_[j];
+        temperatures_[i] = temperature_batch_[j];
+        tas_[i] = tas_batch_[j];
+      }
+    }
+
+    return {size(), n,
+            std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now() - start)};
+  }
+
+  /// @return the indices of the aircraft recalculated by the last update.
+  [[nodiscard]] auto recalculated() const noexcept
+      -> std::span<const std::size_t> {
+    return dirty_;
+  }
+
+  /// @return the pressure altitudes of the current air data in metres.
+  [[nodiscard]] auto altitudes() const noexcept -> std::span<const T> {
+    return altitudes_;
+  }
+
+  /// @return the Calibrated Air Speeds of the current air data in metres
+  /// per second.
+  [[nodiscard]] auto cas() const noexcept -> std::span<const T> {
+    return cas_;
+  }
+
+  /// @return the pressures in Pascals.
+  [[nodiscard]] auto pressures() const noexcept -> std::span<const T> {
+    return pressures_;
+  }
+
+  /// @return the temperatures in Kelvin.
+  [[nodiscard]] auto temperatures() const noexcept -> std::span<const T> {
+    return temperatures_;
+  }
+
+  /// @return the True Air Speeds in metres per second.
+  [[nodiscard]] auto true_air_speeds() const noexcept -> std::span<const T> {
+    return tas_;
+  }
+};
+
+} // namespace isa
+} // namespace via
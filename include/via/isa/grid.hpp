@@ -0,0 +1,377 @@
+#pragma once
+
+//////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2024 Ken Barker
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//////////////////////////////////////////////////////////////////////////////
+/// @file
+/// @brief Evaluation of the via::isa functions over tensor product grids,
+/// e.g. of altitudes by temperature deviations by Calibrated Air Speeds.
+///
+/// Many of the terms of the ISA functions depend upon only one axis of a
+/// grid, e.g. the pressure depends only upon altitude and the impact
+/// pressure only upon CAS. So the grid functions calculate the factors of
+/// each axis once, then evaluate the remaining work of each cell in simple
+/// loops along the innermost axis, which compilers may vectorise.
+///
+/// The results are stored in row major order, i.e. the last axis is
+/// contiguous. Where the standard library provides `std::mdspan`, they can
+/// be viewed as one.
+//////////////////////////////////////////////////////////////////////////////
+#include "../isa.hpp"
+#include <algorithm>
+#include <array>
+#include <functional>
+#include <numeric>
+#include <span>
+#include <vector>
+#if __has_include(<mdspan>)
+#include <mdspan>
+#endif
+
+namespace via {
+namespace isa {
+namespace grid {
+
+/// The values of a function over a grid.
+template <typename T, std::size_t Rank>
+  requires std::floating_point<T>
+class GridValues {
+  std::array<std::size_t, Rank> extents_;
+  std::vector<T> values_;
+
+public:
+  /// Constructor.
+  /// @param extents the sizes of the axes of the grid.
+  explicit GridValues(const std::array<std::size_t, Rank> &extents)
+      : extents_{extents},
+        values_(std::accumulate(extents.begin(), extents.end(),
+                                std::size_t{1}, std::multiplies<>())) {}
+
+  /// @return the sizes of the axes of the grid.
+  [[nodiscard]] auto extents() const noexcept
+      -> const std::array<std::size_t, Rank> & {
+    return extents_;
+  }
+
+  /// @return the size of an axis of the grid.
+  [[nodiscard]] auto extent(const std::size_t axis) const -> std::size_t {
+    return extents_[axis];
+  }
+
+  /// @return the number of values.
+  [[nodiscard]] auto size() const noexcept -> std::size_t {
+    return values_.size();
+  }
+
+  /// @return the values in row major order.
+  [[nodiscard]] auto values() const noexcept -> std::span<const T> {
+    return values_;
+  }
+
+  /// @return the values in row major order.
+  [[nodiscard]] auto values() noexcept -> std::span<T> { return values_; }
+
+  /// @return the value at the indices of a grid cell.
+  template <typename... Indices>
+    requires(sizeof...(Indices) == Rank)
+  [[nodiscard]] auto operator()(const Indices... indices) const -> T {
+    const std::array<std::size_t, Rank> index{
+        static_cast<std::size_t>(indices)...};
+    std::size_t offset{};
+    for (std::size_t axis{}; axis < Rank; ++axis)
+      offset = offset * extents_[axis] + index[axis];
+    return values_[offset];
+  }
+
+#ifdef __cpp_lib_mdspan
+  /// @return an mdspan view of the values.
+  [[nodiscard]] auto mdspan() const noexcept
+      -> std::mdspan<const T, std::dextents<std::size_t, Rank>> {
+    return std::mdspan<const T, std::dextents<std::size_t, Rank>>(
+        values_.data(), extents_);
+  }
+#endif
+};
+
+/// Evaluate a function over a two dimensional grid.
+/// @param outer the values of the outer axis.
+/// @param inner the values of the inner axis.
+/// @param outer_factor a function of an outer axis value.
+/// @param inner_factor a function of an inner axis value.
+/// @param kernel a function of an outer factor and an inner factor.
+/// @return the values of the kernel over the grid.
+template <typename T, typename OuterFactor, typename InnerFactor,
+          typename Kernel>
+  requires std::floating_point<T>
+auto evaluate_grid(std::span<const T> outer, std::span<const T> inner,
+                   OuterFactor &&outer_factor, InnerFactor &&inner_factor,
+                   Kernel &&kernel) -> GridValues<T, 2> {
+  GridValues<T, 2> grid({outer.size(), inner.size()});
+
+  std::vector<std::invoke_result_t<InnerFactor &, T>> inner_factors;
+  inner_factors.reserve(inner.size());
+  for (const T value : inner)
+    inner_factors.push_back(inner_factor(value));
+
+  const auto values{grid.values()};
+  for (std::size_t o{}; o < outer.size(); ++o) {
+    const auto factor{outer_factor(outer[o])};
+    const auto row{values.subspan(o * inner.size(), inner.size())};
+    for (std::size_t i{}; i < inner.size(); ++i)
+      row[i] = kernel(factor, inner_factors[i]);
+  }
+  return grid;
+}
+
+/// Evaluate a function over a three dimensional grid.
+/// @param outer the values of the outer axis.
+/// @param middle the values of the middle axis.
+/// @param inner the values of the inner axis.
+/// @param outer_factor a function of an outer axis value.
+/// @param middle_factor a function of a middle axis value.
+/// @param inner_factor a function of an inner axis value.
+/// @param kernel a function of an outer factor, a middle factor and an inner
+/// factor.
+/// @return the values of the kernel over the grid.
+template <typename T, typename OuterFactor, typename MiddleFactor,
+          typename InnerFactor, typename Kernel>
+  requires std::floating_point<T>
+auto evaluate_grid(std::span<const T> outer, std::span<const T> middle,
+                   std::span<const T> inner, OuterFactor &&outer_factor,
+                   MiddleFactor &&middle_factor, InnerFactor &&inner_factor,
+                   Kernel &&kernel) -> GridValues<T, 3> {
+  GridValues<T, 3> grid({outer.size(), middle.size(), inner.size()});
+
+  std::vector<std::invoke_result_t<MiddleFactor &, T>> middle_factors;
+  middle_factors.reserve(middle.size());
+  for (const T value : middle)
+    middle_factors.push_back(middle_factor(value));
+
+  std::vector<std::invoke_result_t<InnerFactor &, T>> inner_factors;
+  inner_factors.reserve(inner.size());
+  for (const T value : inner)
+    inner_factors.push_back(inner_factor(value));
+
+  const auto values{grid.values()};
+  for (std::size_t o{}; o < outer.size(); ++o) {
+    const auto factor{outer_factor(outer[o])};
+    for (std::size_t m{}; m < middle.size(); ++m) {
+      const auto row{values.subspan((o * middle.size() + m) * inner.size(),
+                                    inner.size())};
+      for (std::size_t i{}; i < inner.size(); ++i)
+        row[i] = kernel(factor, middle_factors[m], inner_factors[i]);
+    }
+  }
+  return grid;
+}
+
+namespace detail {
+/// The factors of an altitude.
+template <typename T>
+  requires std::floating_point<T>
+struct AltitudeFactors {
+  /// The pressure in Pascals.
+  T pressure;
+  /// The ISA temperature without the limit at the tropopause in Kelvin.
+  T temperature;
+};
+
+/// Calculate the factors of an altitude.
+template <typename T>
+  requires std::floating_point<T>
+auto altitude_factors(const T altitude) -> AltitudeFactors<T> {
+  return AltitudeFactors<T>{
+      calculate_isa_pressure(units::si::Metres<T>(altitude)).v(),
+      constants::SEA_LEVEL_TEMPERATURE<T>.v() +
+          constants::TEMPERATURE_GRADIENT<T> * altitude};
+}
+
+/// Calculate the temperature of the factors of an altitude and a
+/// difference from ISA temperature, see `calculate_isa_temperature`.
+template <typename T>
+  requires std::floating_point<T>
+constexpr auto temperature(const AltitudeFactors<T> &altitude,
+                           const T delta_temperature) -> T {
+  return std::max(altitude.temperature + delta_temperature,
+                  constants::TROPOPAUSE_TEMPERATURE<T>.v());
+}
+} // namespace detail
+
+/// Calculate the ISA pressures of altitudes.
+/// @param altitudes the pressure altitudes in metres.
+/// @return the pressures in Pascals.
+template <typename T>
+  requires std::floating_point<T>
+auto calculate_isa_pressure(std::span<const T> altitudes) -> GridValues<T, 1> {
+  GridValues<T, 1> grid({altitudes.size()});
+  const auto values{grid.values()};
+  for (std::size_t a{}; a < altitudes.size(); ++a)
+    values[a] =
+        isa::calculate_isa_pressure(units::si::Metres<T>(altitudes[a])).v();
+  return grid;
+}
+
+/// Calculate the air densities over a grid of altitudes by temperature
+/// deviations.
+/// @param altitudes the pressure altitudes in metres.
+/// @param delta_temperatures the differences from ISA temperature at Sea
+/// level in Kelvin.
+/// @return the densities in Kg per cubic metre.
+template <typename T>
+  requires std::floating_point<T>
+auto calculate_density(std::span<const T> altitudes,
+                       std::span<const T> delta_temperatures)
+    -> GridValues<T, 2> {
+  return evaluate_grid<T>(
+      altitudes, delta_temperatures, detail::altitude_factors<T>,
+      [](const T delta_temperature) { return delta_temperature; },
+      [](const detail::AltitudeFactors<T> &altitude,
+         const T delta_temperature) {
+        return altitude.pressure /
+               (constants::R<T> *
+                detail::temperature(altitude, delta_temperature));
+      });
+}
+
+/// Calculate the True Air Speeds over a grid of altitudes by temperature
+/// deviations by Calibrated Air Speeds.
+/// The impact pressure of each CAS and the pressure of each altitude are
+/// calculated once. The pressure term of each altitude and CAS is calculated
+/// once per altitude and the temperature term of each altitude and
+/// temperature deviation once per row, so each cell is a multiplication.
+/// @param altitudes the pressure altitudes in metres.
+/// @param delta_temperatures the differences from ISA temperature at Sea
+/// level in Kelvin.
+/// @param cas the Calibrated Air Speeds in metres per second.
+/// @return the True Air Speeds in metres per second.
+template <typename T>
+  requires std::floating_point<T>
+auto calculate_true_air_speed(std::span<const T> altitudes,
+                              std::span<const T> delta_temperatures,
+                              std::span<const T> cas) -> GridValues<T, 3> {
+  constexpr T OUTER_FACTOR{T(2) * constants::R<T> / U<T>};
+
+  const auto speeds{cas.size()};
+  GridValues<T, 3> grid({altitudes.size(), delta_temperatures.size(), speeds});
+
+  std::vector<T> impact_pressures(speeds);
+  for (std::size_t s{}; s < speeds; ++s)
+    impact_pressures[s] =
+        calculate_impact_pressure(units::si::MetresPerSecond<T>(cas[s])).v();
+
+  std::vector<T> pressure_terms(speeds);
+  const auto values{grid.values()};
+  for (std::size_t a{}; a < altitudes.size(); ++a) {
+    const auto altitude{detail::altitude_factors(altitudes[a])};
+    for (std::size_t s{}; s < speeds; ++s)
+      pressure_terms[s] = std::sqrt(
+          std::pow(T(1) + impact_pressures[s] / altitude.pressure, U<T>) -
+          T(1));
+
+    for (std::size_t d{}; d < delta_temperatures.size(); ++d) {
+      const T temperature_term{std::sqrt(
+          OUTER_FACTOR * detail::temperature(altitude, delta_temperatures[d]))};
+      const auto row{values.subspan(
+          (a * delta_temperatures.size() + d) * speeds, speeds)};
+      for (std::size_t s{}; s < speeds; ++s)
+        row[s] = temperature_term * pressure_terms[s];
+    }
+  }
+  return grid;
+}
+
+/// Calculate the Calibrated Air Speeds over a grid of altitudes by
+/// temperature deviations by True Air Speeds.
+/// @param altitudes the pressure altitudes in metres.
+/// @param delta_temperatures the differences from ISA temperature at Sea
+/// level in Kelvin.
+/// @param tas the True Air Speeds in metres per second.
+/// @return the Calibrated Air Speeds in metres per second.
+template <typename T>
+  requires std::floating_point<T>
+auto calculate_calibrated_air_speed(std::span<const T> altitudes,
+                                    std::span<const T> delta_temperatures,
+                                    std::span<const T> tas)
+    -> GridValues<T, 3> {
+  constexpr T INNER_FACTOR{U<T> / (T(2) * constants::R<T>)};
+  constexpr T OUTER_FACTOR{T(2) * constants::R<T> *
+                           constants::SEA_LEVEL_TEMPERATURE<T>.v() / U<T>};
+
+  return evaluate_grid<T>(
+      altitudes, delta_temperatures, tas, detail::altitude_factors<T>,
+      [](const T delta_temperature) { return delta_temperature; },
+      [](const T speed) { return INNER_FACTOR * speed * speed; },
+      [](const detail::AltitudeFactors<T> &altitude, const T delta_temperature,
+         const T speed_term) {
+        const T tas_factor{
+            std::pow(T(1) + speed_term / detail::temperature(
+                                             altitude, delta_temperature),
+                     INV_U<T>) -
+            T(1)};
+        return std::sqrt(
+            OUTER_FACTOR *
+            (std::pow(T(1) + altitude.pressure * tas_factor /
+                                 constants::SEA_LEVEL_PRESSURE<T>.v(),
+                      U<T>) -
+             T(1)));
+      });
+}
+
+/// Calculate the crossover altitudes over a grid of Calibrated Air Speeds
+/// by Mach numbers.
+/// The numerator of the crossover pressure ratio depends only upon the CAS
+/// and the denominator only upon the Mach number.
+/// @pre the Mach numbers are positive.
+/// @param cas the Calibrated Air Speeds in metres per second.
+/// @param machs the Mach numbers.
+/// @return the crossover altitudes in metres.
+template <typename T>
+  requires std::floating_point<T>
+auto calculate_crossover_altitude(std::span<const T> cas,
+                                  std::span<const T> machs)
+    -> GridValues<T, 2> {
+  constexpr T K_MINUS_1_OVER_2{(constants::K<T> - T(1)) / T(2)};
+
+  return evaluate_grid<T>(
+      cas, machs,
+      [](const T speed) {
+        const T cas_mach{speed / constants::SEA_LEVEL_SPEED_OF_SOUND<T>.v()};
+        return std::pow(T(1) + K_MINUS_1_OVER_2 * cas_mach * cas_mach,
+                        INV_U<T>) -
+               T(1);
+      },
+      [](const T mach) {
+        Expects(mach > T());
+        return T(1) /
+               (std::pow(T(1) + K_MINUS_1_OVER_2 * mach * mach, INV_U<T>) -
+                T(1));
+      },
+      [](const T numerator, const T inverse_denominator) {
+        return constants::SEA_LEVEL_TEMPERATURE<T>.v() *
+               (T(1) - std::pow(numerator * inverse_denominator,
+                                TEMPERATURE_POWER<T>)) /
+               -constants::TEMPERATURE_GRADIENT<T>;
+      });
+}
+
+} // namespace grid
+} // namespace isa
+} // namespace via
@@ -0,0 +1,274 @@
+#pragma once
+
+//////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2024 Ken Barker
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//////////////////////////////////////////////////////////////////////////////
+/// @file
+/// @brief Moist air versions of the via::isa density function.
+///
+/// Water vapour is lighter than dry air, so moist air is less dense than dry
+/// air at the same pressure and temperature. Its density is the density of
+/// dry air at the virtual temperature:
+///
+///     Tv = T / (1 - (e / p) * (1 - Rd / Rv))
+///
+/// where `e` is the vapour pressure of the water in the air, calculated from
+/// the relative humidity or the dewpoint with the Magnus formula for the
+/// saturation vapour pressure over water, see: Alduchov, O. A. and
+/// Eskridge, R. E. 1996: Improved Magnus Form Approximation of Saturation
+/// Vapor Pressure.
+///
+/// The batch functions calculate the vapour pressures, virtual temperatures
+/// and densities in a single loop. They take either a column of humidities
+/// or a single humidity for all of the values, e.g. at an airport.
+//////////////////////////////////////////////////////////////////////////////
+#include "../isa.hpp"
+#include <span>
+
+namespace via {
+namespace isa {
+namespace humidity {
+
+/// The gas constant for water vapour (Rv) in metres squared per Kelvin
+/// seconds squared.
+template <typename T>
+  requires std::floating_point<T>
+constexpr T WATER_VAPOUR_R{461.52};
+
+/// The ratio of the gas constants of dry air and water vapour: Rd / Rv.
+template <typename T>
+  requires std::floating_point<T>
+constexpr T EPSILON{constants::R<T> / WATER_VAPOUR_R<T>};
+
+/// The Magnus formula coefficients for saturation over water.
+template <typename T>
+  requires std::floating_point<T>
+constexpr T MAGNUS_PRESSURE{610.94};
+template <typename T>
+  requires std::floating_point<T>
+constexpr T MAGNUS_B{17.625};
+template <typename T>
+  requires std::floating_point<T>
+constexpr T MAGNUS_C{243.04};
+
+/// The Magnus formula coefficients for saturation over ice.
+template <typename T>
+  requires std::floating_point<T>
+constexpr T MAGNUS_ICE_PRESSURE{611.21};
+template <typename T>
+  requires std::floating_point<T>
+constexpr T MAGNUS_ICE_B{22.587};
+template <typename T>
+  requires std::floating_point<T>
+constexpr T MAGNUS_ICE_C{273.86};
+
+/// The temperature of 0°C in Kelvin.
+template <typename T>
+  requires std::floating_point<T>
+constexpr T ZERO_CELSIUS{273.15};
+
+/// Calculate the saturation vapour pressure over water with the Magnus
+/// formula.
+/// @param temperature the temperature in Kelvin.
+/// @return the saturation vapour pressure in Pascals.
+template <typename T>
+  requires std::floating_point<T>
+[[nodiscard("Pure Function")]]
+constexpr auto saturation_vapour_pressure(const units::si::Kelvin<T> temperature)
+    -> units::si::Pascals<T> {
+  const T celsius{temperature.v() - ZERO_CELSIUS<T>};
+  return units::si::Pascals<T>(
+      MAGNUS_PRESSURE<T> *
+      std::exp(MAGNUS_B<T> * celsius / (celsius + MAGNUS_C<T>)));
+}
+
+/// Calculate the saturation vapour pressure over ice with the Magnus
+/// formula.
+/// @param temperature the temperature in Kelvin.
+/// @return the saturation vapour pressure in Pascals.
+template <typename T>
+  requires std::floating_point<T>
+[[nodiscard("Pure Function")]]
+constexpr auto
+saturation_vapour_pressure_ice(const units::si::Kelvin<T> temperature)
+    -> units::si::Pascals<T> {
+  const T celsius{temperature.v() - ZERO_CELSIUS<T>};
+  return units::si::Pascals<T>(
+      MAGNUS_ICE_PRESSURE<T> *
+      std::exp(MAGNUS_ICE_B<T> * celsius / (celsius + MAGNUS_ICE_C<T>)));
+}
+
+/// Calculate the virtual temperature of moist air.
+/// @pre pressure > vapour_pressure
+/// @param pressure the pressure in Pascals.
+/// @param temperature the temperature in Kelvin.
+/// @param vapour_pressure the vapour pressure of the water in Pascals.
+/// @return the virtual temperature in Kelvin.
+template <typename T>
+  requires std::floating_point<T>
+[[nodiscard("Pure Function")]]
+constexpr auto calculate_virtual_temperature(
+    const units::si::Pascals<T> pressure,
+    const units::si::Kelvin<T> temperature,
+    const units::si::Pascals<T> vapour_pressure) -> units::si::Kelvin<T> {
+  return units::si::Kelvin<T>(
+      temperature.v() /
+      (T(1) - (vapour_pressure.v() / pressure.v()) * (T(1) - EPSILON<T>)));
+}
+
+/// Calculate the density of moist air from its relative humidity.
+/// @pre temperature > 0
+/// @param pressure the pressure in Pascals.
+/// @param temperature the temperature in Kelvin.
+/// @param relative_humidity the relative humidity, from 0 to 1.
+/// @return the density in Kg per cubic metre.
+template <typename T>
+  requires std::floating_point<T>
+[[nodiscard("Pure Function")]]
+constexpr auto calculate_density(const units::si::Pascals<T> pressure,
+                                 const units::si::Kelvin<T> temperature,
+                                 const T relative_humidity)
+    -> units::si::KilogramsPerCubicMetre<T> {
+  const auto vapour_pressure{units::si::Pascals<T>(
+      relative_humidity * saturation_vapour_pressure(temperature).v())};
+  return isa::calculate_density(
+      pressure,
+      calculate_virtual_temperature(pressure, temperature, vapour_pressure));
+}
+
+/// Calculate the density of moist air from its dewpoint.
+/// @pre temperature > 0
+/// @param pressure the pressure in Pascals.
+/// @param temperature the temperature in Kelvin.
+/// @param dewpoint the dewpoint in Kelvin.
+/// @return the density in Kg per cubic metre.
+template <typename T>
+  requires std::floating_point<T>
+[[nodiscard("Pure Function")]]
+constexpr auto calculate_density_dewpoint(const units::si::Pascals<T> pressure,
+                                          const units::si::Kelvin<T> temperature,
+                                          const units::si::Kelvin<T> dewpoint)
+    -> units::si::KilogramsPerCubicMetre<T> {
+  return isa::calculate_density(
+      pressure, calculate_virtual_temperature(
+                    pressure, temperature, saturation_vapour_pressure(dewpoint)));
+}
+
+/// Calculate the densities of moist air from their relative humidities.
+/// @pre the spans are the same size.
+/// @param pressures the pressures in Pascals.
+/// @param temperatures the temperatures in Kelvin.
+/// @param relative_humidities the relative humidities, from 0 to 1.
+/// @param densities the densities in Kg per cubic metre.
+template <typename T>
+  requires std::floating_point<T>
+constexpr void calculate_density(std::span<const T> pressures,
+                                 std::span<const T> temperatures,
+                                 std::span<const T> relative_humidities,
+                                 std::span<T> densities) {
+  Expects(pressures.size() == temperatures.size());
+  Expects(pressures.size() == relative_humidities.size());
+  Expects(pressures.size() == densities.size());
+
+  for (std::size_t i{}; i < pressures.size(); ++i)
+    densities[i] = calculate_density(units::si::Pascals<T>(pressures[i]),
+                                     units::si::Kelvin<T>(temperatures[i]),
+                                     relative_humidities[i])
+                       .v();
+}
+
+/// Calculate the densities of moist air with the same relative humidity.
+/// @pre the spans are the same size.
+/// @param pressures the pressures in Pascals.
+/// @param temperatures the temperatures in Kelvin.
+/// @param relative_humidity the relative humidity, from 0 to 1.
+/// @param densities the densities in Kg per cubic metre.
+template <typename T>
+  requires std::floating_point<T>
+constexpr void calculate_density(std::span<const T> pressures,
+                                 std::span<const T> temperatures,
+                                 const T relative_humidity,
+                                 std::span<T> densities) {
+  Expects(pressures.size() == temperatures.size());
+  Expects(pressures.size() == densities.size());
+
+  for (std::size_t i{}; i < pressures.size(); ++i)
+    densities[i] = calculate_density(units::si::Pascals<T>(pressures[i]),
+                                     units::si::Kelvin<T>(temperatures[i]),
+                                     relative_humidity)
+                       .v();
+}
+
+/// Calculate the densities of moist air from their dewpoints.
+/// @pre the spans are the same size.
+/// @param pressures the pressures in Pascals.
+/// @param temperatures the temperatures in Kelvin.
+/// @param dewpoints the dewpoints in Kelvin.
+/// @param densities the densities in Kg per cubic metre.
+template <typename T>
+  requires std::floating_point<T>
+constexpr void calculate_density_dewpoint(std::span<const T> pressures,
+                                          std::span<const T> temperatures,
+                                          std::span<const T> dewpoints,
+                                          std::span<T> densities) {
+  Expects(pressures.size() == temperatures.size());
+  Expects(pressures.size() == dewpoints.size());
+  Expects(pressures.size() == densities.size());
+
+  for (std::size_t i{}; i < pressures.size(); ++i)
+    densities[i] =
+        calculate_density_dewpoint(units::si::Pascals<T>(pressures[i]),
+                                   units::si::Kelvin<T>(temperatures[i]),
+                                   units::si::Kelvin<T>(dewpoints[i]))
+            .v();
+}
+
+/// Calculate the densities of moist air with the same dewpoint.
+/// The saturation vapour pressure of the dewpoint is calculated once.
+/// @pre the spans are the same size.
+/// @param pressures the pressures in Pascals.
+/// @param temperatures the temperatures in Kelvin.
+/// @param dewpoint the dewpoint in Kelvin.
+/// @param densities the densities in Kg per cubic metre.
+template <typename T>
+  requires std::floating_point<T>
+constexpr void calculate_density_dewpoint(std::span<const T> pressures,
+                                          std::span<const T> temperatures,
+                                          const units::si::Kelvin<T> dewpoint,
+                                          std::span<T> densities) {
+  Expects(pressures.size() == temperatures.size());
+  Expects(pressures.size() == densities.size());
+
+  const auto vapour_pressure{saturation_vapour_pressure(dewpoint)};
+  for (std::size_t i{}; i < pressures.size(); ++i) {
+    const auto pressure{units::si::Pascals<T>(pressures[i])};
+    densities[i] = isa::calculate_density(
+                       pressure, calculate_virtual_temperature(
+                                     pressure,
+                                     units::si::Kelvin<T>(temperatures[i]),
+                                     vapour_pressure))
+                       .v();
+  }
+}
+
+} // namespace humidity
+} // namespace isa
+} // namespace via
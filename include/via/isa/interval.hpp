@@ -0,0 +1,430 @@
+#pragma once
+
+//////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2024 Ken Barker
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//////////////////////////////////////////////////////////////////////////////
+/// @file
+/// @brief Interval versions of the via::isa functions.
+///
+/// The ISA functions are monotonic in each of their arguments over their
+/// valid domains, e.g. True Air Speed increases with Calibrated Air Speed
+/// and temperature and decreases with pressure. So the bounds of a function
+/// of intervals are the function evaluated at the corners of the
+/// intervals that minimise and maximise it: two evaluations per value.
+///
+/// The scalar functions are not correctly rounded, so the bounds are
+/// rounded outwards by a relative margin of `ROUNDING_MARGIN`, which is
+/// greater than their accumulated rounding errors, then by another ulp.
+/// Where a function subtracts nearly equal numbers, e.g. altitude near Sea
+/// level or air speeds near zero, its error does not shrink with its result,
+/// so the bounds are also rounded outwards by an absolute margin scaled to
+/// the operands of the subtraction. So the bounds contain the exact results
+/// for all of the values within the input intervals.
+///
+/// Where inputs depend upon the same value, e.g. the pressure and
+/// temperature at an altitude, the bounds of functions of them are
+/// conservative but not tight.
+//////////////////////////////////////////////////////////////////////////////
+#include "../isa.hpp"
+#include <cmath>
+#include <limits>
+#include <span>
+
+namespace via {
+namespace isa {
+namespace interval {
+
+/// An interval of values in the SI units of the corresponding functions.
+template <typename T>
+  requires std::floating_point<T>
+struct Interval {
+  /// The lower bound.
+  T lower;
+  /// The upper bound.
+  T upper;
+
+  /// @return the width of the interval.
+  [[nodiscard]] constexpr auto width() const noexcept -> T {
+    return upper - lower;
+  }
+
+  /// @return true if the interval contains the value, false otherwise.
+  [[nodiscard]] constexpr auto contains(const T value) const noexcept -> bool {
+    return (lower <= value) && (value <= upper);
+  }
+};
+
+/// Create an interval from a value and its maximum error.
+/// @pre error >= 0
+/// @param value the value.
+/// @param error the maximum error of the value.
+/// @return the interval [value - error, value + error].
+template <typename T>
+  requires std::floating_point<T>
+[[nodiscard("Pure Function")]]
+constexpr auto make_interval(const T value, const T error) -> Interval<T> {
+  Expects(error >= T());
+
+  return Interval<T>{value - error, value + error};
+}
+
+/// The relative margin to round bounds outwards by: 64 epsilons.
+template <typename T>
+  requires std::floating_point<T>
+constexpr T ROUNDING_MARGIN{64 * std::numeric_limits<T>::epsilon()};
+
+/// Round the bounds of a calculated interval outwards.
+/// @pre error >= 0
+/// @param lower the calculated lower bound.
+/// @param upper the calculated upper bound.
+/// @param error the absolute error of the calculation that does not scale
+/// with its result, e.g. from subtracting nearly equal numbers.
+/// @return the rounded interval.
+template <typename T>
+  requires std::floating_point<T>
+[[nodiscard("Pure Function")]]
+auto round_outwards(const T lower, const T upper, const T error = T())
+    -> Interval<T> {
+  Expects(error >= T());
+
+  return Interval<T>{
+      std::nextafter(lower - std::abs(lower) * ROUNDING_MARGIN<T> - error,
+                     -std::numeric_limits<T>::infinity()),
+      std::nextafter(upper + std::abs(upper) * ROUNDING_MARGIN<T> + error,
+                     std::numeric_limits<T>::infinity())};
+}
+
+/// Calculate the bounds of the ISA pressure of an altitude interval.
+/// Pressure decreases with altitude.
+/// @param altitude the pressure altitudes in metres.
+/// @return the pressures in Pascals.
+template <typename T>
+  requires std::floating_point<T>
+[[nodiscard("Pure Function")]]
+auto calculate_isa_pressure(const Interval<T> altitude) -> Interval<T> {
+  return round_outwards(
+      isa::calculate_isa_pressure(units::si::Metres<T>(altitude.upper)).v(),
+      isa::calculate_isa_pressure(units::si::Metres<T>(altitude.lower)).v());
+}
+
+/// Calculate the bounds of the ISA altitude of a pressure interval.
+/// Altitude decreases with pressure.
+/// @pre pressure.lower > 0
+/// @param pressure the pressures in Pascals.
+/// @return the pressure altitudes in metres.
+template <typename T>
+  requires std::floating_point<T>
+[[nodiscard("Pure Function")]]
+auto calculate_isa_altitude(const Interval<T> pressure) -> Interval<T> {
+  // The altitude is T0 / L * (1 - (p / P0)^k) below the tropopause
+  constexpr T SCALE{constants::SEA_LEVEL_TEMPERATURE<T>.v() /
+                    -constants::TEMPERATURE_GRADIENT<T>};
+
+  return round_outwards(
+      isa::calculate_isa_altitude(units::si::Pascals<T>(pressure.upper)).v(),
+      isa::calculate_isa_altitude(units::si::Pascals<T>(pressure.lower)).v(),
+      ROUNDING_MARGIN<T> * SCALE);
+}
+
+/// Calculate the bounds of the ISA temperature of altitude and temperature
+/// difference intervals.
+/// Temperature decreases with altitude (to the tropopause) and increases
+/// with the temperature difference.
+/// @param altitude the pressure altitudes in metres.
+/// @param delta_temperature the differences from ISA temperature at Sea
+/// level in Kelvin.
+/// @return the temperatures in Kelvin.
+template <typename T>
+  requires std::floating_point<T>
+[[nodiscard("Pure Function")]]
+auto calculate_isa_temperature(const Interval<T> altitude,
+                               const Interval<T> delta_temperature)
+    -> Interval<T> {
+  return round_outwards(
+      isa::calculate_isa_temperature(
+          units::si::Metres<T>(altitude.upper),
+          units::si::Kelvin<T>(delta_temperature.lower))
+          .v(),
+      isa::calculate_isa_temperature(
+          units::si::Metres<T>(altitude.lower),
+          units::si::Kelvin<T>(delta_temperature.upper))
+          .v());
+}
+
+/// Calculate the bounds of the air density of pressure and temperature
+/// intervals.
+/// Density increases with pressure and decreases with temperature.
+/// @pre temperature.lower > 0
+/// @param pressure the pressures in Pascals.
+/// @param temperature the temperatures in Kelvin.
+/// @return the densities in Kg per cubic metre.
+template <typename T>
+  requires std::floating_point<T>
+[[nodiscard("Pure Function")]]
+auto calculate_density(const Interval<T> pressure,
+                       const Interval<T> temperature) -> Interval<T> {
+  return round_outwards(
+      isa::calculate_density(units::si::Pascals<T>(pressure.lower),
+                             units::si::Kelvin<T>(temperature.upper))
+          .v(),
+      isa::calculate_density(units::si::Pascals<T>(pressure.upper),
+                             units::si::Kelvin<T>(temperature.lower))
+          .v());
+}
+
+/// Calculate the bounds of the True Air Speed of Calibrated Air Speed,
+/// pressure and temperature intervals.
+/// TAS increases with CAS and temperature and decreases with pressure.
+/// @pre cas.lower >= 0, pressure.lower > 0 and temperature.lower > 0
+/// @param cas the Calibrated Air Speeds in metres per second.
+/// @param pressure the pressures in Pascals.
+/// @param temperature the temperatures in Kelvin.
+/// @return the True Air Speeds in metres per second.
+template <typename T>
+  requires std::floating_point<T>
+[[nodiscard("Pure Function")]]
+auto calculate_true_air_speed(const Interval<T> cas, const Interval<T> pressure,
+                              const Interval<T> temperature) -> Interval<T> {
+  // TAS is the square root of 2 R T / U times a difference of numbers
+  // near 1 + P0 / p
+  constexpr T FACTOR{T(2) * constants::R<T> / U<T>};
+  const T error{std::sqrt(
+      FACTOR * temperature.upper * ROUNDING_MARGIN<T> *
+      (T(1) + constants::SEA_LEVEL_PRESSURE<T>.v() / pressure.lower))};
+
+  return round_outwards(
+      isa::calculate_true_air_speed(units::si::MetresPerSecond<T>(cas.lower),
+                                    units::si::Pascals<T>(pressure.upper),
+                                    units::si::Kelvin<T>(temperature.lower))
+          .v(),
+      isa::calculate_true_air_speed(units::si::MetresPerSecond<T>(cas.upper),
+                                    units::si::Pascals<T>(pressure.lower),
+                                    units::si::Kelvin<T>(temperature.upper))
+          .v(),
+      error);
+}
+
+/// Calculate the bounds of the Calibrated Air Speed of True Air Speed,
+/// pressure and temperature intervals.
+/// CAS increases with TAS and pressure and decreases with temperature.
+/// @pre tas.lower >= 0, pressure.lower > 0 and temperature.lower > 0
+/// @param tas the True Air Speeds in metres per second.
+/// @param pressure the pressures in Pascals.
+/// @param temperature the temperatures in Kelvin.
+/// @return the Calibrated Air Speeds in metres per second.
+template <typename T>
+  requires std::floating_point<T>
+[[nodiscard("Pure Function")]]
+auto calculate_calibrated_air_speed(const Interval<T> tas,
+                                    const Interval<T> pressure,
+                                    const Interval<T> temperature)
+    -> Interval<T> {
+  // CAS is the square root of 2 R T0 / U times a difference of numbers
+  // near 1 + p / P0
+  constexpr T FACTOR{T(2) * constants::R<T> *
+                     constants::SEA_LEVEL_TEMPERATURE<T>.v() / U<T>};
+  const T error{std::sqrt(
+      FACTOR * ROUNDING_MARGIN<T> *
+      (T(1) + pressure.upper / constants::SEA_LEVEL_PRESSURE<T>.v()))};
+
+  return round_outwards(
+      isa::calculate_calibrated_air_speed(
+          units::si::MetresPerSecond<T>(tas.lower),
+          units::si::Pascals<T>(pressure.lower),
+          units::si::Kelvin<T>(temperature.upper))
+          .v(),
+      isa::calculate_calibrated_air_speed(
+          units::si::MetresPerSecond<T>(tas.upper),
+          units::si::Pascals<T>(pressure.upper),
+          units::si::Kelvin<T>(temperature.lower))
+          .v(),
+      error);
+}
+
+/// Calculate the bounds of the speed of sound of a temperature interval.
+/// @pre temperature.lower > 0
+/// @param temperature the temperatures in Kelvin.
+/// @return the speeds of sound in metres per second.
+template <typename T>
+  requires std::floating_point<T>
+[[nodiscard("Pure Function")]]
+auto speed_of_sound(const Interval<T> temperature) -> Interval<T> {
+  return round_outwards(
+      isa::speed_of_sound(units::si::Kelvin<T>(temperature.lower)).v(),
+      isa::speed_of_sound(units::si::Kelvin<T>(temperature.upper)).v());
+}
+
+/// Calculate the bounds of the Mach number of Calibrated Air Speed and
+/// pressure intervals.
+/// Mach increases with CAS and decreases with pressure.
+/// @pre cas.lower >= 0 and pressure.lower > 0
+/// @param cas the Calibrated Air Speeds in metres per second.
+/// @param pressure the pressures in Pascals.
+/// @return the Mach numbers.
+template <typename T>
+  requires std::floating_point<T>
+[[nodiscard("Pure Function")]]
+auto calibrated_air_speed_mach(const Interval<T> cas,
+                               const Interval<T> pressure) -> Interval<T> {
+  // Mach is the square root of 2 / (K - 1) times a difference of numbers
+  // near 1 + P0 / p
+  constexpr T FACTOR{T(2) / (constants::K<T> - T(1))};
+  const T error{std::sqrt(
+      FACTOR * ROUNDING_MARGIN<T> *
+      (T(1) + constants::SEA_LEVEL_PRESSURE<T>.v() / pressure.lower))};
+
+  return round_outwards(
+      isa::calibrated_air_speed_mach(units::si::MetresPerSecond<T>(cas.lower),
+                                     units::si::Pascals<T>(pressure.upper)),
+      isa::calibrated_air_speed_mach(units::si::MetresPerSecond<T>(cas.upper),
+                                     units::si::Pascals<T>(pressure.lower)),
+      error);
+}
+
+/// Calculate the bounds of the Mach number of True Air Speed and
+/// temperature intervals.
+/// Mach increases with TAS and decreases with temperature.
+/// @pre tas.lower >= 0 and temperature.lower > 0
+/// @param tas the True Air Speeds in metres per second.
+/// @param temperature the temperatures in Kelvin.
+/// @return the Mach numbers.
+template <typename T>
+  requires std::floating_point<T>
+[[nodiscard("Pure Function")]]
+auto true_air_speed_mach(const Interval<T> tas, const Interval<T> temperature)
+    -> Interval<T> {
+  return round_outwards(
+      isa::true_air_speed_mach(units::si::MetresPerSecond<T>(tas.lower),
+                               units::si::Kelvin<T>(temperature.upper)),
+      isa::true_air_speed_mach(units::si::MetresPerSecond<T>(tas.upper),
+                               units::si::Kelvin<T>(temperature.lower)));
+}
+
+/// Calculate the bounds of the True Air Speed of Mach number and
+/// temperature intervals.
+/// TAS increases with Mach and temperature.
+/// @pre mach.lower > 0 and temperature.lower > 0
+/// @param mach the Mach numbers.
+/// @param temperature the temperatures in Kelvin.
+/// @return the True Air Speeds in metres per second.
+template <typename T>
+  requires std::floating_point<T>
+[[nodiscard("Pure Function")]]
+auto mach_true_air_speed(const Interval<T> mach, const Interval<T> temperature)
+    -> Interval<T> {
+  return round_outwards(
+      isa::mach_true_air_speed(mach.lower,
+                               units::si::Kelvin<T>(temperature.lower))
+          .v(),
+      isa::mach_true_air_speed(mach.upper,
+                               units::si::Kelvin<T>(temperature.upper))
+          .v());
+}
+
+/// Calculate the bounds of the ISA pressures of altitude intervals.
+/// @param altitudes the pressure altitudes in metres.
+/// @param pressures the pressures in Pascals.
+template <typename T>
+  requires std::floating_point<T>
+void calculate_isa_pressure(std::span<const Interval<T>> altitudes,
+                            std::span<Interval<T>> pressures) {
+  Expects(altitudes.size() == pressures.size());
+
+  for (std::size_t i{}; i < altitudes.size(); ++i)
+    pressures[i] = calculate_isa_pressure(altitudes[i]);
+}
+
+/// Calculate the bounds of the ISA temperatures of altitude and temperature
+/// difference intervals.
+/// @param altitudes the pressure altitudes in metres.
+/// @param delta_temperatures the differences from ISA temperature at Sea
+/// level in Kelvin.
+/// @param temperatures the temperatures in Kelvin.
+template <typename T>
+  requires std::floating_point<T>
+void calculate_isa_temperature(std::span<const Interval<T>> altitudes,
+                               std::span<const Interval<T>> delta_temperatures,
+                               std::span<Interval<T>> temperatures) {
+  Expects(altitudes.size() == delta_temperatures.size());
+  Expects(altitudes.size() == temperatures.size());
+
+  for (std::size_t i{}; i < altitudes.size(); ++i)
+    temperatures[i] =
+        calculate_isa_temperature(altitudes[i], delta_temperatures[i]);
+}
+
+/// Calculate the bounds of the air densities of pressure and temperature
+/// intervals.
+/// @param pressures the pressures in Pascals.
+/// @param temperatures the temperatures in Kelvin.
+/// @param densities the densities in Kg per cubic metre.
+template <typename T>
+  requires std::floating_point<T>
+void calculate_density(std::span<const Interval<T>> pressures,
+                       std::span<const Interval<T>> temperatures,
+                       std::span<Interval<T>> densities) {
+  Expects(pressures.size() == temperatures.size());
+  Expects(pressures.size() == densities.size());
+
+  for (std::size_t i{}; i < pressures.size(); ++i)
+    densities[i] = calculate_density(pressures[i], temperatures[i]);
+}
+
+/// Calculate the bounds of the True Air Speeds of Calibrated Air Speed,
+/// pressure and temperature intervals.
+/// @param cas the Calibrated Air Speeds in metres per second.
+/// @param pressures the pressures in Pascals.
+/// @param temperatures the temperatures in Kelvin.
+/// @param tas the True Air Speeds in metres per second.
+template <typename T>
+  requires std::floating_point<T>
+void calculate_true_air_speed(std::span<const Interval<T>> cas,
+                              std::span<const Interval<T>> pressures,
+                              std::span<const Interval<T>> temperatures,
+                              std::span<Interval<T>> tas) {
+  Expects(cas.size() == pressures.size());
+  Expects(cas.size() == temperatures.size());
+  Expects(cas.size() == tas.size());
+
+  for (std::size_t i{}; i < cas.size(); ++i)
+    tas[i] = calculate_true_air_speed(cas[i], pressures[i], temperatures[i]);
+}
+
+/// Calculate the bounds of the Mach numbers of True Air Speed and
+/// temperature intervals.
+/// @param tas the True Air Speeds in metres per second.
+/// @param temperatures the temperatures in Kelvin.
+/// @param machs the Mach numbers.
+template <typename T>
+  requires std::floating_point<T>
+void true_air_speed_mach(std::span<const Interval<T>> tas,
+                         std::span<const Interval<T>> temperatures,
+                         std::span<Interval<T>> machs) {
+  Expects(tas.size() == temperatures.size());
+  Expects(tas.size() == machs.size());
+
+  for (std::size_t i{}; i < tas.size(); ++i)
+    machs[i] = true_air_speed_mach(tas[i], temperatures[i]);
+}
+
+} // namespace interval
+} // namespace isa
+} // namespace via
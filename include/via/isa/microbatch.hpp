@@ -0,0 +1,254 @@
+#pragma once
+
+//////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2024 Ken Barker
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//////////////////////////////////////////////////////////////////////////////
+/// @file
+/// @brief A cross-thread microbatcher of scalar ISA calculations.
+///
+/// Many threads which each calculate a few values cannot use the batch
+/// functions themselves. Instead, they submit their values to a
+/// `MicroBatcher` and receive futures. A combiner thread collects the
+/// values submitted by all of the threads and calculates them together with
+/// the batch functions when either a batch is full or the oldest value has
+/// waited for the latency budget.
+//////////////////////////////////////////////////////////////////////////////
+#include "batch.hpp"
+#include <array>
+#include <chrono>
+#include <condition_variable>
+#include <future>
+#include <mutex>
+#include <span>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace via {
+namespace isa {
+
+/// The options of a MicroBatcher.
+struct MicroBatchOptions {
+  /// The longest time that a value waits for other values to be submitted.
+  std::chrono::microseconds latency_budget{50};
+  /// The number of values of an operation that are calculated immediately.
+  std::size_t max_batch_size{1024};
+};
+
+/// The statistics of a MicroBatcher.
+struct MicroBatchStatistics {
+  /// The number of values calculated.
+  std::size_t requests{};
+  /// The number of batches calculated.
+  std::size_t batches{};
+  /// The number of batches calculated because the latency budget expired.
+  std::size_t timeouts{};
+
+  /// @return the mean number of values in a batch.
+  [[nodiscard]] constexpr auto mean_batch_size() const noexcept -> double {
+    return batches ? static_cast<double>(requests) / static_cast<double>(batches)
+                   : 0.0;
+  }
+};
+
+/// Calculates ISA pressures and True Air Speeds submitted by many threads in
+/// batches on a combiner thread.
+template <typename T>
+  requires std::floating_point<T>
+class MicroBatcher {
+  using Clock = std::chrono::steady_clock;
+
+  /// The values of an operation waiting to be calculated, with N arguments
+  /// and a Result in units.
+  template <typename Result, std::size_t N> struct Queue {
+    std::array<std::vector<T>, N> arguments;
+    std::vector<std::promise<Result>> promises;
+
+    [[nodiscard]] auto size() const noexcept -> std::size_t {
+      return promises.size();
+    }
+
+    /// Add the arguments of a value and return its future.
+    auto push(const std::array<T, N> &values) -> std::future<Result> {
+      for (std::size_t i{}; i < N; ++i)
+        arguments[i].push_back(values[i]);
+      return promises.emplace_back().get_future();
+    }
+
+    void clear() noexcept {
+      for (auto &column : arguments)
+        column.clear();
+      promises.clear();
+    }
+
+    /// Calculate the values with a batch function and set the promises.
+    template <typename Function>
+    void calculate(std::vector<T> &results, Function function) {
+      results.resize(size());
+      try {
+        [&]<std::size_t... I>(std::index_sequence<I...>) {
+          function(std::span<const T>(arguments[I])..., std::span<T>(results));
+        }(std::make_index_sequence<N>{});
+        for (std::size_t i{}; i < size(); ++i)
+          promises[i].set_value(Result(results[i]));
+      } catch (...) {
+        for (auto &promise : promises)
+          promise.set_exception(std::current_exception());
+      }
+      clear();
+    }
+  };
+
+  MicroBatchOptions options_;
+
+  std::mutex mutex_;
+  std::condition_variable condition_;
+  Queue<units::si::Pascals<T>, 1> pressures_;
+  Queue<units::si::MetresPerSecond<T>, 3> true_air_speeds_;
+  Clock::time_point oldest_;
+  MicroBatchStatistics statistics_;
+  bool stop_{false};
+
+  // Declared last, so that the combiner thread stops before the queues are
+  // destroyed.
+  std::jthread combiner_;
+
+  [[nodiscard]] auto pending() const noexcept -> std::size_t {
+    return pressures_.size() + true_air_speeds_.size();
+  }
+
+  [[nodiscard]] auto full() const noexcept -> bool {
+    return (pressures_.size() >= options_.max_batch_size) ||
+           (true_air_speeds_.size() >= options_.max_batch_size);
+  }
+
+  /// Add a value to a queue and wake the combiner if required.
+  template <typename Result, std::size_t N>
+  auto submit(Queue<Result, N> &queue, const std::array<T, N> &values)
+      -> std::future<Result> {
+    std::future<Result> future;
+    bool notify{};
+    {
+      const std::lock_guard lock{mutex_};
+      if (pending() == 0)
+        oldest_ = Clock::now();
+      future = queue.push(values);
+      notify = (pending() == 1) || full();
+    }
+    if (notify)
+      condition_.notify_one();
+    return future;
+  }
+
+  /// The combiner thread: swap the queues when a batch is full or the
+  /// latency budget has expired and calculate them outside of the lock.
+  void combine() {
+    Queue<units::si::Pascals<T>, 1> pressures;
+    Queue<units::si::MetresPerSecond<T>, 3> true_air_speeds;
+    std::vector<T> results;
+
+    std::unique_lock lock{mutex_};
+    while (true) {
+      condition_.wait(lock, [this] { return stop_ || pending(); });
+      if (!pending())
+        return;
+
+      const auto timeout{!condition_.wait_until(
+          lock, oldest_ + options_.latency_budget,
+          [this] { return stop_ || full(); })};
+
+      std::swap(pressures, pressures_);
+      std::swap(true_air_speeds, true_air_speeds_);
+      statistics_.requests += pressures.size() + true_air_speeds.size();
+      statistics_.batches += (pressures.size() > 0) +
+                             (true_air_speeds.size() > 0);
+      statistics_.timeouts += timeout;
+      lock.unlock();
+
+      if (pressures.size())
+        pressures.calculate(results, [](auto altitudes, auto values) {
+          batch::calculate_isa_pressure<T>(altitudes, values);
+        });
+      if (true_air_speeds.size())
+        true_air_speeds.calculate(
+            results, [](auto cas, auto pressures, auto temperatures,
+                        auto values) {
+              batch::calculate_true_air_speed<T>(cas, pressures, temperatures,
+                                                 values);
+            });
+
+      lock.lock();
+    }
+  }
+
+public:
+  /// Constructor, starts the combiner thread.
+  /// @pre options.max_batch_size > 0
+  /// @param options the latency budget and maximum batch size.
+  explicit MicroBatcher(const MicroBatchOptions &options = {})
+      : options_{options} {
+    Expects(options.max_batch_size > 0);
+    combiner_ = std::jthread([this] { combine(); });
+  }
+
+  /// Destructor, calculates the values already submitted and stops the
+  /// combiner thread.
+  ~MicroBatcher() {
+    {
+      const std::lock_guard lock{mutex_};
+      stop_ = true;
+    }
+    condition_.notify_one();
+  }
+
+  MicroBatcher(const MicroBatcher &) = delete;
+  MicroBatcher &operator=(const MicroBatcher &) = delete;
+
+  /// Submit an ISA pressure calculation.
+  /// @param altitude the pressure altitude in metres.
+  /// @return the future pressure in Pascals.
+  [[nodiscard]] auto calculate_isa_pressure(const units::si::Metres<T> altitude)
+      -> std::future<units::si::Pascals<T>> {
+    return submit(pressures_, {altitude.v()});
+  }
+
+  /// Submit a True Air Speed calculation.
+  /// @param cas the Calibrated Air Speed in metres per second.
+  /// @param pressure the pressure in Pascals.
+  /// @param temperature the temperature in Kelvin.
+  /// @return the future True Air Speed in metres per second.
+  [[nodiscard]] auto
+  calculate_true_air_speed(const units::si::MetresPerSecond<T> cas,
+                           const units::si::Pascals<T> pressure,
+                           const units::si::Kelvin<T> temperature)
+      -> std::future<units::si::MetresPerSecond<T>> {
+    return submit(true_air_speeds_, {cas.v(), pressure.v(), temperature.v()});
+  }
+
+  /// @return the statistics of the values calculated so far.
+  [[nodiscard]] auto statistics() -> MicroBatchStatistics {
+    const std::lock_guard lock{mutex_};
+    return statistics_;
+  }
+};
+
+} // namespace isa
+} // namespace via
@@ -0,0 +1,608 @@
+#pragma once
+
+//////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2024 Ken Barker
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//////////////////////////////////////////////////////////////////////////////
+/// @file
+/// @brief Out-of-core processing of memory mapped numpy `.npy` and `.npz`
+/// files.
+///
+/// Columns of little-endian doubles (numpy dtype `<f8`) are memory mapped
+/// and processed in chunks, so files much larger than memory can be processed
+/// by the batch functions.
+/// The chunks are processed in parallel; the pages of the following chunks
+/// are prefetched with `madvise(MADV_WILLNEED)` and the pages of processed
+/// chunks are released with `madvise(MADV_DONTNEED)`.
+///
+/// Note: memory mapping uses the POSIX API, so this file is not available on
+/// Windows.
+//////////////////////////////////////////////////////////////////////////////
+#include "parallel.hpp"
+#include <bit>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <gsl/assert>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace via {
+namespace isa {
+namespace npy {
+
+/// The default number of values in a chunk: 8 MiB of doubles.
+constexpr std::size_t DEFAULT_CHUNK_SIZE{1 << 20};
+
+/// A read-only or read-write memory mapping of a whole file.
+class MappedFile {
+  std::filesystem::path path_;
+  std::byte *data_{nullptr};
+  std::size_t size_{};
+
+  static auto error(const std::string &what,
+                    const std::filesystem::path &path) -> std::system_error {
+    return std::system_error(errno, std::generic_category(),
+                             what + " " + path.string());
+  }
+
+public:
+  MappedFile() = default;
+
+  /// Map a file.
+  /// @param path the path of the file.
+  /// @param writable whether the mapping is writable.
+  MappedFile(const std::filesystem::path &path, const bool writable)
+      : path_{path} {
+    const int fd{::open(path.c_str(), writable ? O_RDWR : O_RDONLY)};
+    if (fd < 0)
+      throw error("failed to open", path);
+
+    struct stat status {};
+    if (::fstat(fd, &status) != 0) {
+      const auto e{error("failed to stat", path)};
+      ::close(fd);
+      throw e;
+    }
+
+    size_ = static_cast<std::size_t>(status.st_size);
+    if (size_ > 0) {
+      void *address{::mmap(nullptr, size_,
+                           writable ? PROT_READ | PROT_WRITE : PROT_READ,
+                           MAP_SHARED, fd, 0)};
+      if (address == MAP_FAILED) {
+        const auto e{error("failed to map", path)};
+        ::close(fd);
+        throw e;
+      }
+      data_ = static_cast<std::byte *>(address);
+    }
+    // The mapping remains valid after the file is closed.
+    ::close(fd);
+  }
+
+  MappedFile(const MappedFile &) = delete;
+  auto operator=(const MappedFile &) -> MappedFile & = delete;
+
+  MappedFile(MappedFile &&other) noexcept
+      : path_{std::move(other.path_)},
+        data_{std::exchange(other.data_, nullptr)},
+        size_{std::exchange(other.size_, 0)} {}
+
+  auto operator=(MappedFile &&other) noexcept -> MappedFile & {
+    std::swap(path_, other.path_);
+    std::swap(data_, other.data_);
+    std::swap(size_, other.size_);
+    return *this;
+  }
+
+  ~MappedFile() {
+    if (data_)
+      ::munmap(data_, size_);
+  }
+
+  /// @return the path of the mapped file.
+  [[nodiscard]] auto path() const noexcept -> const std::filesystem::path & {
+    return path_;
+  }
+
+  /// @return the mapped bytes.
+  [[nodiscard]] auto bytes() const noexcept -> std::span<std::byte> {
+    return {data_, size_};
+  }
+
+  /// Give the kernel advice about the use of a range of the mapping.
+  /// The range is extended to whole pages.
+  /// @param offset the offset of the range in bytes.
+  /// @param length the length of the range in bytes.
+  /// @param advice the advice, e.g. `MADV_WILLNEED`.
+  void advise(const std::size_t offset, const std::size_t length,
+              const int advice) const noexcept {
+    if (!data_ || (offset >= size_))
+      return;
+
+    static const auto page_size{static_cast<std::size_t>(::sysconf(_SC_PAGESIZE))};
+    const auto begin{offset - offset % page_size};
+    const auto end{std::min(offset + length, size_)};
+    // The advice is only a hint, so any error is ignored.
+    static_cast<void>(::madvise(data_ + begin, end - begin, advice));
+  }
+};
+
+/// The header of a numpy `.npy` array.
+struct Header {
+  /// The numpy data type description, e.g. "<f8".
+  std::string descr;
+  /// Whether the array is stored in Fortran (column major) order.
+  bool fortran_order{};
+  /// The shape of the array.
+  std::vector<std::size_t> shape;
+  /// The offset of the data from the start of the `.npy` array.
+  std::size_t data_offset{};
+
+  /// @return the number of values in the array.
+  [[nodiscard]] auto size() const noexcept -> std::size_t {
+    std::size_t count{1};
+    for (const auto length : shape)
+      count *= length;
+    return count;
+  }
+};
+
+namespace detail {
+/// The magic string at the start of a `.npy` array.
+constexpr std::string_view MAGIC{"\x93NUMPY", 6};
+
+/// @return the value of a key in a numpy header dictionary.
+inline auto header_value(const std::string_view dict, const std::string_view key)
+    -> std::string_view {
+  const auto quoted_key{"'" + std::string(key) + "'"};
+  auto pos{dict.find(quoted_key)};
+  if (pos == std::string_view::npos)
+    throw std::runtime_error("npy header has no " + quoted_key);
+  pos = dict.find(':', pos + quoted_key.size());
+  if (pos == std::string_view::npos)
+    throw std::runtime_error("invalid npy header");
+  pos = dict.find_first_not_of(' ', pos + 1);
+  if (pos == std::string_view::npos)
+    throw std::runtime_error("invalid npy header");
+  const bool is_tuple{dict[pos] == '('};
+  auto end{is_tuple ? dict.find(')', pos) : dict.find_first_of(",}", pos)};
+  if (end == std::string_view::npos)
+    throw std::runtime_error("invalid npy header");
+  if (is_tuple)
+    ++end;
+  return dict.substr(pos, end - pos);
+}
+
+/// @return a little-endian unsigned integer read from bytes.
+template <typename Int>
+auto read_le(std::span<const std::byte> bytes, const std::size_t offset)
+    -> Int {
+  if (offset + sizeof(Int) > bytes.size())
+    throw std::runtime_error("unexpected end of file");
+  Int value{};
+  for (std::size_t i{sizeof(Int)}; i-- > 0;)
+    value = static_cast<Int>((value << 8) |
+                             std::to_integer<Int>(bytes[offset + i]));
+  return value;
+}
+} // namespace detail
+
+/// Parse the header of a numpy `.npy` array.
+/// @param bytes the bytes of the array.
+/// @return the header.
+inline auto parse_header(std::span<const std::byte> bytes) -> Header {
+  if ((bytes.size() < 10) ||
+      std::memcmp(bytes.data(), detail::MAGIC.data(), detail::MAGIC.size()))
+    throw std::runtime_error("not a npy array");
+
+  const auto major_version{std::to_integer<int>(bytes[6])};
+  std::size_t header_length{};
+  std::size_t dict_offset{};
+  if (major_version == 1) {
+    header_length = detail::read_le<std::uint16_t>(bytes, 8);
+    dict_offset = 10;
+  } else {
+    header_length = detail::read_le<std::uint32_t>(bytes, 8);
+    dict_offset = 12;
+  }
+  if (dict_offset + header_length > bytes.size())
+    throw std::runtime_error("truncated npy header");
+
+  const std::string_view dict{
+      reinterpret_cast<const char *>(bytes.data() + dict_offset),
+      header_length};
+
+  Header header;
+  auto descr{detail::header_value(dict, "descr")};
+  header.descr = std::string(descr.substr(1, descr.size() - 2));
+  header.fortran_order = detail::header_value(dict, "fortran_order") == "True";
+  auto shape{detail::header_value(dict, "shape")};
+  shape = shape.substr(1, shape.size() - 2);
+  while (!shape.empty()) {
+    std::size_t length{};
+    std::size_t pos{};
+    while ((pos < shape.size()) && (shape[pos] == ' '))
+      ++pos;
+    for (; (pos < shape.size()) && ('0' <= shape[pos]) && (shape[pos] <= '9');
+         ++pos)
+      length = 10 * length + static_cast<std::size_t>(shape[pos] - '0');
+    if (pos < shape.size() && shape[pos] != ',')
+      throw std::runtime_error("invalid npy shape");
+    header.shape.push_back(length);
+    shape.remove_prefix(std::min(pos + 1, shape.size()));
+    if (shape.find_first_not_of(' ') == std::string_view::npos)
+      break;
+  }
+  header.data_offset = dict_offset + header_length;
+  return header;
+}
+
+/// Create the header of a numpy `.npy` array of little-endian doubles.
+/// The header is padded so that the data is aligned to 64 bytes.
+/// @param shape the shape of the array.
+/// @return the header bytes.
+inline auto make_header(std::span<const std::size_t> shape) -> std::string {
+  std::string dict{"{'descr': '<f8', 'fortran_order': False, 'shape': ("};
+  for (std::size_t i{}; i < shape.size(); ++i)
+    dict += (i ? ", " : "") + std::to_string(shape[i]);
+  // A tuple of one value requires a trailing comma.
+  dict += (shape.size() == 1) ? ",), }" : "), }";
+
+  constexpr std::size_t PREFIX_LENGTH{10};
+  constexpr std::size_t ALIGNMENT{64};
+  const auto padding{ALIGNMENT -
+                     (PREFIX_LENGTH + dict.size() + 1) % ALIGNMENT};
+  dict.append(padding % ALIGNMENT, ' ');
+  dict += '\n';
+
+  std::string header{detail::MAGIC};
+  header += '\x01';
+  header += '\x00';
+  header += static_cast<char>(dict.size() & 0xff);
+  header += static_cast<char>(dict.size() >> 8);
+  return header + dict;
+}
+
+/// A column of doubles in a memory mapped `.npy` array.
+/// It may be a member of an `.npz` archive, in which case its data may not
+/// be aligned for doubles.
+class Column {
+  MappedFile file_;
+  std::size_t data_offset_{};
+  Header header_;
+
+  /// @return whether the column data is aligned for doubles.
+  [[nodiscard]] auto aligned() const noexcept -> bool {
+    return reinterpret_cast<std::uintptr_t>(file_.bytes().data() +
+                                            data_offset_) %
+               alignof(double) ==
+           0;
+  }
+
+public:
+  /// Construct a column from an `.npy` array within a mapped file.
+  /// @param file the mapped file.
+  /// @param offset the offset of the `.npy` array within the file.
+  Column(MappedFile &&file, const std::size_t offset)
+      : file_{std::move(file)} {
+    header_ = parse_header(file_.bytes().subspan(offset));
+    if ((header_.descr != "<f8") || (std::endian::native != std::endian::little))
+      throw std::runtime_error("npy array is not little-endian float64: " +
+                               header_.descr);
+    if (header_.fortran_order && (header_.shape.size() > 1))
+      throw std::runtime_error("npy array is in Fortran order");
+
+    data_offset_ = offset + header_.data_offset;
+    if (data_offset_ + header_.size() * sizeof(double) > file_.bytes().size())
+      throw std::runtime_error("truncated npy array");
+  }
+
+  /// @return the header of the column.
+  [[nodiscard]] auto header() const noexcept -> const Header & {
+    return header_;
+  }
+
+  /// @return the number of values in the column.
+  [[nodiscard]] auto size() const noexcept -> std::size_t {
+    return header_.size();
+  }
+
+  /// @return the path of the `.npy` file or `.npz` archive of the column.
+  [[nodiscard]] auto path() const noexcept -> const std::filesystem::path & {
+    return file_.path();
+  }
+
+  /// Get a chunk of the column.
+  /// If the column data is not aligned, the chunk is copied into `scratch`.
+  /// @param begin the index of the first value.
+  /// @param count the number of values.
+  /// @param scratch a buffer for unaligned data.
+  /// @return the values.
+  [[nodiscard]] auto chunk(const std::size_t begin, const std::size_t count,
+                           std::vector<double> &scratch) const
+      -> std::span<const double> {
+    Expects(begin + count <= size());
+
+    const auto bytes{file_.bytes().subspan(data_offset_ + begin * sizeof(double),
+                                           count * sizeof(double))};
+    if (aligned())
+      return {reinterpret_cast<const double *>(bytes.data()), count};
+
+    scratch.resize(count);
+    std::memcpy(scratch.data(), bytes.data(), bytes.size());
+    return scratch;
+  }
+
+  /// Get a writable chunk of the column.
+  /// @pre the column was created by `create_column`.
+  /// @param begin the index of the first value.
+  /// @param count the number of values.
+  /// @return the values.
+  [[nodiscard]] auto mutable_chunk(const std::size_t begin,
+                                   const std::size_t count) const
+      -> std::span<double> {
+    Expects(aligned());
+    Expects(begin + count <= size());
+
+    return {reinterpret_cast<double *>(file_.bytes().data() + data_offset_) +
+                begin,
+            count};
+  }
+
+  /// Give the kernel advice about the use of a chunk of the column.
+  /// @param begin the index of the first value.
+  /// @param count the number of values.
+  /// @param advice the advice, e.g. `MADV_WILLNEED`.
+  void advise(const std::size_t begin, const std::size_t count,
+              const int advice) const noexcept {
+    file_.advise(data_offset_ + begin * sizeof(double), count * sizeof(double),
+                 advice);
+  }
+};
+
+/// Open a `.npy` file of little-endian doubles as a read-only column.
+/// @param path the path of the `.npy` file.
+/// @return the column.
+inline auto open_column(const std::filesystem::path &path) -> Column {
+  Column column{MappedFile(path, false), 0};
+  column.advise(0, column.size(), MADV_SEQUENTIAL);
+  return column;
+}
+
+/// Open a member of a `.npz` archive as a read-only column.
+/// The member must be stored uncompressed, as by `numpy.savez`.
+/// @param path the path of the `.npz` file.
+/// @param member the name of the array in the archive, without ".npy".
+/// @return the column.
+inline auto open_npz_column(const std::filesystem::path &path,
+                            const std::string_view member) -> Column {
+  MappedFile file{path, false};
+  const std::span<const std::byte> bytes{file.bytes()};
+  using detail::read_le;
+
+  // Find the end of central directory record.
+  constexpr std::uint32_t EOCD_SIGNATURE{0x0605'4b50};
+  constexpr std::size_t EOCD_SIZE{22};
+  if (bytes.size() < EOCD_SIZE)
+    throw std::runtime_error("not a npz archive: " + path.string());
+  auto eocd{bytes.size() - EOCD_SIZE};
+  while (read_le<std::uint32_t>(bytes, eocd) != EOCD_SIGNATURE) {
+    if ((eocd == 0) || (bytes.size() - eocd > EOCD_SIZE + 0xffff))
+      throw std::runtime_error("not a npz archive: " + path.string());
+    --eocd;
+  }
+  std::uint64_t entries{read_le<std::uint16_t>(bytes, eocd + 10)};
+  std::uint64_t directory{read_le<std::uint32_t>(bytes, eocd + 16)};
+
+  // Archives larger than 4 GiB have a zip64 end of central directory record.
+  constexpr std::uint32_t ZIP64_LOCATOR_SIGNATURE{0x0706'4b50};
+  if ((eocd >= 20) &&
+      (read_le<std::uint32_t>(bytes, eocd - 20) == ZIP64_LOCATOR_SIGNATURE)) {
+    const auto zip64_eocd{read_le<std::uint64_t>(bytes, eocd - 12)};
+    entries = read_le<std::uint64_t>(bytes, zip64_eocd + 32);
+    directory = read_le<std::uint64_t>(bytes, zip64_eocd + 48);
+  }
+
+  const auto name{std::string(member) + ".npy"};
+  constexpr std::uint32_t ENTRY_SIGNATURE{0x0201'4b50};
+  auto entry{static_cast<std::size_t>(directory)};
+  for (std::uint64_t i{}; i < entries; ++i) {
+    if (read_le<std::uint32_t>(bytes, entry) != ENTRY_SIGNATURE)
+      throw std::runtime_error("invalid npz central directory");
+
+    const auto method{read_le<std::uint16_t>(bytes, entry + 10)};
+    std::uint64_t compressed_size{read_le<std::uint32_t>(bytes, entry + 20)};
+    std::uint64_t size{read_le<std::uint32_t>(bytes, entry + 24)};
+    const std::size_t name_length{read_le<std::uint16_t>(bytes, entry + 28)};
+    const std::size_t extra_length{read_le<std::uint16_t>(bytes, entry + 30)};
+    const std::size_t comment_length{read_le<std::uint16_t>(bytes, entry + 32)};
+    std::uint64_t local_header{read_le<std::uint32_t>(bytes, entry + 42)};
+
+    const std::string_view entry_name{
+        reinterpret_cast<const char *>(bytes.data() + entry + 46), name_length};
+    if (entry_name == name) {
+      // Read any zip64 sizes and offset from the extra field.
+      constexpr std::uint32_t ZIP64_MAX{0xffff'ffff};
+      constexpr std::uint16_t ZIP64_EXTRA{0x0001};
+      auto extra{entry + 46 + name_length};
+      const auto extra_end{extra + extra_length};
+      while (extra + 4 <= extra_end) {
+        const auto id{read_le<std::uint16_t>(bytes, extra)};
+        const std::size_t length{read_le<std::uint16_t>(bytes, extra + 2)};
+        if (id == ZIP64_EXTRA) {
+          auto field{extra + 4};
+          for (auto *value : {&size, &compressed_size, &local_header}) {
+            if (*value == ZIP64_MAX) {
+              *value = read_le<std::uint64_t>(bytes, field);
+              field += 8;
+            }
+          }
+        }
+        extra += 4 + length;
+      }
+
+      if (method != 0)
+        throw std::runtime_error("npz member is compressed: " + name);
+
+      const auto local{static_cast<std::size_t>(local_header)};
+      const std::size_t data{local + 30 +
+                             read_le<std::uint16_t>(bytes, local + 26) +
+                             read_le<std::uint16_t>(bytes, local + 28)};
+      Column column{std::move(file), data};
+      column.advise(0, column.size(), MADV_SEQUENTIAL);
+      return column;
+    }
+    entry += 46 + name_length + extra_length + comment_length;
+  }
+
+  throw std::runtime_error("npz archive has no member: " + name);
+}
+
+/// Create a `.npy` file of little-endian doubles as a writable column.
+/// An existing file is overwritten.
+/// @param path the path of the `.npy` file.
+/// @param shape the shape of the array.
+/// @return the column.
+inline auto create_column(const std::filesystem::path &path,
+                          std::span<const std::size_t> shape) -> Column {
+  const auto header{make_header(shape)};
+  std::size_t count{1};
+  for (const auto length : shape)
+    count *= length;
+
+  const int fd{::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644)};
+  if (fd < 0)
+    throw std::system_error(errno, std::generic_category(),
+                            "failed to create " + path.string());
+  const auto size{static_cast<off_t>(header.size() + count * sizeof(double))};
+  const bool ok{(::ftruncate(fd, size) == 0) &&
+                (::pwrite(fd, header.data(), header.size(), 0) ==
+                 static_cast<ssize_t>(header.size()))};
+  const auto error{errno};
+  ::close(fd);
+  if (!ok)
+    throw std::system_error(error, std::generic_category(),
+                            "failed to write " + path.string());
+
+  return Column{MappedFile(path, true), 0};
+}
+
+/// The options for processing columns in chunks.
+struct ChunkOptions {
+  /// The number of values in a chunk.
+  std::size_t chunk_size{DEFAULT_CHUNK_SIZE};
+  /// The number of threads, zero for the hardware concurrency.
+  std::size_t threads{0};
+};
+
+/// Process memory mapped columns in chunks.
+/// The kernel is called for each chunk with spans of the input chunks and a
+/// span of the output chunk, all of the same size.
+/// While a thread processes a chunk, the chunk that it is likely to process
+/// next is prefetched.
+/// @pre all the inputs are the same size as the output.
+/// @param inputs the input columns.
+/// @param output the output column, created by `create_column`.
+/// @param kernel the function to call for each chunk: a
+/// `void(std::span<const std::span<const double>>, std::span<double>)`.
+/// @param options the chunk options.
+template <typename Kernel>
+void process_chunks(std::span<const Column> inputs, const Column &output,
+                    Kernel &&kernel, const ChunkOptions options = {}) {
+  Expects(options.chunk_size > 0);
+  const auto size{output.size()};
+  for (const auto &input : inputs)
+    if (input.size() != size)
+      throw std::invalid_argument("npy columns are not the same size");
+
+  const auto chunks{(size + options.chunk_size - 1) / options.chunk_size};
+  const auto threads{thread_count(options.threads, chunks)};
+  const auto chunk_range{[&](const std::size_t chunk) {
+    const auto begin{chunk * options.chunk_size};
+    return std::pair{begin, std::min(options.chunk_size, size - begin)};
+  }};
+
+  parallel_for(
+      chunks,
+      [&](const std::size_t chunk) {
+        std::vector<std::vector<double>> scratch(inputs.size());
+        std::vector<std::span<const double>> spans(inputs.size());
+
+        // Prefetch the chunk that this thread is likely to process next.
+        if (const auto next{chunk + threads}; next < chunks) {
+          const auto [next_begin, next_count]{chunk_range(next)};
+          for (const auto &input : inputs)
+            input.advise(next_begin, next_count, MADV_WILLNEED);
+        }
+
+        const auto [begin, count]{chunk_range(chunk)};
+        for (std::size_t i{}; i < inputs.size(); ++i)
+          spans[i] = inputs[i].chunk(begin, count, scratch[i]);
+        kernel(std::span<const std::span<const double>>(spans),
+               output.mutable_chunk(begin, count));
+
+        // Release the pages of the processed chunk.
+        for (const auto &input : inputs)
+          input.advise(begin, count, MADV_DONTNEED);
+        output.advise(begin, count, MADV_DONTNEED);
+      },
+      threads);
+}
+
+/// Process `.npy` (or `.npz` member) columns in chunks into a new `.npy`
+/// file with the shape of the first input.
+/// The output file must not be an input file: it is truncated while the
+/// inputs are mapped.
+/// @param inputs the input columns.
+/// @param output_path the path of the output `.npy` file.
+/// @param kernel the function to call for each chunk, see `process_chunks`.
+/// @param options the chunk options.
+template <typename Kernel>
+void process_npy(std::span<const Column> inputs,
+                 const std::filesystem::path &output_path, Kernel &&kernel,
+                 const ChunkOptions options = {}) {
+  Expects(!inputs.empty());
+  for (const auto &input : inputs) {
+    std::error_code error;
+    if (std::filesystem::equivalent(output_path, input.path(), error))
+      throw std::invalid_argument("npy output is an input: " +
+                                  output_path.string());
+  }
+
+  const auto output{create_column(output_path, inputs.front().header().shape)};
+  process_chunks(inputs, output, std::forward<Kernel>(kernel), options);
+}
+
+} // namespace npy
+} // namespace isa
+} // namespace via
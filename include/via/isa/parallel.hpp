@@ -0,0 +1,333 @@
+#pragma once
+
+//////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2024 Ken Barker
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//////////////////////////////////////////////////////////////////////////////
+/// @file
+/// @brief Functions to run the batch functions in parallel.
+///
+/// `parallel_for` shares indices of equal cost between threads.
+/// `work_stealing_for` and `parallel_for_trajectories` balance ranges of very
+/// different sizes, e.g. trajectories of 10 to 100,000 samples: each thread
+/// splits its range in half, keeping one half and pushing the other onto its
+/// own deque, from which idle threads steal the largest ranges.
+///
+/// The reductions, contrail flags, plans and npy columns in this library
+/// divide their work into blocks of equal cost, which `parallel_for` already
+/// balances with a single shared counter, so they do not use work stealing.
+/// `parallel_for_trajectories` is for callers whose work is per trajectory,
+/// e.g. processing `FlightProfiles` of very different lengths.
+//////////////////////////////////////////////////////////////////////////////
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <exception>
+#include <gsl/assert>
+#include <mutex>
+#include <span>
+#include <thread>
+#include <vector>
+
+namespace via {
+namespace isa {
+
+/// The number of threads to use for the given requested number of threads.
+/// @param threads the requested number of threads, zero for the hardware
+/// concurrency.
+/// @param tasks the number of tasks to run.
+/// @return the number of threads to use, at least one and at most `tasks`.
+[[nodiscard]] inline auto thread_count(const std::size_t threads,
+                                       const std::size_t tasks) noexcept
+    -> std::size_t {
+  const std::size_t requested{
+      threads ? threads
+              : std::max<std::size_t>(std::thread::hardware_concurrency(), 1)};
+  return std::max<std::size_t>(std::min(requested, tasks), 1);
+}
+
+/// Call `function(index)` for every index in [0, count) on up to `threads`
+/// threads, including the calling thread.
+/// The threads take the next index from a shared counter, so the order in
+/// which the indices are processed is not defined.
+/// If a call throws an exception, no further indices are started and the
+/// first exception is rethrown in the calling thread.
+/// @param count the number of indices.
+/// @param function the function to call for each index.
+/// @param threads the number of threads, zero for the hardware concurrency.
+template <typename Function>
+void parallel_for(const std::size_t count, Function &&function,
+                  const std::size_t threads = 0) {
+  const auto workers{thread_count(threads, count)};
+  if (workers == 1) {
+    for (std::size_t i{}; i < count; ++i)
+      function(i);
+    return;
+  }
+
+  std::atomic<std::size_t> next{0};
+  std::exception_ptr exception;
+  std::mutex exception_mutex;
+  const auto work{[&]() {
+    for (auto i{next.fetch_add(1, std::memory_order_relaxed)}; i < count;
+         i = next.fetch_add(1, std::memory_order_relaxed)) {
+      try {
+        function(i);
+      } catch (...) {
+        const std::lock_guard lock{exception_mutex};
+        if (!exception)
+          exception = std::current_exception();
+        next.store(count, std::memory_order_relaxed);
+      }
+    }
+  }};
+
+  {
+    std::vector<std::jthread> pool;
+    pool.reserve(workers - 1);
+    for (std::size_t t{1}; t < workers; ++t)
+      pool.emplace_back(work);
+    work();
+  }
+
+  if (exception)
+    std::rethrow_exception(exception);
+}
+
+/// A half open range of indices: [begin, end).
+struct IndexRange {
+  std::size_t begin;
+  std::size_t end;
+
+  /// @return the number of indices in the range.
+  [[nodiscard]] constexpr auto size() const noexcept -> std::size_t {
+    return end - begin;
+  }
+};
+
+namespace detail {
+/// A bounded lock-free work stealing deque of ranges.
+/// The owner thread pushes and takes ranges at the bottom and other threads
+/// steal ranges from the top, see: Chase and Lev, "Dynamic Circular
+/// Work-Stealing Deque", 2005 and Lê et al., "Correct and Efficient
+/// Work-Stealing for Weak Memory Models", 2013.
+/// The deque does not grow: ranges are split in half, so it only holds about
+/// log2(size) ranges and the owner processes a range itself when it is full.
+class WorkStealingDeque {
+public:
+  /// The maximum number of ranges in the deque.
+  static constexpr std::size_t CAPACITY{64};
+
+private:
+  /// A slot of the circular buffer, stored in atomics because a thief may
+  /// read a slot while the owner writes another one.
+  struct Slot {
+    std::atomic<std::size_t> begin;
+    std::atomic<std::size_t> end;
+  };
+
+  alignas(64) std::atomic<std::int64_t> top_{0};
+  alignas(64) std::atomic<std::int64_t> bottom_{0};
+  std::array<Slot, CAPACITY> buffer_{};
+
+  [[nodiscard]] auto load(const std::int64_t index) const noexcept
+      -> IndexRange {
+    const auto &slot{buffer_[static_cast<std::size_t>(index) % CAPACITY]};
+    return {slot.begin.load(std::memory_order_relaxed),
+            slot.end.load(std::memory_order_relaxed)};
+  }
+
+public:
+  /// Push a range onto the bottom of the deque, owner thread only.
+  /// @return false if the deque is full.
+  auto push(const IndexRange range) noexcept -> bool {
+    const auto b{bottom_.load(std::memory_order_relaxed)};
+    const auto t{top_.load(std::memory_order_acquire)};
+    if (b - t >= static_cast<std::int64_t>(CAPACITY))
+      return false;
+
+    auto &slot{buffer_[static_cast<std::size_t>(b) % CAPACITY]};
+    slot.begin.store(range.begin, std::memory_order_relaxed);
+    slot.end.store(range.end, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    bottom_.store(b + 1, std::memory_order_relaxed);
+    return true;
+  }
+
+  /// Take the most recently pushed range from the bottom of the deque,
+  /// owner thread only.
+  /// @return true and the range, or false if the deque is empty.
+  auto take(IndexRange &range) noexcept -> bool {
+    const auto b{bottom_.load(std::memory_order_relaxed) - 1};
+    bottom_.store(b, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    auto t{top_.load(std::memory_order_relaxed)};
+    if (t > b) {
+      bottom_.store(b + 1, std::memory_order_relaxed);
+      return false;
+    }
+
+    range = load(b);
+    if (t < b)
+      return true;
+
+    // The last range, race the thieves for it
+    const auto taken{top_.compare_exchange_strong(
+        t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed)};
+    bottom_.store(b + 1, std::memory_order_relaxed);
+    return taken;
+  }
+
+  /// Steal the oldest, i.e. largest, range from the top of the deque.
+  /// @return true and the range, or false if the deque is empty or another
+  /// thread took the range.
+  auto steal(IndexRange &range) noexcept -> bool {
+    auto t{top_.load(std::memory_order_acquire)};
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    const auto b{bottom_.load(std::memory_order_acquire)};
+    if (t >= b)
+      return false;
+
+    range = load(t);
+    return top_.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst,
+                                        std::memory_order_relaxed);
+  }
+};
+} // namespace detail
+
+/// Call `function(begin, end)` for sub-ranges of the indices [0, count)
+/// of at most `grain` indices on up to `threads` threads, including the
+/// calling thread.
+/// The range is divided equally between the threads, which split their
+/// ranges in half until they are no larger than `grain`, pushing the other
+/// halves onto their own lock-free deques. A thread that runs out of work
+/// steals the largest range from another thread's deque, so threads are
+/// kept busy when the cost of the indices varies widely.
+/// If a call throws an exception, no further ranges are started and the
+/// first exception is rethrown in the calling thread.
+/// @pre grain > 0
+/// @param count the number of indices.
+/// @param function the function to call for each sub-range.
+/// @param grain the maximum number of indices of a sub-range.
+/// @param threads the number of threads, zero for the hardware concurrency.
+template <typename Function>
+void work_stealing_for(const std::size_t count, Function &&function,
+                       const std::size_t grain,
+                       const std::size_t threads = 0) {
+  Expects(grain > 0);
+
+  const auto workers{thread_count(threads, (count + grain - 1) / grain)};
+  if (workers == 1) {
+    for (std::size_t begin{}; begin < count; begin += grain)
+      function(begin, std::min(begin + grain, count));
+    return;
+  }
+
+  std::vector<detail::WorkStealingDeque> deques(workers);
+  for (std::size_t w{}; w < workers; ++w)
+    deques[w].push({count * w / workers, count * (w + 1) / workers});
+
+  // The number of indices not yet processed
+  std::atomic<std::size_t> remaining{count};
+  std::atomic<bool> stop{false};
+  std::exception_ptr exception;
+  std::mutex exception_mutex;
+  const auto work{[&](const std::size_t w) {
+    auto &deque{deques[w]};
+    IndexRange range{};
+    while (!stop.load(std::memory_order_relaxed) &&
+           remaining.load(std::memory_order_acquire)) {
+      auto found{deque.take(range)};
+      for (std::size_t i{1}; !found && (i < workers); ++i)
+        found = deques[(w + i) % workers].steal(range);
+      if (!found) {
+        std::this_thread::yield();
+        continue;
+      }
+
+      // Split the range, leaving the other halves for thieves
+      while ((range.size() > grain) &&
+             deque.push({range.begin + range.size() / 2, range.end}))
+        range.end = range.begin + range.size() / 2;
+
+      try {
+        function(range.begin, range.end);
+      } catch (...) {
+        const std::lock_guard lock{exception_mutex};
+        if (!exception)
+          exception = std::current_exception();
+        stop.store(true, std::memory_order_relaxed);
+      }
+      remaining.fetch_sub(range.size(), std::memory_order_release);
+    }
+  }};
+
+  {
+    std::vector<std::jthread> pool;
+    pool.reserve(workers - 1);
+    for (std::size_t t{1}; t < workers; ++t)
+      pool.emplace_back(work, t);
+    work(0);
+  }
+
+  if (exception)
+    std::rethrow_exception(exception);
+}
+
+/// Call `function(trajectory, begin, end)` for sub-ranges of the samples
+/// of trajectories stored in columns, on up to `threads` threads.
+/// The samples of trajectory `i` are in the range [offsets[i],
+/// offsets[i + 1]), as in `FlightProfiles`.
+/// The samples are scheduled by `work_stealing_for`, so long trajectories
+/// are split into sub-ranges which may be processed by different threads
+/// and short trajectories are processed together.
+/// @pre offsets are increasing and grain > 0
+/// @param offsets the start index of each trajectory, plus the total size.
+/// @param function the function to call for each sub-range of a trajectory.
+/// @param grain the maximum number of samples processed together.
+/// @param threads the number of threads, zero for the hardware concurrency.
+template <typename Function>
+void parallel_for_trajectories(std::span<const std::size_t> offsets,
+                               Function &&function, const std::size_t grain,
+                               const std::size_t threads = 0) {
+  if (offsets.size() < 2)
+    return;
+
+  const auto first{offsets.front()};
+  work_stealing_for(
+      offsets.back() - first,
+      [&](const std::size_t begin, const std::size_t end) {
+        // The trajectory containing the first sample of the range
+        auto i{static_cast<std::size_t>(
+            std::upper_bound(offsets.begin(), offsets.end(), first + begin) -
+            offsets.begin() - 1)};
+        for (auto sample{first + begin}; sample < first + end; ++i) {
+          const auto stop{std::min(offsets[i + 1], first + end)};
+          if (sample < stop)
+            function(i, sample, stop);
+          sample = stop;
+        }
+      },
+      grain, threads);
+}
+
+} // namespace isa
+} // namespace via
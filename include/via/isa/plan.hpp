@@ -0,0 +1,675 @@
+#pragma once
+
+//////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2024 Ken Barker
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//////////////////////////////////////////////////////////////////////////////
+/// @file
+/// @brief Computation plans of the via::isa functions, composed at runtime.
+///
+/// The expressions in expression.hpp are composed at compile time, so they
+/// are not available to languages such as Python. A Plan is a graph of the
+/// batch functions over named input columns, built at runtime, e.g.:
+///
+///     Plan<double> plan;
+///     plan.pressure("alt").density().true_air_speed("cas");
+///
+/// produces the outputs "pressure", "density" and "tas" from the input
+/// columns "alt" and "cas", where the ISA temperature used by `density` and
+/// `true_air_speed` is calculated from "alt" once.
+///
+/// A Plan is compiled once into a Program, which evaluates the graph in
+/// cache sized blocks of values on multiple threads. The intermediate values
+/// of a block are stored in scratch memory which is reused by each thread
+/// for every block, and intermediate values that are no longer required
+/// share scratch memory with later ones.
+//////////////////////////////////////////////////////////////////////////////
+#include "batch.hpp"
+#include "parallel.hpp"
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace via {
+namespace isa {
+namespace plan {
+
+/// The default number of values in a block.
+constexpr std::size_t DEFAULT_BLOCK_SIZE{1024};
+
+/// The operations of a Plan, the batch functions of the same names.
+enum class Operation : std::uint8_t {
+  INPUT,
+  PRESSURE,
+  ALTITUDE,
+  TEMPERATURE,
+  DENSITY,
+  TRUE_AIR_SPEED,
+  CALIBRATED_AIR_SPEED,
+  SPEED_OF_SOUND,
+  MACH_TRUE_AIR_SPEED,
+  CROSSOVER_ALTITUDE
+};
+
+/// The maximum number of arguments of an Operation.
+constexpr std::size_t MAX_ARGUMENTS{3};
+
+/// A node of a Plan: an input column or an operation on other nodes.
+struct Node {
+  Operation operation;
+  /// The number of arguments.
+  std::size_t arity;
+  /// The indices of the argument nodes, which precede this node.
+  std::array<std::size_t, MAX_ARGUMENTS> arguments;
+};
+
+/// A compiled Plan.
+template <typename T>
+  requires std::floating_point<T>
+class Program;
+
+/// A graph of via::isa batch functions over named input columns.
+/// Identical nodes are only added once, so common sub-expressions are only
+/// calculated once.
+///
+/// The builder functions, e.g. `pressure`, add an operation and an output to
+/// the Plan. Their arguments are the names of input columns; an empty name
+/// uses the value most recently calculated by the Plan, e.g. `density()`
+/// after `pressure("alt")` uses the pressure of "alt" and the ISA temperature
+/// of "alt". If a builder function throws, e.g. for a duplicate output name,
+/// the Plan is unchanged.
+template <typename T>
+  requires std::floating_point<T>
+class Plan {
+  std::vector<Node> nodes_;
+  std::vector<std::string> inputs_;
+  std::vector<std::size_t> input_nodes_;
+  std::vector<std::string> outputs_;
+  std::vector<std::size_t> output_nodes_;
+
+  std::optional<std::size_t> altitude_;
+  std::optional<std::size_t> pressure_;
+  std::optional<std::size_t> temperature_;
+  std::optional<std::size_t> tas_;
+
+  /// Set the current altitude node, resetting the nodes calculated from a
+  /// different altitude.
+  void set_altitude(const std::size_t node) {
+    if (altitude_ != node) {
+      pressure_.reset();
+      temperature_.reset();
+      tas_.reset();
+    }
+    altitude_ = node;
+  }
+
+  /// Set the current pressure node, resetting the nodes calculated from a
+  /// different pressure.
+  void set_pressure(const std::size_t node) {
+    if (pressure_ != node) {
+      altitude_.reset();
+      temperature_.reset();
+      tas_.reset();
+    }
+    pressure_ = node;
+  }
+
+  /// Set the current altitude node to the named input column or, if the name
+  /// is empty: the current altitude, the altitude of the current pressure or
+  /// the "altitude" input column.
+  void resolve_altitude(std::string_view name) {
+    if (!name.empty())
+      set_altitude(input(name));
+    else if (!altitude_)
+      altitude_ = pressure_ ? add(Operation::ALTITUDE, {*pressure_})
+                            : input("altitude");
+  }
+
+  /// Set the current pressure node to the named input column or, if the name
+  /// is empty: the current pressure, the pressure of the current altitude or
+  /// the "pressure" input column.
+  void resolve_pressure(std::string_view name) {
+    if (!name.empty())
+      set_pressure(input(name));
+    else if (!pressure_)
+      pressure_ = altitude_ ? add(Operation::PRESSURE, {*altitude_})
+                            : input("pressure");
+  }
+
+  /// Set the current temperature node to the named input column or, if the
+  /// name is empty: the current temperature, the ISA temperature of the
+  /// current altitude or the "temperature" input column.
+  void resolve_temperature(std::string_view name) {
+    if (!name.empty())
+      temperature_ = input(name);
+    else if (!temperature_)
+      temperature_ = altitude_ ? add(Operation::TEMPERATURE, {*altitude_})
+                               : input("temperature");
+  }
+
+  /// Check the name of an input column, so that a builder function throws
+  /// before it changes the Plan.
+  /// @param name the name of the input column.
+  static void check_input(std::string_view name) {
+    if (name.empty())
+      throw std::invalid_argument("plan input name is empty");
+  }
+
+  /// Check that an output column can be added to the Plan, so that a builder
+  /// function throws before it changes the Plan.
+  /// @param name the name of the output column.
+  void check_output(std::string_view name) const {
+    if (name.empty())
+      throw std::invalid_argument("plan output name is empty");
+    if (std::ranges::find(outputs_, name) != outputs_.end())
+      throw std::invalid_argument("duplicate plan output: " +
+                                  std::string(name));
+  }
+
+public:
+  /// The number of arguments of an operation.
+  /// @return the minimum and maximum number of arguments.
+  [[nodiscard]] static constexpr auto arity(const Operation operation) noexcept
+      -> std::pair<std::size_t, std::size_t> {
+    switch (operation) {
+    case Operation::INPUT:
+      return {0, 0};
+    case Operation::TEMPERATURE:
+      return {1, 2};
+    case Operation::DENSITY:
+    case Operation::MACH_TRUE_AIR_SPEED:
+    case Operation::CROSSOVER_ALTITUDE:
+      return {2, 2};
+    case Operation::TRUE_AIR_SPEED:
+    case Operation::CALIBRATED_AIR_SPEED:
+      return {3, 3};
+    default:
+      return {1, 1};
+    }
+  }
+
+  /// Add an input column to the Plan, unless it has already been added.
+  /// @param name the name of the input column.
+  /// @return the index of the input node.
+  auto input(std::string_view name) -> std::size_t {
+    check_input(name);
+    const auto pos{std::ranges::find(inputs_, name)};
+    if (pos != inputs_.end())
+      return input_nodes_[static_cast<std::size_t>(pos - inputs_.begin())];
+
+    inputs_.emplace_back(name);
+    input_nodes_.push_back(nodes_.size());
+    nodes_.push_back({Operation::INPUT, 0, {}});
+    return nodes_.size() - 1;
+  }
+
+  /// Add an operation to the Plan, unless it has already been added.
+  /// @pre the number of arguments is valid for the operation and they are
+  /// the indices of existing nodes.
+  /// @param operation the operation, not INPUT.
+  /// @param arguments the indices of the argument nodes.
+  /// @return the index of the operation node.
+  auto add(const Operation operation,
+           std::initializer_list<std::size_t> arguments) -> std::size_t {
+    const auto [min_arity, max_arity]{arity(operation)};
+    Expects(operation != Operation::INPUT);
+    Expects((min_arity <= arguments.size()) && (arguments.size() <= max_arity));
+    Expects(std::ranges::all_of(
+        arguments, [this](const auto a) { return a < nodes_.size(); }));
+
+    Node node{operation, arguments.size(), {}};
+    std::ranges::copy(arguments, node.arguments.begin());
+    const auto pos{std::ranges::find_if(nodes_, [&node](const Node &n) {
+      return (n.operation == node.operation) && (n.arity == node.arity) &&
+             (n.arguments == node.arguments);
+    })};
+    if (pos != nodes_.end())
+      return static_cast<std::size_t>(pos - nodes_.begin());
+
+    nodes_.push_back(node);
+    return nodes_.size() - 1;
+  }
+
+  /// Add an output column to the Plan.
+  /// @param name the name of the output column.
+  /// @param node the index of the node to output.
+  void output(std::string_view name, const std::size_t node) {
+    Expects(node < nodes_.size());
+    check_output(name);
+    outputs_.emplace_back(name);
+    output_nodes_.push_back(node);
+  }
+
+  /// Calculate ISA pressures from altitudes in metres.
+  /// @param altitude the name of the altitude column, empty for the current
+  /// altitude.
+  /// @param name the name of the output column.
+  auto pressure(std::string_view altitude = {},
+                std::string_view name = "pressure") -> Plan & {
+    check_output(name);
+    resolve_altitude(altitude);
+    pressure_ = add(Operation::PRESSURE, {*altitude_});
+    output(name, *pressure_);
+    return *this;
+  }
+
+  /// Calculate ISA altitudes from pressures in Pascals.
+  /// @param pressure the name of the pressure column, empty for the current
+  /// pressure.
+  /// @param name the name of the output column.
+  auto altitude(std::string_view pressure = {},
+                std::string_view name = "altitude") -> Plan & {
+    check_output(name);
+    resolve_pressure(pressure);
+    altitude_ = add(Operation::ALTITUDE, {*pressure_});
+    output(name, *altitude_);
+    return *this;
+  }
+
+  /// Calculate ISA temperatures from altitudes in metres and, optionally,
+  /// differences from ISA Sea level temperature in Kelvin.
+  /// @param altitude the name of the altitude column, empty for the current
+  /// altitude.
+  /// @param delta_temperature the name of the temperature difference column,
+  /// empty for ISA temperatures.
+  /// @param name the name of the output column.
+  auto temperature(std::string_view altitude = {},
+                   std::string_view delta_temperature = {},
+                   std::string_view name = "temperature") -> Plan & {
+    check_output(name);
+    resolve_altitude(altitude);
+    temperature_ = delta_temperature.empty()
+                       ? add(Operation::TEMPERATURE, {*altitude_})
+                       : add(Operation::TEMPERATURE,
+                             {*altitude_, input(delta_temperature)});
+    output(name, *temperature_);
+    return *this;
+  }
+
+  /// Calculate air densities from pressures and temperatures.
+  /// @param pressure the name of the pressure column, empty for the current
+  /// pressure.
+  /// @param temperature the name of the temperature column, empty for the
+  /// current temperature.
+  /// @param name the name of the output column.
+  auto density(std::string_view pressure = {},
+               std::string_view temperature = {},
+               std::string_view name = "density") -> Plan & {
+    check_output(name);
+    resolve_pressure(pressure);
+    resolve_temperature(temperature);
+    output(name, add(Operation::DENSITY, {*pressure_, *temperature_}));
+    return *this;
+  }
+
+  /// Calculate True Air Speeds from Calibrated Air Speeds, pressures and
+  /// temperatures.
+  /// @param cas the name of the Calibrated Air Speed column.
+  /// @param pressure the name of the pressure column, empty for the current
+  /// pressure.
+  /// @param temperature the name of the temperature column, empty for the
+  /// current temperature.
+  /// @param name the name of the output column.
+  auto true_air_speed(std::string_view cas = "cas",
+                      std::string_view pressure = {},
+                      std::string_view temperature = {},
+                      std::string_view name = "tas") -> Plan & {
+    check_input(cas);
+    check_output(name);
+    resolve_pressure(pressure);
+    resolve_temperature(temperature);
+    tas_ = add(Operation::TRUE_AIR_SPEED,
+               {input(cas), *pressure_, *temperature_});
+    output(name, *tas_);
+    return *this;
+  }
+
+  /// Calculate Calibrated Air Speeds from True Air Speeds, pressures and
+  /// temperatures.
+  /// @param tas the name of the True Air Speed column, empty for the current
+  /// True Air Speed.
+  /// @param pressure the name of the pressure column, empty for the current
+  /// pressure.
+  /// @param temperature the name of the temperature column, empty for the
+  /// current temperature.
+  /// @param name the name of the output column.
+  auto calibrated_air_speed(std::string_view tas = {},
+                            std::string_view pressure = {},
+                            std::string_view temperature = {},
+                            std::string_view name = "cas") -> Plan & {
+    check_output(name);
+    const auto tas_node{tas.empty() && tas_ ? *tas_
+                                            : input(tas.empty() ? "tas" : tas)};
+    resolve_pressure(pressure);
+    resolve_temperature(temperature);
+    output(name, add(Operation::CALIBRATED_AIR_SPEED,
+                     {tas_node, *pressure_, *temperature_}));
+    return *this;
+  }
+
+  /// Calculate speeds of sound from temperatures.
+  /// @param temperature the name of the temperature column, empty for the
+  /// current temperature.
+  /// @param name the name of the output column.
+  auto speed_of_sound(std::string_view temperature = {},
+                      std::string_view name = "speed_of_sound") -> Plan & {
+    check_output(name);
+    resolve_temperature(temperature);
+    output(name, add(Operation::SPEED_OF_SOUND, {*temperature_}));
+    return *this;
+  }
+
+  /// Calculate True Air Speeds from Mach numbers and temperatures.
+  /// @param mach the name of the Mach number column.
+  /// @param temperature the name of the temperature column, empty for the
+  /// current temperature.
+  /// @param name the name of the output column.
+  auto mach_true_air_speed(std::string_view mach = "mach",
+                           std::string_view temperature = {},
+                           std::string_view name = "tas") -> Plan & {
+    check_input(mach);
+    check_output(name);
+    resolve_temperature(temperature);
+    tas_ = add(Operation::MACH_TRUE_AIR_SPEED, {input(mach), *temperature_});
+    output(name, *tas_);
+    return *this;
+  }
+
+  /// Calculate crossover altitudes from Calibrated Air Speeds and Mach
+  /// numbers.
+  /// @param cas the name of the Calibrated Air Speed column.
+  /// @param mach the name of the Mach number column.
+  /// @param name the name of the output column.
+  auto crossover_altitude(std::string_view cas = "cas",
+                          std::string_view mach = "mach",
+                          std::string_view name = "crossover_altitude")
+      -> Plan & {
+    check_input(cas);
+    check_input(mach);
+    check_output(name);
+    output(name,
+           add(Operation::CROSSOVER_ALTITUDE, {input(cas), input(mach)}));
+    return *this;
+  }
+
+  /// @return the nodes of the Plan.
+  [[nodiscard]] auto nodes() const noexcept -> const std::vector<Node> & {
+    return nodes_;
+  }
+
+  /// @return the names of the input columns, in order of use.
+  [[nodiscard]] auto inputs() const noexcept
+      -> const std::vector<std::string> & {
+    return inputs_;
+  }
+
+  /// @return the names of the output columns, in order of addition.
+  [[nodiscard]] auto outputs() const noexcept
+      -> const std::vector<std::string> & {
+    return outputs_;
+  }
+
+  /// Compile the Plan into a Program.
+  /// @param block_size the number of values in a block.
+  [[nodiscard]] auto compile(const std::size_t block_size = DEFAULT_BLOCK_SIZE)
+      const -> Program<T> {
+    return Program<T>(*this, input_nodes_, output_nodes_, block_size);
+  }
+};
+
+/// A compiled Plan.
+/// The operations that the outputs depend upon are evaluated in order over
+/// each block of values. Each operation reads its arguments from the input
+/// columns, the output columns or scratch memory and writes its results
+/// directly to its output column, if it has one, or to scratch memory.
+template <typename T>
+  requires std::floating_point<T>
+class Program {
+public:
+  /// Where the values of a node are stored.
+  enum class Storage : std::uint8_t { INPUT, OUTPUT, SCRATCH };
+
+  /// The location of the values of a node.
+  struct Location {
+    Storage storage;
+    /// The index of the input column, output column or scratch slot.
+    std::size_t index;
+  };
+
+  /// An operation to evaluate.
+  struct Step {
+    Operation operation;
+    std::size_t arity;
+    std::array<Location, MAX_ARGUMENTS> arguments;
+    Location result;
+  };
+
+private:
+  std::size_t inputs_{};
+  std::size_t outputs_{};
+  std::size_t block_size_{};
+  std::size_t slots_{};
+  std::vector<Step> steps_;
+  /// Outputs of nodes already written to another output column or inputs.
+  std::vector<std::pair<Location, std::size_t>> copies_;
+
+  /// @return the values of a location in a block.
+  static auto values(const Location location,
+                     std::span<const std::span<const T>> inputs,
+                     std::span<const std::span<T>> outputs, T *scratch,
+                     const std::size_t block_size, const std::size_t begin,
+                     const std::size_t count) -> std::span<T> {
+    switch (location.storage) {
+    case Storage::INPUT:
+      // Input values are only read.
+      return {const_cast<T *>(inputs[location.index].data()) + begin, count};
+    case Storage::OUTPUT:
+      return outputs[location.index].subspan(begin, count);
+    default:
+      return {scratch + location.index * block_size, count};
+    }
+  }
+
+  /// Evaluate a step over a block.
+  static void evaluate(const Step &step, std::span<const T> a,
+                       std::span<const T> b, std::span<const T> c,
+                       std::span<T> result) {
+    switch (step.operation) {
+    case Operation::PRESSURE:
+      batch::calculate_isa_pressure(a, result);
+      break;
+    case Operation::ALTITUDE:
+      batch::calculate_isa_altitude(a, result);
+      break;
+    case Operation::TEMPERATURE:
+      if (step.arity == 1)
+        batch::calculate_isa_temperature(a, T(), result);
+      else
+        batch::calculate_isa_temperature(a, b, result);
+      break;
+    case Operation::DENSITY:
+      batch::calculate_density(a, b, result);
+      break;
+    case Operation::TRUE_AIR_SPEED:
+      batch::calculate_true_air_speed(a, b, c, result);
+      break;
+    case Operation::CALIBRATED_AIR_SPEED:
+      batch::calculate_calibrated_air_speed(a, b, c, result);
+      break;
+    case Operation::SPEED_OF_SOUND:
+      batch::speed_of_sound(a, result);
+      break;
+    case Operation::MACH_TRUE_AIR_SPEED:
+      batch::mach_true_air_speed(a, b, result);
+      break;
+    case Operation::CROSSOVER_ALTITUDE:
+      batch::calculate_crossover_altitude(a, b, result);
+      break;
+    default:
+      break;
+    }
+  }
+
+public:
+  /// Compile a Plan.
+  /// Only the nodes that the outputs depend upon are evaluated. Scratch
+  /// slots are allocated to the other nodes in order and released after
+  /// their last use, so that later nodes reuse them.
+  Program(const Plan<T> &plan, std::span<const std::size_t> input_nodes,
+          std::span<const std::size_t> output_nodes,
+          const std::size_t block_size)
+      : inputs_{input_nodes.size()}, outputs_{output_nodes.size()},
+        block_size_{block_size} {
+    Expects(0 < block_size);
+    const auto &nodes{plan.nodes()};
+
+    // Find the nodes that the outputs depend upon and their last uses.
+    constexpr auto NONE{std::numeric_limits<std::size_t>::max()};
+    std::vector<bool> required(nodes.size(), false);
+    std::vector<std::size_t> last_use(nodes.size(), NONE);
+    for (const auto node : output_nodes)
+      required[node] = true;
+    for (auto i{nodes.size()}; i-- > 0;) {
+      if (!required[i])
+        continue;
+      for (std::size_t j{}; j < nodes[i].arity; ++j) {
+        const auto argument{nodes[i].arguments[j]};
+        required[argument] = true;
+        if (last_use[argument] == NONE)
+          last_use[argument] = i;
+      }
+    }
+
+    std::vector<std::optional<Location>> locations(nodes.size());
+    for (std::size_t i{}; i < input_nodes.size(); ++i)
+      locations[input_nodes[i]] = Location{Storage::INPUT, i};
+    for (std::size_t i{}; i < output_nodes.size(); ++i) {
+      if (locations[output_nodes[i]])
+        copies_.emplace_back(*locations[output_nodes[i]], i);
+      else
+        locations[output_nodes[i]] = Location{Storage::OUTPUT, i};
+    }
+
+    std::vector<std::size_t> free_slots;
+    for (std::size_t i{}; i < nodes.size(); ++i) {
+      const auto &node{nodes[i]};
+      if (!required[i] || (node.operation == Operation::INPUT))
+        continue;
+
+      if (!locations[i]) {
+        std::size_t slot{slots_};
+        if (free_slots.empty())
+          ++slots_;
+        else {
+          slot = free_slots.back();
+          free_slots.pop_back();
+        }
+        locations[i] = Location{Storage::SCRATCH, slot};
+      }
+
+      Step step{node.operation, node.arity, {}, *locations[i]};
+      for (std::size_t j{}; j < node.arity; ++j) {
+        const auto argument{node.arguments[j]};
+        step.arguments[j] = *locations[argument];
+        // Release each slot once, even if the node uses an argument twice
+        if ((last_use[argument] == i) &&
+            (locations[argument]->storage == Storage::SCRATCH)) {
+          free_slots.push_back(locations[argument]->index);
+          last_use[argument] = NONE;
+        }
+      }
+      steps_.push_back(step);
+    }
+  }
+
+  /// @return the number of values in a block.
+  [[nodiscard]] auto block_size() const noexcept -> std::size_t {
+    return block_size_;
+  }
+
+  /// @return the number of blocks of scratch memory used by each thread.
+  [[nodiscard]] auto scratch_slots() const noexcept -> std::size_t {
+    return slots_;
+  }
+
+  /// @return the operations evaluated for each block.
+  [[nodiscard]] auto steps() const noexcept -> const std::vector<Step> & {
+    return steps_;
+  }
+
+  /// Run the Program over columns of values.
+  /// @pre the columns are all the same size.
+  /// @param inputs the input columns, in the order of `Plan::inputs`.
+  /// @param outputs the output columns, in the order of `Plan::outputs`.
+  /// @param threads the number of threads, zero for the hardware concurrency.
+  void run(std::span<const std::span<const T>> inputs,
+           std::span<const std::span<T>> outputs,
+           const std::size_t threads = 0) const {
+    Expects(inputs.size() == inputs_);
+    Expects(outputs.size() == outputs_);
+    if (outputs.empty())
+      return;
+    const auto size{outputs.front().size()};
+    Expects(std::ranges::all_of(
+        inputs, [size](const auto &in) { return in.size() == size; }));
+    Expects(std::ranges::all_of(
+        outputs, [size](const auto &out) { return out.size() == size; }));
+
+    const auto blocks{(size + block_size_ - 1) / block_size_};
+    parallel_for(
+        blocks,
+        [&](const std::size_t block) {
+          // The scratch memory of this thread, reused for every block.
+          thread_local std::vector<T> scratch;
+          scratch.resize(std::max(scratch.size(), slots_ * block_size_));
+
+          const auto begin{block * block_size_};
+          const auto count{std::min(block_size_, size - begin)};
+          const auto block_values{[&](const Location location) {
+            return values(location, inputs, outputs, scratch.data(),
+                          block_size_, begin, count);
+          }};
+
+          for (const auto &step : steps_) {
+            std::array<std::span<const T>, MAX_ARGUMENTS> arguments;
+            for (std::size_t j{}; j < step.arity; ++j)
+              arguments[j] = block_values(step.arguments[j]);
+            evaluate(step, arguments[0], arguments[1], arguments[2],
+                     block_values(step.result));
+          }
+
+          for (const auto &[location, output] : copies_)
+            std::ranges::copy(block_values(location),
+                              outputs[output].begin() + begin);
+        },
+        threads);
+  }
+};
+
+} // namespace plan
+} // namespace isa
+} // namespace via
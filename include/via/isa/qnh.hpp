@@ -0,0 +1,384 @@
+#pragma once
+
+//////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2024 Ken Barker
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//////////////////////////////////////////////////////////////////////////////
+/// @file
+/// @brief Regional QNH settings and the conversion of pressure altitudes to
+/// and from the altitudes indicated by altimeters set to the local QNH.
+///
+/// Below the tropopause, pressure altitudes are a linear function of QNH
+/// altitudes, see `Atmosphere`. So a `QnhMap` stores the `Atmosphere`
+/// offset and factor of each region and converts positions in blocks: the
+/// regions of a block of positions are found using a flattened grid spatial
+/// index, then the altitudes are converted in a simple loop which compilers
+/// may vectorise.
+///
+/// Positions outside all of the regions use the default region of the map.
+//////////////////////////////////////////////////////////////////////////////
+#include "atmosphere.hpp"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <vector>
+
+namespace via {
+namespace isa {
+
+/// A region with a QNH setting, bounded by latitudes and longitudes.
+/// Regions must not cross the antimeridian.
+template <typename T>
+  requires std::floating_point<T>
+struct QnhRegion {
+  /// The minimum latitude in degrees.
+  T min_latitude;
+  /// The maximum latitude in degrees.
+  T max_latitude;
+  /// The minimum longitude in degrees.
+  T min_longitude;
+  /// The maximum longitude in degrees.
+  T max_longitude;
+  /// The QNH in Pascals.
+  units::si::Pascals<T> qnh;
+  /// The transition altitude in metres.
+  units::si::Metres<T> transition_altitude;
+};
+
+/// The interval between flight levels: 1000 feet in metres.
+template <typename T>
+  requires std::floating_point<T>
+constexpr units::si::Metres<T> FLIGHT_LEVEL_INTERVAL{T(304.8)};
+
+/// Calculate the transition level: the lowest flight level above the
+/// transition altitude.
+/// @pre the transition altitude is below the tropopause.
+/// @param transition_altitude the transition altitude in metres.
+/// @param qnh the QNH in Pascals.
+/// @param interval the interval between usable flight levels in metres.
+/// @return the pressure altitude of the transition level in metres.
+template <typename T>
+  requires std::floating_point<T>
+[[nodiscard("Pure Function")]]
+auto calculate_transition_level(
+    const units::si::Metres<T> transition_altitude,
+    const units::si::Pascals<T> qnh,
+    const units::si::Metres<T> interval = FLIGHT_LEVEL_INTERVAL<T>)
+    -> units::si::Metres<T> {
+  Expects(interval.v() > T());
+
+  // The pressure at the transition altitude
+  const auto pressure{units::si::Pascals<T>(
+      calculate_isa_pressure(transition_altitude).v() * qnh.v() /
+      constants::SEA_LEVEL_PRESSURE<T>.v())};
+  const T altitude{calculate_isa_altitude(pressure).v()};
+  return units::si::Metres<T>((std::floor(altitude / interval.v()) + 1) *
+                              interval.v());
+}
+
+/// A map of QNH regions with a flattened grid spatial index.
+template <typename T>
+  requires std::floating_point<T>
+class QnhMap {
+public:
+  /// The number of positions converted together.
+  static constexpr std::size_t BLOCK_SIZE{256};
+  /// The index of the default region.
+  static constexpr std::uint32_t DEFAULT_REGION{0};
+
+private:
+  // The region bounds, index 0 is the default region.
+  std::vector<T> min_latitudes_;
+  std::vector<T> max_latitudes_;
+  std::vector<T> min_longitudes_;
+  std::vector<T> max_longitudes_;
+
+  // The precomputed region coefficients.
+  std::vector<T> qnhs_;
+  std::vector<T> offsets_;
+  std::vector<T> factors_;
+  std::vector<T> transition_altitudes_;
+  std::vector<T> transition_levels_;
+
+  // The grid over the bounds of the regions.
+  T min_latitude_{};
+  T min_longitude_{};
+  T cell_size_{};
+  std::size_t rows_{};
+  std::size_t columns_{};
+  /// The offsets of the regions of each cell in cell_regions_.
+  std::vector<std::uint32_t> cell_offsets_;
+  /// The regions overlapping each cell in order.
+  std::vector<std::uint32_t> cell_regions_;
+
+  void add_region(const QnhRegion<T> &region) {
+    min_latitudes_.push_back(region.min_latitude);
+    max_latitudes_.push_back(region.max_latitude);
+    min_longitudes_.push_back(region.min_longitude);
+    max_longitudes_.push_back(region.max_longitude);
+
+    qnhs_.push_back(region.qnh.v());
+    const Atmosphere<T> atmosphere(region.qnh);
+    offsets_.push_back(atmosphere.offset().v());
+    factors_.push_back(atmosphere.factor());
+    transition_altitudes_.push_back(region.transition_altitude.v());
+    transition_levels_.push_back(
+        calculate_transition_level(region.transition_altitude, region.qnh)
+            .v());
+  }
+
+  /// @return the grid row or column of a coordinate, clamped to the grid.
+  [[nodiscard]] auto cell(const T value, const T minimum,
+                          const std::size_t size) const noexcept
+      -> std::size_t {
+    const T index{std::floor((value - minimum) / cell_size_)};
+    return static_cast<std::size_t>(
+        std::clamp(index, T(), static_cast<T>(size - 1)));
+  }
+
+public:
+  /// Constructor.
+  /// @pre the regions are valid and cell_size > 0
+  /// @param regions the QNH regions. Where regions overlap, a position is in
+  /// the first region that contains it.
+  /// @param default_region the QNH and transition altitude of positions
+  /// outside of the regions, its bounds are ignored.
+  /// @param cell_size the size of the grid cells in degrees.
+  explicit QnhMap(std::span<const QnhRegion<T>> regions,
+                  const QnhRegion<T> &default_region,
+                  const T cell_size = T(1))
+      : cell_size_{cell_size} {
+    Expects(cell_size > T());
+    Expects(regions.size() < std::numeric_limits<std::uint32_t>::max());
+
+    add_region(default_region);
+    for (const auto &region : regions) {
+      Expects(region.min_latitude <= region.max_latitude);
+      Expects(region.min_longitude <= region.max_longitude);
+      add_region(region);
+    }
+
+    if (regions.empty()) {
+      rows_ = columns_ = 1;
+      cell_offsets_.assign(2, 0);
+      return;
+    }
+
+    // Cover the bounds of the regions with the grid
+    min_latitude_ = *std::min_element(min_latitudes_.begin() + 1,
+                                      min_latitudes_.end());
+    min_longitude_ = *std::min_element(min_longitudes_.begin() + 1,
+                                       min_longitudes_.end());
+    const T max_latitude{
+        *std::max_element(max_latitudes_.begin() + 1, max_latitudes_.end())};
+    const T max_longitude{*std::max_element(max_longitudes_.begin() + 1,
+                                            max_longitudes_.end())};
+    rows_ = static_cast<std::size_t>(
+                std::floor((max_latitude - min_latitude_) / cell_size_)) +
+            1;
+    columns_ = static_cast<std::size_t>(
+                   std::floor((max_longitude - min_longitude_) / cell_size_)) +
+               1;
+
+    // Count then list the regions overlapping each cell, in region order
+    cell_offsets_.assign(rows_ * columns_ + 1, 0);
+    const auto for_each_cell{[this](const std::size_t r, auto &&function) {
+      const auto row_begin{cell(min_latitudes_[r], min_latitude_, rows_)};
+      const auto row_end{cell(max_latitudes_[r], min_latitude_, rows_)};
+      const auto column_begin{
+          cell(min_longitudes_[r], min_longitude_, columns_)};
+      const auto column_end{cell(max_longitudes_[r], min_longitude_, columns_)};
+      for (auto row{row_begin}; row <= row_end; ++row)
+        for (auto column{column_begin}; column <= column_end; ++column)
+          function(row * columns_ + column);
+    }};
+    for (std::size_t r{1}; r < qnhs_.size(); ++r)
+      for_each_cell(r, [this](const std::size_t c) { ++cell_offsets_[c + 1]; });
+    for (std::size_t c{}; c < rows_ * columns_; ++c)
+      cell_offsets_[c + 1] += cell_offsets_[c];
+
+    cell_regions_.resize(cell_offsets_.back());
+    std::vector<std::uint32_t> next(cell_offsets_.begin(),
+                                    cell_offsets_.end() - 1);
+    for (std::size_t r{1}; r < qnhs_.size(); ++r)
+      for_each_cell(r, [&](const std::size_t c) {
+        cell_regions_[next[c]++] = static_cast<std::uint32_t>(r);
+      });
+  }
+
+  /// @return the number of regions, including the default region.
+  [[nodiscard]] auto size() const noexcept -> std::size_t {
+    return qnhs_.size();
+  }
+
+  /// @return the QNH of a region in Pascals.
+  [[nodiscard]] auto qnh(const std::uint32_t region) const
+      -> units::si::Pascals<T> {
+    return units::si::Pascals<T>(qnhs_[region]);
+  }
+
+  /// @return the transition altitude of a region in metres.
+  [[nodiscard]] auto transition_altitude(const std::uint32_t region) const
+      -> units::si::Metres<T> {
+    return units::si::Metres<T>(transition_altitudes_[region]);
+  }
+
+  /// @return the pressure altitude of the transition level of a region in
+  /// metres.
+  [[nodiscard]] auto transition_level(const std::uint32_t region) const
+      -> units::si::Metres<T> {
+    return units::si::Metres<T>(transition_levels_[region]);
+  }
+
+  /// Find the region containing a position.
+  /// @param latitude the latitude in degrees.
+  /// @param longitude the longitude in degrees.
+  /// @return the index of the region, DEFAULT_REGION if outside the regions.
+  [[nodiscard]] auto region(const T latitude, const T longitude) const
+      -> std::uint32_t {
+    const T row{std::floor((latitude - min_latitude_) / cell_size_)};
+    const T column{std::floor((longitude - min_longitude_) / cell_size_)};
+    if (!(row >= T() && row < static_cast<T>(rows_) && column >= T() &&
+          column < static_cast<T>(columns_)))
+      return DEFAULT_REGION;
+
+    const auto c{static_cast<std::size_t>(row) * columns_ +
+                 static_cast<std::size_t>(column)};
+    for (auto i{cell_offsets_[c]}; i < cell_offsets_[c + 1]; ++i) {
+      const auto r{cell_regions_[i]};
+      if ((min_latitudes_[r] <= latitude) && (latitude <= max_latitudes_[r]) &&
+          (min_longitudes_[r] <= longitude) &&
+          (longitude <= max_longitudes_[r]))
+        return r;
+    }
+    return DEFAULT_REGION;
+  }
+
+  /// Find the regions containing positions.
+  /// @pre the spans are the same size.
+  /// @param latitudes the latitudes in degrees.
+  /// @param longitudes the longitudes in degrees.
+  /// @param regions the indices of the regions.
+  void find_regions(std::span<const T> latitudes,
+                    std::span<const T> longitudes,
+                    std::span<std::uint32_t> regions) const {
+    Expects(latitudes.size() == longitudes.size());
+    Expects(latitudes.size() == regions.size());
+
+    for (std::size_t i{}; i < latitudes.size(); ++i)
+      regions[i] = region(latitudes[i], longitudes[i]);
+  }
+
+  /// Calculate the pressure altitudes of the altitudes indicated by
+  /// altimeters set to the QNH of their regions.
+  /// @pre the spans are the same size and the altitudes are below the
+  /// tropopause.
+  /// @param latitudes the latitudes in degrees.
+  /// @param longitudes the longitudes in degrees.
+  /// @param qnh_altitudes the QNH altitudes in metres.
+  /// @param pressure_altitudes the pressure altitudes in metres.
+  void calculate_pressure_altitudes(std::span<const T> latitudes,
+                                    std::span<const T> longitudes,
+                                    std::span<const T> qnh_altitudes,
+                                    std::span<T> pressure_altitudes) const {
+    Expects(latitudes.size() == longitudes.size());
+    Expects(latitudes.size() == qnh_altitudes.size());
+    Expects(latitudes.size() == pressure_altitudes.size());
+
+    std::array<std::uint32_t, BLOCK_SIZE> regions;
+    for (std::size_t begin{}; begin < latitudes.size(); begin += BLOCK_SIZE) {
+      const auto n{std::min(BLOCK_SIZE, latitudes.size() - begin)};
+      find_regions(latitudes.subspan(begin, n), longitudes.subspan(begin, n),
+                   std::span(regions).first(n));
+      for (std::size_t i{}; i < n; ++i)
+        pressure_altitudes[begin + i] =
+            offsets_[regions[i]] +
+            factors_[regions[i]] * qnh_altitudes[begin + i];
+    }
+  }
+
+  /// Calculate the altitudes indicated by altimeters set to the QNH of their
+  /// regions.
+  /// @pre the spans are the same size and the altitudes are below the
+  /// tropopause.
+  /// @param latitudes the latitudes in degrees.
+  /// @param longitudes the longitudes in degrees.
+  /// @param pressure_altitudes the pressure altitudes in metres.
+  /// @param qnh_altitudes the QNH altitudes in metres.
+  void calculate_qnh_altitudes(std::span<const T> latitudes,
+                               std::span<const T> longitudes,
+                               std::span<const T> pressure_altitudes,
+                               std::span<T> qnh_altitudes) const {
+    Expects(latitudes.size() == longitudes.size());
+    Expects(latitudes.size() == pressure_altitudes.size());
+    Expects(latitudes.size() == qnh_altitudes.size());
+
+    std::array<std::uint32_t, BLOCK_SIZE> regions;
+    for (std::size_t begin{}; begin < latitudes.size(); begin += BLOCK_SIZE) {
+      const auto n{std::min(BLOCK_SIZE, latitudes.size() - begin)};
+      find_regions(latitudes.subspan(begin, n), longitudes.subspan(begin, n),
+                   std::span(regions).first(n));
+      for (std::size_t i{}; i < n; ++i)
+        qnh_altitudes[begin + i] =
+            (pressure_altitudes[begin + i] - offsets_[regions[i]]) /
+            factors_[regions[i]];
+    }
+  }
+
+  /// Calculate the altitudes indicated by altimeters, which are set to the
+  /// QNH of their regions below the transition level and to the standard
+  /// pressure at and above it.
+  /// Aircraft in the transition layer, between the transition altitude and
+  /// the transition level, indicate QNH altitudes, as when descending.
+  /// @pre the spans are the same size.
+  /// @param latitudes the latitudes in degrees.
+  /// @param longitudes the longitudes in degrees.
+  /// @param pressure_altitudes the pressure altitudes in metres.
+  /// @param indicated_altitudes the indicated altitudes in metres.
+  void calculate_indicated_altitudes(std::span<const T> latitudes,
+                                     std::span<const T> longitudes,
+                                     std::span<const T> pressure_altitudes,
+                                     std::span<T> indicated_altitudes) const {
+    Expects(latitudes.size() == longitudes.size());
+    Expects(latitudes.size() == pressure_altitudes.size());
+    Expects(latitudes.size() == indicated_altitudes.size());
+
+    std::array<std::uint32_t, BLOCK_SIZE> regions;
+    for (std::size_t begin{}; begin < latitudes.size(); begin += BLOCK_SIZE) {
+      const auto n{std::min(BLOCK_SIZE, latitudes.size() - begin)};
+      find_regions(latitudes.subspan(begin, n), longitudes.subspan(begin, n),
+                   std::span(regions).first(n));
+      for (std::size_t i{}; i < n; ++i) {
+        const T altitude{pressure_altitudes[begin + i]};
+        const T qnh_altitude{(altitude - offsets_[regions[i]]) /
+                             factors_[regions[i]]};
+        indicated_altitudes[begin + i] =
+            (altitude < transition_levels_[regions[i]]) ? qnh_altitude
+                                                        : altitude;
+      }
+    }
+  }
+};
+
+} // namespace isa
+} // namespace via
@@ -0,0 +1,489 @@
+#pragma once
+
+//////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2024 Ken Barker
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//////////////////////////////////////////////////////////////////////////////
+/// @file
+/// @brief Reductions of the batch functions, e.g. the maximum Mach number or
+/// the mean density of a route, without storing the values of the functions.
+///
+/// The values of a batch function are calculated in blocks into a fixed
+/// size array and added to an accumulator: a `Summary` of the count,
+/// minimum, maximum and mean values, a `QuantileSketch` of their
+/// distribution or both (`Statistics`).
+///
+/// The input is divided into a number of partitions which depends only
+/// upon its size. The partitions are reduced in parallel and their
+/// accumulators are merged in order, so the results are the same for any
+/// number of threads.
+//////////////////////////////////////////////////////////////////////////////
+#include "batch.hpp"
+#include "parallel.hpp"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <vector>
+
+namespace via {
+namespace isa {
+namespace reduction {
+
+/// The number of values calculated together.
+constexpr std::size_t BLOCK_SIZE{512};
+
+/// The maximum number of partitions of a reduction.
+constexpr std::size_t MAX_PARTITIONS{64};
+
+/// The count, minimum, maximum and mean of values.
+template <typename T>
+  requires std::floating_point<T>
+class Summary {
+  /// The number of independent accumulators, so that the loops may be
+  /// vectorised without reordering the floating point additions.
+  static constexpr std::size_t LANES{4};
+
+  std::size_t count_{};
+  T min_{std::numeric_limits<T>::infinity()};
+  T max_{-std::numeric_limits<T>::infinity()};
+  T sum_{};
+
+public:
+  /// Add a value.
+  constexpr void add(const T value) noexcept {
+    ++count_;
+    min_ = std::min(min_, value);
+    max_ = std::max(max_, value);
+    sum_ += value;
+  }
+
+  /// Add values.
+  /// @pre the values are not NaN.
+  constexpr void add(std::span<const T> values) noexcept {
+    std::array<T, LANES> mins;
+    std::array<T, LANES> maxs;
+    std::array<T, LANES> sums{};
+    mins.fill(min_);
+    maxs.fill(max_);
+
+    const auto n{values.size() - values.size() % LANES};
+    for (std::size_t i{}; i < n; i += LANES)
+      for (std::size_t j{}; j < LANES; ++j) {
+        mins[j] = std::min(mins[j], values[i + j]);
+        maxs[j] = std::max(maxs[j], values[i + j]);
+        sums[j] += values[i + j];
+      }
+    for (std::size_t j{}; j < LANES; ++j) {
+      min_ = std::min(min_, mins[j]);
+      max_ = std::max(max_, maxs[j]);
+      sum_ += sums[j];
+    }
+    count_ += n;
+
+    for (std::size_t i{n}; i < values.size(); ++i)
+      add(values[i]);
+  }
+
+  /// Merge another Summary into this one.
+  constexpr void merge(const Summary &other) noexcept {
+    count_ += other.count_;
+    min_ = std::min(min_, other.min_);
+    max_ = std::max(max_, other.max_);
+    sum_ += other.sum_;
+  }
+
+  /// @return the number of values.
+  [[nodiscard]] constexpr auto count() const noexcept -> std::size_t {
+    return count_;
+  }
+
+  /// @return the minimum value, infinity if there are no values.
+  [[nodiscard]] constexpr auto min() const noexcept -> T { return min_; }
+
+  /// @return the maximum value, -infinity if there are no values.
+  [[nodiscard]] constexpr auto max() const noexcept -> T { return max_; }
+
+  /// @return the sum of the values.
+  [[nodiscard]] constexpr auto sum() const noexcept -> T { return sum_; }
+
+  /// @return the mean value, NaN if there are no values.
+  [[nodiscard]] constexpr auto mean() const noexcept -> T {
+    return count_ ? sum_ / static_cast<T>(count_)
+                  : std::numeric_limits<T>::quiet_NaN();
+  }
+};
+
+/// A mergeable sketch of the distribution of values, from which quantiles
+/// can be estimated with a relative accuracy.
+/// Values are counted in buckets with logarithmically increasing bounds,
+/// see: Masson, Rim and Lee, "DDSketch: A Fast and Fully-Mergeable Quantile
+/// Sketch with Relative-Error Guarantees", 2019.
+/// The number of buckets depends upon the range of the values, not upon
+/// the number of values, and sketches are merged by adding their counts, so
+/// merging is exact and in any order.
+template <typename T>
+  requires std::floating_point<T>
+class QuantileSketch {
+  /// Counts of values in consecutive buckets.
+  class Store {
+    std::int64_t offset_{};
+    std::vector<std::uint64_t> counts_;
+
+  public:
+    void add(const std::int64_t index, const std::uint64_t count = 1) {
+      if (counts_.empty()) {
+        offset_ = index;
+        counts_.resize(1);
+      } else if (index < offset_) {
+        counts_.insert(counts_.begin(), static_cast<std::size_t>(offset_ - index),
+                       0);
+        offset_ = index;
+      } else if (index >= offset_ + static_cast<std::int64_t>(counts_.size()))
+        counts_.resize(static_cast<std::size_t>(index - offset_ + 1));
+      counts_[static_cast<std::size_t>(index - offset_)] += count;
+    }
+
+    void merge(const Store &other) {
+      for (std::size_t i{}; i < other.counts_.size(); ++i)
+        if (other.counts_[i])
+          add(other.offset_ + static_cast<std::int64_t>(i), other.counts_[i]);
+    }
+
+    [[nodiscard]] auto offset() const noexcept -> std::int64_t {
+      return offset_;
+    }
+
+    [[nodiscard]] auto counts() const noexcept
+        -> const std::vector<std::uint64_t> & {
+      return counts_;
+    }
+  };
+
+  T relative_accuracy_;
+  T gamma_;
+  T inverse_log_gamma_;
+  /// Positive values.
+  Store positive_;
+  /// The magnitudes of negative values.
+  Store negative_;
+  std::uint64_t zeros_{};
+  std::uint64_t count_{};
+
+  /// @return the bucket index of a positive value.
+  [[nodiscard]] auto index(const T value) const -> std::int64_t {
+    return static_cast<std::int64_t>(
+        std::ceil(std::log(value) * inverse_log_gamma_));
+  }
+
+  /// @return the representative value of a bucket.
+  [[nodiscard]] auto value(const std::int64_t index) const -> T {
+    return T(2) * std::pow(gamma_, static_cast<T>(index)) / (gamma_ + T(1));
+  }
+
+public:
+  /// Constructor.
+  /// @pre 0 < relative_accuracy < 1
+  /// @param relative_accuracy the relative accuracy of the quantiles.
+  explicit QuantileSketch(const T relative_accuracy = T(0.01))
+      : relative_accuracy_{relative_accuracy},
+        gamma_{(T(1) + relative_accuracy) / (T(1) - relative_accuracy)},
+        inverse_log_gamma_{T(1) / std::log(gamma_)} {
+    Expects((T() < relative_accuracy) && (relative_accuracy < T(1)));
+  }
+
+  /// Add a value.
+  /// @pre the value is finite.
+  void add(const T value) {
+    ++count_;
+    if (value > T())
+      positive_.add(index(value));
+    else if (value < T())
+      negative_.add(index(-value));
+    else
+      ++zeros_;
+  }
+
+  /// Add values.
+  /// @pre the values are finite.
+  void add(std::span<const T> values) {
+    for (const auto value : values)
+      add(value);
+  }
+
+  /// Merge another sketch into this one.
+  /// @pre the sketches have the same relative accuracy.
+  void merge(const QuantileSketch &other) {
+    Expects(relative_accuracy_ == other.relative_accuracy_);
+
+    positive_.merge(other.positive_);
+    negative_.merge(other.negative_);
+    zeros_ += other.zeros_;
+    count_ += other.count_;
+  }
+
+  /// @return the relative accuracy of the quantiles.
+  [[nodiscard]] auto relative_accuracy() const noexcept -> T {
+    return relative_accuracy_;
+  }
+
+  /// @return the number of values.
+  [[nodiscard]] auto count() const noexcept -> std::size_t {
+    return static_cast<std::size_t>(count_);
+  }
+
+  /// Estimate a quantile of the values.
+  /// @pre 0 <= q <= 1
+  /// @param q the quantile, e.g. 0.5 for the median.
+  /// @return the estimated quantile, NaN if there are no values.
+  [[nodiscard]] auto quantile(const T q) const -> T {
+    Expects((T() <= q) && (q <= T(1)));
+    if (count_ == 0)
+      return std::numeric_limits<T>::quiet_NaN();
+
+    const auto rank{
+        static_cast<std::uint64_t>(q * static_cast<T>(count_ - 1))};
+    std::uint64_t n{};
+    // Negative values, from the largest magnitude
+    const auto &negatives{negative_.counts()};
+    for (auto i{negatives.size()}; i-- > 0;) {
+      n += negatives[i];
+      if (n > rank)
+        return -value(negative_.offset() + static_cast<std::int64_t>(i));
+    }
+    n += zeros_;
+    if (n > rank)
+      return T();
+    const auto &positives{positive_.counts()};
+    for (std::size_t i{}; i < positives.size(); ++i) {
+      n += positives[i];
+      if (n > rank)
+        return value(positive_.offset() + static_cast<std::int64_t>(i));
+    }
+    return value(positive_.offset() +
+                 static_cast<std::int64_t>(positives.size()) - 1);
+  }
+};
+
+/// A Summary and a QuantileSketch of values.
+template <typename T>
+  requires std::floating_point<T>
+struct Statistics {
+  Summary<T> summary{};
+  QuantileSketch<T> sketch{};
+
+  /// Add values.
+  void add(std::span<const T> values) {
+    summary.add(values);
+    sketch.add(values);
+  }
+
+  /// Merge other Statistics into these.
+  void merge(const Statistics &other) {
+    summary.merge(other.summary);
+    sketch.merge(other.sketch);
+  }
+};
+
+/// The number of values in each partition of a reduction, a multiple of
+/// BLOCK_SIZE which depends only upon the number of values.
+[[nodiscard]] constexpr auto partition_size(const std::size_t size) noexcept
+    -> std::size_t {
+  const auto blocks{(size + BLOCK_SIZE - 1) / BLOCK_SIZE};
+  const auto blocks_per_partition{
+      std::max<std::size_t>((blocks + MAX_PARTITIONS - 1) / MAX_PARTITIONS, 1)};
+  return blocks_per_partition * BLOCK_SIZE;
+}
+
+/// Reduce the values of a kernel.
+/// @param size the number of values.
+/// @param kernel a function called with the index of the first value of a
+/// block and a span to write the values of the block to.
+/// @param initial the initial accumulator, e.g. an empty Summary. It must
+/// have member functions `add(std::span<const T>)` and `merge`.
+/// @param threads the number of threads, zero for the hardware concurrency.
+/// @return the accumulator of all of the values.
+template <typename T, typename Accumulator, typename Kernel>
+  requires std::floating_point<T>
+auto reduce(const std::size_t size, Kernel kernel, const Accumulator &initial,
+            const std::size_t threads = 0) -> Accumulator {
+  const auto partition{partition_size(size)};
+  const auto partitions{(size + partition - 1) / partition};
+  std::vector<Accumulator> accumulators(partitions, initial);
+
+  parallel_for(
+      partitions,
+      [&](const std::size_t p) {
+        std::array<T, BLOCK_SIZE> values;
+        const auto end{std::min(size, (p + 1) * partition)};
+        for (auto begin{p * partition}; begin < end; begin += BLOCK_SIZE) {
+          const auto block{
+              std::span<T>(values).first(std::min(BLOCK_SIZE, end - begin))};
+          kernel(begin, block);
+          accumulators[p].add(std::span<const T>(block));
+        }
+      },
+      threads);
+
+  auto result{initial};
+  for (const auto &accumulator : accumulators)
+    result.merge(accumulator);
+  return result;
+}
+
+/// Reduce the ISA pressures corresponding to the given altitudes.
+/// @param altitudes the pressure altitudes in metres.
+/// @param initial the initial accumulator, see `reduce`.
+/// @param threads the number of threads, zero for the hardware concurrency.
+/// @return the accumulator of the pressures in Pascals.
+template <typename T, typename Accumulator>
+  requires std::floating_point<T>
+auto reduce_isa_pressure(std::span<const T> altitudes,
+                         const Accumulator &initial,
+                         const std::size_t threads = 0) -> Accumulator {
+  return reduce<T>(
+      altitudes.size(),
+      [altitudes](const std::size_t begin, std::span<T> pressures) {
+        batch::calculate_isa_pressure(
+            altitudes.subspan(begin, pressures.size()), pressures);
+      },
+      initial, threads);
+}
+
+/// Reduce the air densities of the given pressures and temperatures.
+/// @param pressures the pressures in Pascals.
+/// @param temperatures the temperatures in Kelvin.
+/// @param initial the initial accumulator, see `reduce`.
+/// @param threads the number of threads, zero for the hardware concurrency.
+/// @return the accumulator of the densities in Kg per cubic metre.
+template <typename T, typename Accumulator>
+  requires std::floating_point<T>
+auto reduce_density(std::span<const T> pressures,
+                    std::span<const T> temperatures,
+                    const Accumulator &initial, const std::size_t threads = 0)
+    -> Accumulator {
+  Expects(pressures.size() == temperatures.size());
+
+  return reduce<T>(
+      pressures.size(),
+      [pressures, temperatures](const std::size_t begin,
+                                std::span<T> densities) {
+        batch::calculate_density(pressures.subspan(begin, densities.size()),
+                                 temperatures.subspan(begin, densities.size()),
+                                 densities);
+      },
+      initial, threads);
+}
+
+/// Reduce the True Air Speeds of the given Mach numbers and temperatures.
+/// @param machs the Mach numbers.
+/// @param temperatures the temperatures in Kelvin.
+/// @param initial the initial accumulator, see `reduce`.
+/// @param threads the number of threads, zero for the hardware concurrency.
+/// @return the accumulator of the True Air Speeds in metres per second.
+template <typename T, typename Accumulator>
+  requires std::floating_point<T>
+auto reduce_mach_true_air_speed(std::span<const T> machs,
+                                std::span<const T> temperatures,
+                                const Accumulator &initial,
+                                const std::size_t threads = 0) -> Accumulator {
+  Expects(machs.size() == temperatures.size());
+
+  return reduce<T>(
+      machs.size(),
+      [machs, temperatures](const std::size_t begin, std::span<T> tas) {
+        batch::mach_true_air_speed(machs.subspan(begin, tas.size()),
+                                   temperatures.subspan(begin, tas.size()),
+                                   tas);
+      },
+      initial, threads);
+}
+
+/// Reduce the Mach numbers of the given Calibrated Air Speeds and pressure
+/// altitudes.
+/// @param cas the Calibrated Air Speeds in metres per second.
+/// @param altitudes the pressure altitudes in metres.
+/// @param initial the initial accumulator, see `reduce`.
+/// @param threads the number of threads, zero for the hardware concurrency.
+/// @return the accumulator of the Mach numbers.
+template <typename T, typename Accumulator>
+  requires std::floating_point<T>
+auto reduce_calibrated_air_speed_mach(std::span<const T> cas,
+                                      std::span<const T> altitudes,
+                                      const Accumulator &initial,
+                                      const std::size_t threads = 0)
+    -> Accumulator {
+  Expects(cas.size() == altitudes.size());
+
+  return reduce<T>(
+      cas.size(),
+      [cas, altitudes](const std::size_t begin, std::span<T> machs) {
+        for (std::size_t i{}; i < machs.size(); ++i)
+          machs[i] = calibrated_air_speed_mach(
+              units::si::MetresPerSecond<T>(cas[begin + i]),
+              calculate_isa_pressure(
+                  units::si::Metres<T>(altitudes[begin + i])));
+      },
+      initial, threads);
+}
+
+/// Calculate the time for which values are above a threshold, e.g. the time
+/// above the tropopause, where the values are interpolated linearly between
+/// samples.
+/// @pre the columns are the same size and the times are increasing.
+/// @param times the times of the samples.
+/// @param values the values of the samples.
+/// @param threshold the threshold.
+/// @param threads the number of threads, zero for the hardware concurrency.
+/// @return the time above the threshold.
+template <typename T>
+  requires std::floating_point<T>
+auto time_above(std::span<const T> times, std::span<const T> values,
+                const T threshold, const std::size_t threads = 0) -> T {
+  Expects(times.size() == values.size());
+  if (times.size() < 2)
+    return T();
+
+  // The durations above the threshold of the intervals between samples
+  Summary<T> durations{reduce<T>(
+      times.size() - 1,
+      [times, values, threshold](const std::size_t begin,
+                                 std::span<T> above) {
+        for (std::size_t i{}; i < above.size(); ++i) {
+          const auto j{begin + i};
+          const T a{values[j] - threshold};
+          const T b{values[j + 1] - threshold};
+          const T dt{times[j + 1] - times[j]};
+          // The fraction of the interval above the threshold
+          const T fraction{((a > T()) == (b > T()))
+                               ? T(a > T())
+                               : ((a > T()) ? a : b) / std::abs(a - b)};
+          above[i] = fraction * dt;
+        }
+      },
+      Summary<T>{}, threads)};
+  return durations.sum();
+}
+
+} // namespace reduction
+} // namespace isa
+} // namespace via
@@ -0,0 +1,296 @@
+#pragma once
+
+//////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2024 Ken Barker
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//////////////////////////////////////////////////////////////////////////////
+/// @file
+/// @brief A deterministic generator of synthetic flight profiles.
+///
+/// The profiles follow typical airliner CAS / Mach climb and descent
+/// schedules with a cruise at a constant flight level, so that most samples
+/// are at cruise altitudes and consecutive samples are strongly correlated.
+/// They are intended for benchmarks and accuracy tests which should run on
+/// realistic, rather than uniformly random, air data.
+//////////////////////////////////////////////////////////////////////////////
+#include "../isa.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+namespace via {
+namespace isa {
+namespace detail {
+/// A SplitMix64 pseudo random number generator.
+/// It is used instead of the `<random>` distributions so that the generated
+/// profiles are identical on every platform and standard library.
+class SplitMix64 {
+  std::uint64_t state_;
+
+public:
+  explicit constexpr SplitMix64(std::uint64_t seed) noexcept : state_{seed} {}
+
+  /// @return the next 64 bit pseudo random number.
+  constexpr auto next() noexcept -> std::uint64_t {
+    std::uint64_t z{state_ += 0x9e37'79b9'7f4a'7c15ULL};
+    z = (z ^ (z >> 30)) * 0xbf58'476d'1ce4'e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d0'49bb'1331'11ebULL;
+    return z ^ (z >> 31);
+  }
+
+  /// @return a pseudo random number uniformly distributed in [0, 1).
+  template <typename T>
+    requires std::floating_point<T>
+  constexpr auto uniform() noexcept -> T {
+    return T(next() >> 11) * T(0x1.0p-53);
+  }
+
+  /// @return a pseudo random number uniformly distributed in [lower, upper).
+  template <typename T>
+    requires std::floating_point<T>
+  constexpr auto uniform(const T lower, const T upper) noexcept -> T {
+    return lower + (upper - lower) * uniform<T>();
+  }
+
+  /// An approximately normally distributed pseudo random number, from the
+  /// Irwin-Hall sum of twelve uniform numbers.
+  /// @return a pseudo random number with zero mean and unit variance.
+  template <typename T>
+    requires std::floating_point<T>
+  constexpr auto normal() noexcept -> T {
+    T sum{};
+    for (int i{}; i < 12; ++i)
+      sum += uniform<T>();
+    return sum - T(6);
+  }
+};
+} // namespace detail
+
+/// The flight phase of a synthetic flight profile sample.
+enum class FlightPhase : std::uint8_t { CLIMB, CRUISE, DESCENT };
+
+/// The parameters of a synthetic fleet.
+/// All values are in SI units: metres, seconds, metres per second and Kelvin.
+template <typename T>
+  requires std::floating_point<T>
+struct FleetParameters {
+  /// The number of flights to generate.
+  std::size_t flights{100};
+  /// The seed of the pseudo random number generator.
+  std::uint64_t seed{0x15a'15a};
+  /// The time between samples.
+  T sample_period{4};
+
+  /// The lowest and highest cruise altitudes, FL290 and FL410.
+  T min_cruise_altitude{8'839.2};
+  T max_cruise_altitude{12'496.8};
+  /// The separation between cruise levels, 1000 feet.
+  T cruise_level_step{304.8};
+
+  /// The shortest and longest cruise durations, the durations are
+  /// log-uniformly distributed to model a long-haul tail.
+  T min_cruise_duration{600};
+  T max_cruise_duration{36'000};
+
+  /// The CAS below the speed restriction altitude, 250 knots.
+  T restricted_cas{128.611};
+  /// The speed restriction altitude, FL100.
+  T restricted_altitude{3'048};
+  /// The range of CAS above the speed restriction altitude, 280 to 320 knots.
+  T min_cas{144.044};
+  T max_cas{164.622};
+  /// The range of climb, cruise and descent Mach numbers.
+  T min_mach{0.74};
+  T max_mach{0.84};
+
+  /// The rate of climb at sea level and at the cruise altitude.
+  T sea_level_climb_rate{12.5};
+  T cruise_climb_rate{5};
+  /// The rate of descent.
+  T descent_rate{11};
+
+  /// The standard deviation of the per flight ISA temperature deviation.
+  T delta_temperature_sigma{8};
+  /// The standard deviation of the temperature deviation random walk step.
+  T delta_temperature_drift{0.02};
+  /// The highest departure and arrival airport elevation.
+  T max_airport_elevation{600};
+  /// The standard deviation of the altitude sensor noise, default none.
+  T altitude_noise{0};
+};
+
+/// Synthetic flight profiles stored in columns.
+/// The samples of flight `i` are in the range [offsets[i], offsets[i + 1]).
+template <typename T>
+  requires std::floating_point<T>
+struct FlightProfiles {
+  /// The start index of each flight's samples, plus the total size.
+  std::vector<std::size_t> offsets{0};
+  /// The time since departure in seconds.
+  std::vector<T> time;
+  /// The pressure altitude in metres.
+  std::vector<T> altitude;
+  /// The Calibrated Air Speed in metres per second.
+  std::vector<T> cas;
+  /// The Mach number.
+  std::vector<T> mach;
+  /// The difference from ISA Sea level temperature in Kelvin.
+  std::vector<T> delta_temperature;
+  /// The flight phase.
+  std::vector<FlightPhase> phase;
+
+  /// @return the number of flights.
+  [[nodiscard]] auto flights() const noexcept -> std::size_t {
+    return offsets.size() - 1;
+  }
+
+  /// @return the total number of samples.
+  [[nodiscard]] auto size() const noexcept -> std::size_t {
+    return altitude.size();
+  }
+};
+
+/// Generate the profile of a single synthetic flight and append it to the
+/// profiles.
+/// The flight follows a CAS / Mach schedule in climb and descent: the
+/// restricted CAS below the speed restriction altitude, the scheduled CAS up
+/// to the crossover altitude and the scheduled Mach number above it.
+/// @param params the fleet parameters.
+/// @param index the index of the flight, used to seed its own generator.
+/// @param profiles the profiles to append the flight to.
+template <typename T>
+  requires std::floating_point<T>
+void generate_synthetic_flight(const FleetParameters<T> &params,
+                               const std::size_t index,
+                               FlightProfiles<T> &profiles) {
+  // Each flight has its own generator, so a flight does not depend upon the
+  // flights generated before it.
+  detail::SplitMix64 flight_rng{params.seed};
+  detail::SplitMix64 rng{flight_rng.next() ^
+                         (0xd1b5'4a32'd192'ed03ULL * (index + 1))};
+
+  const auto levels{static_cast<int>(
+      (params.max_cruise_altitude - params.min_cruise_altitude) /
+      params.cruise_level_step)};
+  const T cruise_altitude{
+      params.min_cruise_altitude +
+      params.cruise_level_step *
+          static_cast<T>(static_cast<int>(rng.uniform<T>() * T(levels + 1)))};
+  const T cruise_duration{
+      params.min_cruise_duration *
+      std::pow(params.max_cruise_duration / params.min_cruise_duration,
+               rng.uniform<T>())};
+  const auto cas{units::si::MetresPerSecond<T>(
+      rng.uniform(params.min_cas, params.max_cas))};
+  const T mach{rng.uniform(params.min_mach, params.max_mach)};
+  const T crossover_altitude{calculate_crossover_altitude(cas, mach).v()};
+  const T departure_elevation{rng.uniform(T(), params.max_airport_elevation)};
+  const T arrival_elevation{rng.uniform(T(), params.max_airport_elevation)};
+  T delta_temperature{params.delta_temperature_sigma * rng.normal<T>()};
+
+  const auto append_sample{[&](const T time, const T altitude,
+                               const FlightPhase phase) {
+    const auto sample_altitude{units::si::Metres<T>(
+        altitude + params.altitude_noise * rng.normal<T>())};
+    const auto delta{units::si::Kelvin<T>(delta_temperature)};
+    const auto pressure{calculate_isa_pressure(sample_altitude)};
+    const auto temperature{calculate_isa_temperature(sample_altitude, delta)};
+    const T sound_speed{speed_of_sound(temperature).v()};
+
+    T sample_cas{};
+    T sample_mach{mach};
+    if (altitude < crossover_altitude) {
+      sample_cas = (altitude < params.restricted_altitude) ? params.restricted_cas
+                                                           : cas.v();
+      sample_mach = calculate_true_air_speed(
+                        units::si::MetresPerSecond<T>(sample_cas), pressure,
+                        temperature)
+                        .v() /
+                    sound_speed;
+    } else {
+      sample_cas = calculate_calibrated_air_speed(
+                       mach_true_air_speed(mach, temperature), pressure,
+                       temperature)
+                       .v();
+    }
+
+    profiles.time.push_back(time);
+    profiles.altitude.push_back(sample_altitude.v());
+    profiles.cas.push_back(sample_cas);
+    profiles.mach.push_back(sample_mach);
+    profiles.delta_temperature.push_back(delta_temperature);
+    profiles.phase.push_back(phase);
+
+    delta_temperature += params.delta_temperature_drift * rng.normal<T>();
+  }};
+
+  const T dt{params.sample_period};
+  T time{};
+  T altitude{departure_elevation};
+
+  // Climb with a rate of climb that reduces linearly with altitude.
+  while (altitude < cruise_altitude) {
+    append_sample(time, altitude, FlightPhase::CLIMB);
+    const T ratio{altitude / cruise_altitude};
+    const T climb_rate{params.sea_level_climb_rate +
+                       ratio * (params.cruise_climb_rate -
+                                params.sea_level_climb_rate)};
+    altitude = std::min(altitude + climb_rate * dt, cruise_altitude);
+    time += dt;
+  }
+
+  // Cruise at a constant flight level.
+  const T cruise_end{time + cruise_duration};
+  for (; time < cruise_end; time += dt)
+    append_sample(time, cruise_altitude, FlightPhase::CRUISE);
+
+  // Descend at a constant rate of descent.
+  while (altitude > arrival_elevation) {
+    altitude = std::max(altitude - params.descent_rate * dt, arrival_elevation);
+    append_sample(time, altitude, FlightPhase::DESCENT);
+    time += dt;
+  }
+
+  profiles.offsets.push_back(profiles.altitude.size());
+}
+
+/// Generate a deterministic synthetic fleet of flight profiles.
+/// The same parameters always generate the same profiles.
+/// @param params the fleet parameters.
+/// @return the flight profiles of the fleet.
+template <typename T>
+  requires std::floating_point<T>
+[[nodiscard]] auto generate_synthetic_fleet(const FleetParameters<T> &params)
+    -> FlightProfiles<T> {
+  Expects(params.sample_period > T());
+  Expects(params.min_cruise_altitude <= params.max_cruise_altitude);
+  Expects(T() < params.min_cruise_duration);
+  Expects(params.min_cruise_duration <= params.max_cruise_duration);
+
+  FlightProfiles<T> profiles;
+  profiles.offsets.reserve(params.flights + 1);
+  for (std::size_t i{}; i < params.flights; ++i)
+    generate_synthetic_flight(params, i, profiles);
+
+  return profiles;
+}
+
+} // namespace isa
+} // namespace via
@@ -0,0 +1,340 @@
+#pragma once
+
+//////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2024 Ken Barker
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//////////////////////////////////////////////////////////////////////////////
+/// @file
+/// @brief Linearized propagation of uncertainties through the via::isa
+/// functions.
+///
+/// The variance of a function output y = f(x) of inputs x with covariance
+/// matrix S is approximated by: J S J', where J is the vector of the partial
+/// derivatives (sensitivities) of f at x.
+/// The sensitivities are calculated analytically, so the batch functions
+/// calculate the output values and variances in a single pass, at a small
+/// fraction of the cost of a Monte Carlo simulation.
+/// The approximation is good while the standard deviations of the inputs are
+/// small enough for f to be approximately linear over them, which is the
+/// case for typical air data sensor errors.
+//////////////////////////////////////////////////////////////////////////////
+#include "../isa.hpp"
+#include <algorithm>
+#include <array>
+#include <span>
+#include <utility>
+
+namespace via {
+namespace isa {
+namespace uncertainty {
+
+/// The number of distinct covariances between N inputs.
+template <std::size_t N> constexpr std::size_t COVARIANCES{N * (N - 1) / 2};
+
+/// Calculate the variance of a linearized function.
+/// @param sensitivities the partial derivatives of the function with respect
+/// to its inputs.
+/// @param variances the variances of the inputs.
+/// @param covariances the covariances of the inputs in the order: (0, 1),
+/// (0, 2), ... (1, 2), ..., default zero.
+/// @return the variance of the function.
+template <typename T, std::size_t N>
+  requires std::floating_point<T>
+[[nodiscard("Pure Function")]]
+constexpr auto linear_variance(const std::array<T, N> &sensitivities,
+                               const std::array<T, N> &variances,
+                               const std::array<T, COVARIANCES<N>> &covariances =
+                                   {}) noexcept -> T {
+  T variance{};
+  std::size_t k{};
+  for (std::size_t i{}; i < N; ++i) {
+    variance += sensitivities[i] * sensitivities[i] * variances[i];
+    for (std::size_t j{i + 1}; j < N; ++j)
+      variance += T(2) * sensitivities[i] * sensitivities[j] * covariances[k++];
+  }
+  return variance;
+}
+
+/// Calculate the ISA altitude corresponding to the given pressure, together
+/// with its sensitivity to pressure from the hydrostatic equation:
+/// dh/dp = -R T / (g p).
+/// @pre pressure > 0
+/// @param pressure the pressure in Pascals.
+/// @return the altitude in metres and its sensitivity to pressure.
+template <typename T>
+  requires std::floating_point<T>
+[[nodiscard("Pure Function")]]
+constexpr auto isa_altitude_sensitivities(const units::si::Pascals<T> pressure)
+    -> std::pair<units::si::Metres<T>, std::array<T, 1>> {
+  Expects(pressure.v() > T());
+
+  const auto altitude{calculate_isa_altitude(pressure)};
+  const auto temperature{calculate_isa_temperature(altitude)};
+  return {altitude, {-constants::R<T> * temperature.v() /
+                     (constants::g<T>.v() * pressure.v())}};
+}
+
+/// Calculate the air density given the air temperature and pressure,
+/// together with its sensitivities to pressure and temperature.
+/// @pre temperature > 0
+/// @param pressure the pressure in Pascals.
+/// @param temperature the temperature in Kelvin.
+/// @return the density in Kg per cubic metre and its sensitivities to
+/// pressure and temperature.
+template <typename T>
+  requires std::floating_point<T>
+[[nodiscard("Pure Function")]]
+constexpr auto density_sensitivities(const units::si::Pascals<T> pressure,
+                                     const units::si::Kelvin<T> temperature)
+    -> std::pair<units::si::KilogramsPerCubicMetre<T>, std::array<T, 2>> {
+  const auto density{calculate_density(pressure, temperature)};
+  return {density,
+          {density.v() / pressure.v(), -density.v() / temperature.v()}};
+}
+
+/// Calculate the True Air Speed (TAS) from the Calibrated Air Speed (CAS)
+/// at the given pressure and temperature, together with its sensitivities
+/// to CAS, pressure and temperature.
+/// The TAS is calculated in the same way as `isa::calculate_true_air_speed`.
+/// The sensitivities are zero where the TAS is zero, since the TAS is not
+/// differentiable there.
+/// @param cas the Calibrated Air Speed in metres per second.
+/// @param pressure the pressure in Pascals.
+/// @param temperature the temperature in Kelvin.
+/// @return the True Air Speed in metres per second and its sensitivities to
+/// CAS, pressure and temperature.
+template <typename T>
+  requires std::floating_point<T>
+[[nodiscard("Pure Function")]]
+constexpr auto
+true_air_speed_sensitivities(const units::si::MetresPerSecond<T> cas,
+                             const units::si::Pascals<T> pressure,
+                             const units::si::Kelvin<T> temperature)
+    -> std::pair<units::si::MetresPerSecond<T>, std::array<T, 3>> {
+  constexpr T INNER_FACTOR{U<T> / (T(2) * constants::R<T> *
+                                   constants::SEA_LEVEL_TEMPERATURE<T>.v())};
+  constexpr T OUTER_FACTOR{T(2) * constants::R<T> / U<T>};
+
+  const T cas_base{T(1) + INNER_FACTOR * cas.v() * cas.v()};
+  const T cas_factor{std::pow(cas_base, INV_U<T>) - T(1)};
+  const T pressure_base{T(1) + constants::SEA_LEVEL_PRESSURE<T>.v() *
+                                   cas_factor / pressure.v()};
+  const T pressure_power{std::pow(pressure_base, U<T>)};
+  const T cas_pressure_factor{pressure_power - T(1)};
+  const T tas{std::sqrt(OUTER_FACTOR * temperature.v() * cas_pressure_factor)};
+
+  // d(tas)/d(cas_pressure_factor)
+  const T d_factor{
+      (tas > T()) ? OUTER_FACTOR * temperature.v() / (T(2) * tas) : T()};
+  // d(cas_pressure_factor)/d(cas_factor)
+  const T d_cas_factor{U<T> * pressure_power / pressure_base *
+                       constants::SEA_LEVEL_PRESSURE<T>.v() / pressure.v()};
+  // d(cas_factor)/d(cas)
+  const T d_cas{INV_U<T> * (cas_factor + T(1)) / cas_base * T(2) *
+                INNER_FACTOR * cas.v()};
+
+  return {units::si::MetresPerSecond<T>(tas),
+          {d_factor * d_cas_factor * d_cas,
+           -d_factor * d_cas_factor * cas_factor / pressure.v(),
+           tas / (T(2) * temperature.v())}};
+}
+
+/// Calculate the True Air Speed (TAS) from the Mach number at the given
+/// temperature, together with its sensitivities to Mach number and
+/// temperature.
+/// @pre temperature > 0
+/// @param mach the Mach number.
+/// @param temperature the temperature in Kelvin.
+/// @return the True Air Speed in metres per second and its sensitivities to
+/// Mach number and temperature.
+template <typename T>
+  requires std::floating_point<T>
+[[nodiscard("Pure Function")]]
+constexpr auto
+mach_true_air_speed_sensitivities(const T mach,
+                                  const units::si::Kelvin<T> temperature)
+    -> std::pair<units::si::MetresPerSecond<T>, std::array<T, 2>> {
+  const T speed{speed_of_sound<T>(temperature).v()};
+  const T tas{mach * speed};
+  return {units::si::MetresPerSecond<T>(tas),
+          {speed, tas / (T(2) * temperature.v())}};
+}
+
+/// The covariances of the input columns of a batch function, in the order of
+/// the function arguments.
+/// Empty columns are zero, e.g. for inputs without errors or uncorrelated
+/// inputs.
+template <typename T, std::size_t N>
+  requires std::floating_point<T>
+struct Covariances {
+  /// The variances of each input.
+  std::array<std::span<const T>, N> variances{};
+  /// The covariances of each pair of inputs in the order: (0, 1), (0, 2),
+  /// ... (1, 2), ...
+  std::array<std::span<const T>, COVARIANCES<N>> covariances{};
+
+  /// @return the variances of the inputs at index i.
+  [[nodiscard]] constexpr auto variances_at(const std::size_t i) const noexcept
+      -> std::array<T, N> {
+    std::array<T, N> values{};
+    for (std::size_t j{}; j < N; ++j)
+      values[j] = variances[j].empty() ? T() : variances[j][i];
+    return values;
+  }
+
+  /// @return the covariances of the inputs at index i.
+  [[nodiscard]] constexpr auto
+  covariances_at(const std::size_t i) const noexcept
+      -> std::array<T, COVARIANCES<N>> {
+    std::array<T, COVARIANCES<N>> values{};
+    for (std::size_t j{}; j < COVARIANCES<N>; ++j)
+      values[j] = covariances[j].empty() ? T() : covariances[j][i];
+    return values;
+  }
+
+  /// @return true if the non-empty columns are all the given size.
+  [[nodiscard]] constexpr auto valid(const std::size_t size) const noexcept
+      -> bool {
+    const auto valid_size{[size](const auto &column) {
+      return column.empty() || (column.size() == size);
+    }};
+    return std::ranges::all_of(variances, valid_size) &&
+           std::ranges::all_of(covariances, valid_size);
+  }
+};
+
+/// Calculate the ISA altitudes corresponding to the given pressures and
+/// their variances.
+/// @param pressures the pressures in Pascals.
+/// @param covariances the variances of the pressures in Pascals squared.
+/// @param altitudes the pressure altitudes in metres.
+/// @param variances the variances of the altitudes in metres squared.
+template <typename T>
+  requires std::floating_point<T>
+constexpr void calculate_isa_altitude(std::span<const T> pressures,
+                                      const Covariances<T, 1> &covariances,
+                                      std::span<T> altitudes,
+                                      std::span<T> variances) {
+  Expects(covariances.valid(pressures.size()));
+  Expects(pressures.size() == altitudes.size());
+  Expects(pressures.size() == variances.size());
+
+  for (std::size_t i{}; i < pressures.size(); ++i) {
+    const auto [altitude, sensitivities]{
+        isa_altitude_sensitivities(units::si::Pascals<T>(pressures[i]))};
+    altitudes[i] = altitude.v();
+    variances[i] = linear_variance(sensitivities, covariances.variances_at(i),
+                                   covariances.covariances_at(i));
+  }
+}
+
+/// Calculate the air densities and their variances given the pressures and
+/// temperatures and their covariances.
+/// @param pressures the pressures in Pascals.
+/// @param temperatures the temperatures in Kelvin.
+/// @param covariances the covariances of the pressures and temperatures.
+/// @param densities the densities in Kg per cubic metre.
+/// @param variances the variances of the densities.
+template <typename T>
+  requires std::floating_point<T>
+constexpr void calculate_density(std::span<const T> pressures,
+                                 std::span<const T> temperatures,
+                                 const Covariances<T, 2> &covariances,
+                                 std::span<T> densities,
+                                 std::span<T> variances) {
+  Expects(pressures.size() == temperatures.size());
+  Expects(covariances.valid(pressures.size()));
+  Expects(pressures.size() == densities.size());
+  Expects(pressures.size() == variances.size());
+
+  for (std::size_t i{}; i < pressures.size(); ++i) {
+    const auto [density, sensitivities]{
+        density_sensitivities(units::si::Pascals<T>(pressures[i]),
+                              units::si::Kelvin<T>(temperatures[i]))};
+    densities[i] = density.v();
+    variances[i] = linear_variance(sensitivities, covariances.variances_at(i),
+                                   covariances.covariances_at(i));
+  }
+}
+
+/// Calculate the True Air Speeds and their variances from the Calibrated Air
+/// Speeds, pressures and temperatures and their covariances.
+/// @param cas the Calibrated Air Speeds in metres per second.
+/// @param pressures the pressures in Pascals.
+/// @param temperatures the temperatures in Kelvin.
+/// @param covariances the covariances of the Calibrated Air Speeds,
+/// pressures and temperatures.
+/// @param tas the True Air Speeds in metres per second.
+/// @param variances the variances of the True Air Speeds.
+template <typename T>
+  requires std::floating_point<T>
+constexpr void calculate_true_air_speed(std::span<const T> cas,
+                                        std::span<const T> pressures,
+                                        std::span<const T> temperatures,
+                                        const Covariances<T, 3> &covariances,
+                                        std::span<T> tas,
+                                        std::span<T> variances) {
+  Expects(cas.size() == pressures.size());
+  Expects(cas.size() == temperatures.size());
+  Expects(covariances.valid(cas.size()));
+  Expects(cas.size() == tas.size());
+  Expects(cas.size() == variances.size());
+
+  for (std::size_t i{}; i < cas.size(); ++i) {
+    const auto [speed, sensitivities]{true_air_speed_sensitivities(
+        units::si::MetresPerSecond<T>(cas[i]),
+        units::si::Pascals<T>(pressures[i]),
+        units::si::Kelvin<T>(temperatures[i]))};
+    tas[i] = speed.v();
+    variances[i] = linear_variance(sensitivities, covariances.variances_at(i),
+                                   covariances.covariances_at(i));
+  }
+}
+
+/// Calculate the True Air Speeds and their variances from the Mach numbers
+/// and temperatures and their covariances.
+/// @param machs the Mach numbers.
+/// @param temperatures the temperatures in Kelvin.
+/// @param covariances the covariances of the Mach numbers and temperatures.
+/// @param tas the True Air Speeds in metres per second.
+/// @param variances the variances of the True Air Speeds.
+template <typename T>
+  requires std::floating_point<T>
+constexpr void mach_true_air_speed(std::span<const T> machs,
+                                   std::span<const T> temperatures,
+                                   const Covariances<T, 2> &covariances,
+                                   std::span<T> tas, std::span<T> variances) {
+  Expects(machs.size() == temperatures.size());
+  Expects(covariances.valid(machs.size()));
+  Expects(machs.size() == tas.size());
+  Expects(machs.size() == variances.size());
+
+  for (std::size_t i{}; i < machs.size(); ++i) {
+    const auto [speed, sensitivities]{mach_true_air_speed_sensitivities(
+        machs[i], units::si::Kelvin<T>(temperatures[i]))};
+    tas[i] = speed.v();
+    variances[i] = linear_variance(sensitivities, covariances.variances_at(i),
+                                   covariances.covariances_at(i));
+  }
+}
+
+} // namespace uncertainty
+} // namespace isa
+} // namespace via
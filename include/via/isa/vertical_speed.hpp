@@ -0,0 +1,204 @@
+#pragma once
+
+//////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2024 Ken Barker
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//////////////////////////////////////////////////////////////////////////////
+/// @file
+/// @brief True vertical speeds and heights from pressure altitudes.
+///
+/// The pressure altitude rate of an aircraft is the rate at which it climbs
+/// through the ISA pressure levels. On a non-standard day, the distance
+/// between pressure levels is proportional to the actual temperature, so the
+/// true vertical speed is:
+///
+///     true_vertical_speed = altitude_rate * T / T_isa(pressure_altitude)
+///
+/// Since pressure altitudes are geopotential altitudes, this is the rate of
+/// change of geopotential height H. The profile functions integrate it into
+/// geopotential heights and convert them to geometric heights z, and the
+/// speeds to geometric vertical speeds, in the same loop as the
+/// temperatures:
+///
+///     dz/dt = dH/dt * (R / (R - H))^2
+///
+/// where R is the radius of the Earth, see `EARTH_RADIUS`.
+//////////////////////////////////////////////////////////////////////////////
+#include "../isa.hpp"
+#include <span>
+
+namespace via {
+namespace isa {
+
+/// The nominal radius of the Earth used to calculate geopotential
+/// altitudes, see ICAO Doc 7488/3, Table A.
+template <typename T>
+  requires std::floating_point<T>
+constexpr units::si::Metres<T> EARTH_RADIUS{6'356'766.0};
+
+/// Convert a geometric height to a geopotential height.
+/// See ICAO Doc 7488/3, Eq (8).
+/// @param height the geometric height in metres.
+/// @return the geopotential height in metres.
+template <typename T>
+  requires std::floating_point<T>
+[[nodiscard("Pure Function")]]
+constexpr auto geopotential_height(const units::si::Metres<T> height)
+    -> units::si::Metres<T> {
+  return units::si::Metres<T>(EARTH_RADIUS<T>.v() * height.v() /
+                              (EARTH_RADIUS<T>.v() + height.v()));
+}
+
+/// Convert a geopotential height to a geometric height.
+/// See ICAO Doc 7488/3, Eq (9).
+/// @param height the geopotential height in metres.
+/// @return the geometric height in metres.
+template <typename T>
+  requires std::floating_point<T>
+[[nodiscard("Pure Function")]]
+constexpr auto geometric_height(const units::si::Metres<T> height)
+    -> units::si::Metres<T> {
+  return units::si::Metres<T>(EARTH_RADIUS<T>.v() * height.v() /
+                              (EARTH_RADIUS<T>.v() - height.v()));
+}
+
+/// Calculate the true vertical speed from the pressure altitude rate.
+/// @pre temperature > 0
+/// @param altitude_rate the pressure altitude rate in metres per second.
+/// @param pressure_altitude the pressure altitude in metres.
+/// @param temperature the outside air temperature in Kelvin.
+/// @return the rate of change of geopotential height in metres per second.
+template <typename T>
+  requires std::floating_point<T>
+[[nodiscard("Pure Function")]]
+constexpr auto
+calculate_true_vertical_speed(const units::si::MetresPerSecond<T> altitude_rate,
+                              const units::si::Metres<T> pressure_altitude,
+                              const units::si::Kelvin<T> temperature)
+    -> units::si::MetresPerSecond<T> {
+  return units::si::MetresPerSecond<T>(
+      altitude_rate.v() * temperature.v() /
+      calculate_isa_temperature(pressure_altitude).v());
+}
+
+namespace detail {
+/// Calculate a true vertical profile with a function returning the
+/// temperature of each sample.
+template <typename T, typename Temperature>
+  requires std::floating_point<T>
+constexpr void calculate_true_vertical_profile(
+    std::span<const T> times, std::span<const T> pressure_altitudes,
+    std::span<const T> altitude_rates, Temperature &&temperature,
+    const units::si::Metres<T> initial_height, std::span<T> vertical_speeds,
+    std::span<T> heights) {
+  Expects(times.size() == pressure_altitudes.size());
+  Expects(times.size() == altitude_rates.size());
+  Expects(times.size() == vertical_speeds.size());
+  Expects(times.size() == heights.size());
+
+  constexpr T RADIUS{EARTH_RADIUS<T>.v()};
+  T height{geopotential_height(initial_height).v()};
+  T previous_time{};
+  T previous_speed{};
+  for (std::size_t i{}; i < times.size(); ++i) {
+    const auto altitude{units::si::Metres<T>(pressure_altitudes[i])};
+    const T speed{calculate_true_vertical_speed(
+                      units::si::MetresPerSecond<T>(altitude_rates[i]),
+                      altitude, temperature(i, altitude))
+                      .v()};
+    if (i)
+      height += T(0.5) * (speed + previous_speed) * (times[i] - previous_time);
+
+    // Convert the geopotential height and its rate to geometric values
+    const T ratio{RADIUS / (RADIUS - height)};
+    vertical_speeds[i] = speed * ratio * ratio;
+    heights[i] = ratio * height;
+    previous_time = times[i];
+    previous_speed = speed;
+  }
+}
+} // namespace detail
+
+/// Calculate the true vertical speeds and geometric heights of a flight
+/// from its pressure altitudes, pressure altitude rates and outside air
+/// temperatures.
+/// The heights are integrated from the vertical speeds with the trapezoidal
+/// rule.
+/// @pre the spans are the same size and the temperatures are positive.
+/// @param times the times of the samples in seconds.
+/// @param pressure_altitudes the pressure altitudes in metres.
+/// @param altitude_rates the pressure altitude rates in metres per second.
+/// @param temperatures the outside air temperatures in Kelvin.
+/// @param initial_height the geometric height of the first sample in
+/// metres.
+/// @param vertical_speeds the geometric true vertical speeds in metres per
+/// second.
+/// @param heights the geometric heights in metres.
+template <typename T>
+  requires std::floating_point<T>
+constexpr void calculate_true_vertical_profile(
+    std::span<const T> times, std::span<const T> pressure_altitudes,
+    std::span<const T> altitude_rates, std::span<const T> temperatures,
+    const units::si::Metres<T> initial_height, std::span<T> vertical_speeds,
+    std::span<T> heights) {
+  Expects(times.size() == temperatures.size());
+
+  detail::calculate_true_vertical_profile<T>(
+      times, pressure_altitudes, altitude_rates,
+      [temperatures](const std::size_t i, units::si::Metres<T>) {
+        return units::si::Kelvin<T>(temperatures[i]);
+      },
+      initial_height, vertical_speeds, heights);
+}
+
+/// Calculate the true vertical speeds and geometric heights of a flight
+/// from its pressure altitudes, pressure altitude rates and the difference
+/// from ISA temperature.
+/// The heights are integrated from the vertical speeds with the trapezoidal
+/// rule.
+/// @pre the spans are the same size.
+/// @param times the times of the samples in seconds.
+/// @param pressure_altitudes the pressure altitudes in metres.
+/// @param altitude_rates the pressure altitude rates in metres per second.
+/// @param delta_temperature the difference from ISA temperature at Sea
+/// level in Kelvin.
+/// @param initial_height the geometric height of the first sample in
+/// metres.
+/// @param vertical_speeds the geometric true vertical speeds in metres per
+/// second.
+/// @param heights the geometric heights in metres.
+template <typename T>
+  requires std::floating_point<T>
+constexpr void calculate_true_vertical_profile(
+    std::span<const T> times, std::span<const T> pressure_altitudes,
+    std::span<const T> altitude_rates,
+    const units::si::Kelvin<T> delta_temperature,
+    const units::si::Metres<T> initial_height, std::span<T> vertical_speeds,
+    std::span<T> heights) {
+  detail::calculate_true_vertical_profile<T>(
+      times, pressure_altitudes, altitude_rates,
+      [delta_temperature](std::size_t, const units::si::Metres<T> altitude) {
+        return calculate_isa_temperature(altitude, delta_temperature);
+      },
+      initial_height, vertical_speeds, heights);
+}
+
+} // namespace isa
+} // namespace via
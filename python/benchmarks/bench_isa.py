@@ -0,0 +1,428 @@
+#!/usr/bin/env python
+
+# Copyright (c) 2024 Ken Barker
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy
+# of this software and associated documentation files (the "Software"), to deal
+# in the Software without restriction, including without limitation the rights
+# to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+# copies of the Software, and to permit persons to whom the Software is
+# furnished to do so, subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included in all
+# copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+# AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+# OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+# SOFTWARE.
+
+"""Benchmarks of the via_isa Python bindings.
+
+The benchmarks only require the Python standard library and numpy.
+They measure:
+
+- scalar: the time per call of the scalar bindings;
+- array: the time per element of the numpy array bindings, for array sizes
+  from 1 to --max-size in powers of ten;
+- threads: the scaling of the array bindings over threads, since they release
+  the GIL;
+- memory: the peak memory allocated by a call of the array bindings.
+
+The results are written in the Google Benchmark JSON format, so runs can be
+compared with Google Benchmark's `compare.py` and the C++ benchmarks, e.g.:
+
+    python bench_isa.py --json baseline.json
+    python bench_isa.py --json contender.json
+    compare.py benchmarks baseline.json contender.json
+"""
+
+import argparse
+import concurrent.futures
+import datetime
+import json
+import os
+import platform
+import re
+import sys
+import time
+import tracemalloc
+
+import numpy as np
+import via_isa
+from via_units import Kelvin, Metres, MetresPerSecond, Pascals
+
+# The seed of the random number generator used to generate the inputs.
+SEED = 0x15A15A
+
+# The lowest and highest cruise altitudes in metres, FL290 and FL410.
+MIN_CRUISE_ALTITUDE = 8_839.2
+MAX_CRUISE_ALTITUDE = 12_496.8
+# The separation between cruise levels in metres, 1000 feet.
+CRUISE_LEVEL_STEP = 304.8
+# The fraction of samples in cruise.
+CRUISE_FRACTION = 0.8
+
+
+def generate_inputs(size):
+    """Generate air data inputs with a realistic altitude distribution.
+
+    Most samples are at cruise flight levels, the rest are climbing or
+    descending, like the C++ synthetic fleet generator.
+    """
+    rng = np.random.default_rng(SEED)
+    levels = int((MAX_CRUISE_ALTITUDE - MIN_CRUISE_ALTITUDE) / CRUISE_LEVEL_STEP)
+    cruise = MIN_CRUISE_ALTITUDE + CRUISE_LEVEL_STEP * rng.integers(
+        0, levels + 1, size
+    )
+    climb = rng.uniform(0.0, MAX_CRUISE_ALTITUDE, size)
+    altitudes = np.where(rng.uniform(size=size) < CRUISE_FRACTION, cruise, climb)
+
+    delta_temperatures = rng.normal(0.0, 8.0, size)
+    temperatures = via_isa.calculate_isa_temperature(altitudes, delta_temperatures)
+    return {
+        "altitudes": altitudes,
+        "pressures": via_isa.calculate_isa_pressure(altitudes),
+        "temperatures": temperatures,
+        "cas": rng.uniform(128.0, 165.0, size),
+        "machs": rng.uniform(0.74, 0.84, size),
+    }
+
+
+# The array bindings and the names of their inputs.
+ARRAY_FUNCTIONS = {
+    "calculate_isa_pressure": ("altitudes",),
+    "calculate_isa_altitude": ("pressures",),
+    "calculate_isa_temperature": ("altitudes",),
+    "calculate_density": ("pressures", "temperatures"),
+    "calculate_true_air_speed": ("cas", "pressures", "temperatures"),
+    "calculate_calibrated_air_speed": ("cas", "pressures", "temperatures"),
+    "speed_of_sound": ("temperatures",),
+    "mach_true_air_speed": ("machs", "temperatures"),
+    "calculate_crossover_altitude": ("cas", "machs"),
+}
+
+
+def noop(*_args):
+    """A function that does nothing, to measure the Python call overhead."""
+
+
+def scalar_functions():
+    """@return the scalar bindings and their arguments."""
+    altitude = Metres(9_144.0)
+    pressure = via_isa.calculate_isa_pressure(altitude)
+    temperature = via_isa.calculate_isa_temperature(altitude, Kelvin(0.0))
+    cas = MetresPerSecond(150.0)
+    return {
+        "python_call_baseline": (noop, (altitude,)),
+        "calculate_isa_pressure": (via_isa.calculate_isa_pressure, (altitude,)),
+        "calculate_isa_altitude": (via_isa.calculate_isa_altitude, (pressure,)),
+        "calculate_isa_temperature": (
+            via_isa.calculate_isa_temperature,
+            (altitude, Kelvin(0.0)),
+        ),
+        "calculate_density": (via_isa.calculate_density, (pressure, temperature)),
+        "calculate_true_air_speed": (
+            via_isa.calculate_true_air_speed,
+            (cas, pressure, temperature),
+        ),
+        "calculate_calibrated_air_speed": (
+            via_isa.calculate_calibrated_air_speed,
+            (cas, pressure, temperature),
+        ),
+        "speed_of_sound": (via_isa.speed_of_sound, (temperature,)),
+        "mach_true_air_speed": (via_isa.mach_true_air_speed, (0.8, temperature)),
+        "calculate_crossover_altitude": (
+            via_isa.calculate_crossover_altitude,
+            (cas, 0.8),
+        ),
+    }
+
+
+def measure(function, min_time, inner=1):
+    """Call function repeatedly for at least min_time seconds.
+
+    @param function the function to measure.
+    @param min_time the minimum measurement time in seconds.
+    @param inner the number of iterations performed by each call of function.
+    @return the iterations and the real and CPU times per iteration in ns.
+    """
+    calls = 1
+    while True:
+        real_start = time.perf_counter_ns()
+        cpu_start = time.process_time_ns()
+        for _ in range(calls):
+            function()
+        real_time = time.perf_counter_ns() - real_start
+        cpu_time = time.process_time_ns() - cpu_start
+        if real_time >= min_time * 1e9 or calls >= 1 << 30:
+            break
+        # Estimate the calls required, but at most increase them ten fold.
+        estimate = int(calls * 1.4 * min_time * 1e9 / max(real_time, 1))
+        calls = min(calls * 10, max(calls + 1, estimate))
+
+    iterations = calls * inner
+    return iterations, real_time / iterations, cpu_time / iterations
+
+
+class Results:
+    """Benchmark results in the Google Benchmark JSON format."""
+
+    def __init__(self):
+        self.benchmarks = []
+        # The number of instances of each benchmark family.
+        self.families = {}
+
+    def add(self, name, iterations, real_time, cpu_time, **counters):
+        family = name.rsplit("/", 1)[0] if "/" in name else name
+        families = list(self.families)
+        family_index = (
+            families.index(family) if family in families else len(families)
+        )
+        instance_index = self.families.get(family, 0)
+        self.families[family] = instance_index + 1
+        entry = {
+            "name": name,
+            "family_index": family_index,
+            "per_family_instance_index": instance_index,
+            "run_name": name,
+            "run_type": "iteration",
+            "repetitions": 1,
+            "repetition_index": 0,
+            "threads": counters.pop("threads", 1),
+            "iterations": iterations,
+            "real_time": real_time,
+            "cpu_time": cpu_time,
+            "time_unit": "ns",
+        }
+        entry.update(counters)
+        self.benchmarks.append(entry)
+
+        extra = " ".join(f"{k}={v:.4g}" for k, v in counters.items())
+        print(f"{name:<60} {real_time:>14.2f} ns {cpu_time:>14.2f} ns {extra}")
+
+    def to_json(self):
+        return {
+            "context": {
+                "date": datetime.datetime.now().astimezone().isoformat(),
+                "host_name": platform.node(),
+                "executable": sys.executable,
+                "num_cpus": os.cpu_count(),
+                "mhz_per_cpu": 0,
+                "cpu_scaling_enabled": False,
+                "caches": [],
+                "library_build_type": "release",
+                "python_version": platform.python_version(),
+                "numpy_version": np.__version__,
+                "via_isa": getattr(via_isa, "__file__", ""),
+            },
+            "benchmarks": self.benchmarks,
+        }
+
+
+def bench_scalar(results, args):
+    """Measure the time per call of the scalar bindings."""
+    inner = 100
+    for name, (function, arguments) in scalar_functions().items():
+        benchmark = f"scalar/{name}"
+        if not args.filter.search(benchmark):
+            continue
+
+        def calls(function=function, arguments=arguments):
+            for _ in range(inner):
+                function(*arguments)
+
+        iterations, real_time, cpu_time = measure(calls, args.min_time, inner)
+        results.add(benchmark, iterations, real_time, cpu_time)
+
+
+def array_sizes(max_size):
+    """@return the powers of ten from 1 to max_size."""
+    size = 1
+    while size <= max_size:
+        yield size
+        size *= 10
+
+
+def bench_array(results, args):
+    """Measure the time per element of the array bindings."""
+    for size in array_sizes(args.max_size):
+        inputs = generate_inputs(size)
+        for name, input_names in ARRAY_FUNCTIONS.items():
+            benchmark = f"array/{name}/{size}"
+            if not args.filter.search(benchmark):
+                continue
+
+            function = getattr(via_isa, name)
+            arguments = [inputs[n] for n in input_names]
+            iterations, real_time, cpu_time = measure(
+                lambda: function(*arguments), args.min_time
+            )
+            results.add(
+                benchmark,
+                iterations,
+                real_time,
+                cpu_time,
+                ns_per_element=real_time / size,
+                items_per_second=size * 1e9 / real_time,
+            )
+        del inputs
+
+
+def bench_threads(results, args):
+    """Measure the scaling of the array bindings over threads."""
+    size = min(args.max_size, args.thread_size)
+    inputs = generate_inputs(size)
+    for name in ("calculate_isa_pressure", "calculate_true_air_speed"):
+        function = getattr(via_isa, name)
+        arguments = [inputs[n] for n in ARRAY_FUNCTIONS[name]]
+        single_time = None
+        for threads in args.threads:
+            benchmark = f"threads/{name}/{size}/threads:{threads}"
+            if not args.filter.search(benchmark):
+                continue
+
+            bounds = np.linspace(0, size, threads + 1).astype(int)
+            slices = [
+                [a[bounds[i] : bounds[i + 1]] for a in arguments]
+                for i in range(threads)
+            ]
+            with concurrent.futures.ThreadPoolExecutor(threads) as executor:
+
+                def run():
+                    for future in [executor.submit(function, *s) for s in slices]:
+                        future.result()
+
+                iterations, real_time, cpu_time = measure(run, args.min_time)
+
+            if single_time is None:
+                single_time = real_time
+            results.add(
+                benchmark,
+                iterations,
+                real_time,
+                cpu_time,
+                threads=threads,
+                items_per_second=size * 1e9 / real_time,
+                speedup=single_time / real_time,
+            )
+
+
+def bench_memory(results, args):
+    """Measure the peak memory allocated by a call of the array bindings.
+
+    numpy reports its allocations to tracemalloc, so the peak is the memory
+    allocated by the bindings: ideally just the output array.
+    """
+    size = min(args.max_size, args.memory_size)
+    inputs = generate_inputs(size)
+    for name, input_names in ARRAY_FUNCTIONS.items():
+        benchmark = f"memory/{name}/{size}"
+        if not args.filter.search(benchmark):
+            continue
+
+        function = getattr(via_isa, name)
+        arguments = [inputs[n] for n in input_names]
+        tracemalloc.start()
+        real_start = time.perf_counter_ns()
+        cpu_start = time.process_time_ns()
+        result = function(*arguments)
+        real_time = time.perf_counter_ns() - real_start
+        cpu_time = time.process_time_ns() - cpu_start
+        _, peak = tracemalloc.get_traced_memory()
+        tracemalloc.stop()
+
+        results.add(
+            benchmark,
+            1,
+            real_time,
+            cpu_time,
+            bytes_peak=peak,
+            peak_per_output_byte=peak / result.nbytes,
+        )
+        del result
+
+    try:
+        import resource
+
+        # ru_maxrss is in kilobytes on Linux and bytes on macOS.
+        scale = 1 if sys.platform == "darwin" else 1024
+        max_rss = resource.getrusage(resource.RUSAGE_SELF).ru_maxrss * scale
+        results.add("memory/max_rss", 1, 0.0, 0.0, bytes_peak=max_rss)
+    except ImportError:
+        pass
+
+
+SUITES = {
+    "scalar": bench_scalar,
+    "array": bench_array,
+    "threads": bench_threads,
+    "memory": bench_memory,
+}
+
+
+def parse_arguments(argv):
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument(
+        "--suite",
+        choices=SUITES.keys(),
+        action="append",
+        help="the benchmark suite(s) to run, default all",
+    )
+    parser.add_argument(
+        "--filter", default="", help="a regular expression of benchmarks to run"
+    )
+    parser.add_argument(
+        "--max-size",
+        type=int,
+        default=10**8,
+        help="the largest array size, default 10^8",
+    )
+    parser.add_argument(
+        "--thread-size",
+        type=int,
+        default=10**7,
+        help="the array size of the thread scaling suite, default 10^7",
+    )
+    parser.add_argument(
+        "--memory-size",
+        type=int,
+        default=10**7,
+        help="the array size of the memory suite, default 10^7",
+    )
+    parser.add_argument(
+        "--threads",
+        type=int,
+        nargs="+",
+        default=sorted({1, 2, 4, os.cpu_count() or 1}),
+        help="the numbers of threads of the thread scaling suite",
+    )
+    parser.add_argument(
+        "--min-time",
+        type=float,
+        default=0.2,
+        help="the minimum time in seconds of each measurement",
+    )
+    parser.add_argument("--json", help="the file to write the JSON results to")
+    args = parser.parse_args(argv)
+    args.filter = re.compile(args.filter)
+    return args
+
+
+def main(argv=None):
+    args = parse_arguments(argv)
+    results = Results()
+    print(f"{'Benchmark':<60} {'Time':>17} {'CPU':>17}")
+    for suite in args.suite or SUITES.keys():
+        SUITES[suite](results, args)
+
+    if args.json:
+        with open(args.json, "w", encoding="utf-8") as file:
+            json.dump(results.to_json(), file, indent=2)
+
+
+if __name__ == "__main__":
+    main()
@@ -23,15 +23,22 @@
 #  @file test_units
 #  @brief Contains unit tests for the via units classes and constants.
 
+import sys
+
+import numpy as np
 import pytest
-from numpy.testing import assert_almost_equal
+from numpy.testing import assert_almost_equal, assert_array_almost_equal
 from via_units import Kelvin, KilogramsPerCubicMetre, Metres, MetresPerSecond, Pascals
-from via_isa import calculate_density, calculate_isa_altitude, calculate_isa_pressure, \
+from via_isa import Plan, calculate_density, calculate_isa_altitude, calculate_isa_pressure, \
 calculate_isa_temperature, calculate_calibrated_air_speed, calculate_true_air_speed, \
 mach_true_air_speed, speed_of_sound, calculate_crossover_altitude, \
+true_air_speed_mach, calculate_impact_pressure, calibrated_air_speed_mach, mach_calibrated_air_speed, \
 SEA_LEVEL_DENSITY, SEA_LEVEL_PRESSURE, SEA_LEVEL_TEMPERATURE, SEA_LEVEL_SPEED_OF_SOUND, \
 TROPOPAUSE_ALTITUDE, TROPOPAUSE_TEMPERATURE
 
+if sys.platform != "win32":
+    from via_isa import process_npy
+
 def test_calculate_isa_pressure():
     # calculate_troposphere_pressure
     result = calculate_isa_pressure(Metres(0.0))
@@ -144,5 +151,112 @@ def test_calculate_crossover_altitude():
     assert_almost_equal(tas_from_cas.v(), tas_from_mach.v(), 5)
     assert_almost_equal(239.75607215, tas_from_mach.v())
 
+def test_speed_conversions():
+    cas = MetresPerSecond(150.0)
+    pressure = Pascals(79495.202)
+    temperature = Kelvin(SEA_LEVEL_TEMPERATURE.v() - 13.0)
+    tas = calculate_true_air_speed(cas, pressure, temperature)
+
+    mach = calibrated_air_speed_mach(cas, pressure)
+    assert_almost_equal(tas.v() / speed_of_sound(temperature).v(), mach)
+    assert_almost_equal(mach, true_air_speed_mach(tas, temperature))
+    assert_almost_equal(cas.v(), mach_calibrated_air_speed(mach, pressure).v())
+    assert 0.0 == calculate_impact_pressure(MetresPerSecond(0.0)).v()
+
+    cas_array = np.array([100.0, 150.0, 200.0])
+    pressures = np.array([90000.0, 60000.0, 30000.0])
+    machs = calibrated_air_speed_mach(cas_array, pressures)
+    assert_array_almost_equal(cas_array, mach_calibrated_air_speed(machs, pressures))
+    temperatures = np.array([280.0, 260.0, 230.0])
+    tas_array = calculate_true_air_speed(cas_array, pressures, temperatures)
+    assert_array_almost_equal(machs, true_air_speed_mach(tas_array, temperatures))
+    assert_array_almost_equal([calculate_impact_pressure(MetresPerSecond(x)).v() for x in cas_array],
+                              calculate_impact_pressure(cas_array))
+
+def test_array_isa_functions():
+    altitudes = np.array([0.0, 1000.0, 2000.0, 10999.0, 12000.0])
+    pressures = calculate_isa_pressure(altitudes)
+    assert pressures.shape == altitudes.shape
+    assert_array_almost_equal([SEA_LEVEL_PRESSURE.v(), 89874.56291622, 79495.20193405,
+                               22635.60913586, 19330.38250807], pressures)
+    assert_array_almost_equal(altitudes, calculate_isa_altitude(pressures))
+
+    temperatures = calculate_isa_temperature(altitudes)
+    assert_array_almost_equal([SEA_LEVEL_TEMPERATURE.v(), SEA_LEVEL_TEMPERATURE.v() - 6.5,
+                               SEA_LEVEL_TEMPERATURE.v() - 13.0, 216.6565,
+                               TROPOPAUSE_TEMPERATURE.v()], temperatures)
+    assert_array_almost_equal(temperatures[:3] + 10.0,
+                              calculate_isa_temperature(altitudes, 10.0)[:3])
+    assert_array_almost_equal(temperatures[:3] + [1.0, 2.0, 3.0],
+                              calculate_isa_temperature(altitudes[:3], np.array([1.0, 2.0, 3.0])))
+
+    densities = calculate_density(pressures, temperatures)
+    assert_almost_equal(SEA_LEVEL_DENSITY.v(), densities[0])
+
+def test_array_air_speed_functions():
+    cas = np.array([150.0, 150.0])
+    pressures = np.array([SEA_LEVEL_PRESSURE.v(), 79495.202])
+    temperatures = np.array([SEA_LEVEL_TEMPERATURE.v(), SEA_LEVEL_TEMPERATURE.v() - 13.0])
+    tas = calculate_true_air_speed(cas, pressures, temperatures)
+    assert_array_almost_equal([150.0, 164.457894], tas)
+    assert_array_almost_equal(cas, calculate_calibrated_air_speed(tas, pressures, temperatures))
+
+    speeds = speed_of_sound(np.array([TROPOPAUSE_TEMPERATURE.v()]))
+    assert_almost_equal(295.0694935, speeds[0])
+    tas = mach_true_air_speed(np.array([0.85]), np.array([TROPOPAUSE_TEMPERATURE.v()]))
+    assert_almost_equal(0.85 * 295.0694935, tas[0])
+
+    altitudes = calculate_crossover_altitude(np.array([155.0]), np.array([0.79]))
+    assert_almost_equal(9070.813566, altitudes[0])
+
+    with pytest.raises(ValueError):
+        calculate_density(pressures, temperatures[:1])
+
+@pytest.mark.skipif(sys.platform == "win32", reason="process_npy requires POSIX memory mapping")
+def test_process_npy(tmp_path):
+    altitudes = np.linspace(0.0, 15000.0, 10_007)
+    np.save(tmp_path / "altitudes.npy", altitudes)
+    np.savez(tmp_path / "columns.npz", altitudes=altitudes)
+
+    process_npy("pressure", [str(tmp_path / "altitudes.npy")], str(tmp_path / "pressures.npy"),
+                chunk_size=1000, threads=4)
+    pressures = np.load(tmp_path / "pressures.npy", mmap_mode="r")
+    assert_array_almost_equal(calculate_isa_pressure(altitudes), pressures)
+
+    process_npy("temperature", [str(tmp_path / "columns.npz") + ":altitudes"],
+                str(tmp_path / "temperatures.npy"), chunk_size=1000)
+    temperatures = np.load(tmp_path / "temperatures.npy", mmap_mode="r")
+    assert_array_almost_equal(calculate_isa_temperature(altitudes), temperatures)
+
+    with pytest.raises(ValueError):
+        process_npy("density", [str(tmp_path / "altitudes.npy")], str(tmp_path / "densities.npy"))
+
+def test_plan():
+    altitudes = np.linspace(0.0, 15000.0, 10_007)
+    cas = np.full(altitudes.shape, 150.0)
+    plan = Plan(block_size=1000).pressure("alt").density().tas("cas")
+    assert ["alt", "cas"] == plan.inputs
+    assert ["pressure", "density", "tas"] == plan.outputs
+
+    results = plan.run({"alt": altitudes, "cas": cas}, threads=4)
+    pressures = calculate_isa_pressure(altitudes)
+    temperatures = calculate_isa_temperature(altitudes)
+    assert_array_almost_equal(pressures, results["pressure"])
+    assert_array_almost_equal(calculate_density(pressures, temperatures), results["density"])
+    assert_array_almost_equal(calculate_true_air_speed(cas, pressures, temperatures), results["tas"])
+
+    with pytest.raises(ValueError):
+        plan.pressure("alt")
+    with pytest.raises(ValueError):
+        plan.run({"alt": altitudes, "cas": cas[:10]})
+
+    # A duplicate output after a run does not change the plan
+    with pytest.raises(ValueError):
+        plan.tas("cas2", name="density")
+    assert ["alt", "cas"] == plan.inputs
+    assert ["pressure", "density", "tas"] == plan.outputs
+    results = plan.run({"alt": altitudes, "cas": cas})
+    assert_array_almost_equal(pressures, results["pressure"])
+
 if __name__ == '__main__':
     pytest.main()
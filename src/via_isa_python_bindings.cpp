@@ -23,7 +23,254 @@
 /// @brief Contains the via::isa python interface
 //////////////////////////////////////////////////////////////////////////////
 #include "via/isa.hpp"
+#include "via/isa/batch.hpp"
+#include "via/isa/plan.hpp"
+#include <pybind11/numpy.h>
 #include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+#include <functional>
+#include <map>
+#include <memory>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#ifndef _WIN32
+#include "via/isa/npy.hpp"
+#endif
+
+namespace py = pybind11;
+
+namespace {
+/// A contiguous array of doubles, other arrays are converted to it.
+using DoubleArray =
+    py::array_t<double, py::array::c_style | py::array::forcecast>;
+
+/// @return a span over the values of a DoubleArray.
+auto input_span(const DoubleArray &array) -> std::span<const double> {
+  return {array.data(), static_cast<std::size_t>(array.size())};
+}
+
+/// @return a new DoubleArray with the shape of the given array.
+auto output_array(const DoubleArray &array) -> DoubleArray {
+  return DoubleArray(
+      std::vector<py::ssize_t>(array.shape(), array.shape() + array.ndim()));
+}
+
+/// @return a span over the values of a new DoubleArray.
+auto output_span(DoubleArray &array) -> std::span<double> {
+  return {array.mutable_data(), static_cast<std::size_t>(array.size())};
+}
+
+/// Throw a ValueError if the arrays are not the same size.
+void check_sizes(const DoubleArray &a, const DoubleArray &b) {
+  if (a.size() != b.size())
+    throw std::invalid_argument("arrays must be the same size");
+}
+
+/// Apply a unary batch function to an array of values.
+template <typename Function>
+auto unary_batch(Function function, const DoubleArray &a) -> DoubleArray {
+  auto result{output_array(a)};
+  const auto a_span{input_span(a)};
+  const auto result_span{output_span(result)};
+  {
+    py::gil_scoped_release release;
+    function(a_span, result_span);
+  }
+  return result;
+}
+
+/// Apply a binary batch function to arrays of values.
+template <typename Function>
+auto binary_batch(Function function, const DoubleArray &a,
+                  const DoubleArray &b) -> DoubleArray {
+  check_sizes(a, b);
+  auto result{output_array(a)};
+  const auto a_span{input_span(a)};
+  const auto b_span{input_span(b)};
+  const auto result_span{output_span(result)};
+  {
+    py::gil_scoped_release release;
+    function(a_span, b_span, result_span);
+  }
+  return result;
+}
+
+/// Apply a ternary batch function to arrays of values.
+template <typename Function>
+auto ternary_batch(Function function, const DoubleArray &a,
+                   const DoubleArray &b, const DoubleArray &c)
+    -> DoubleArray {
+  check_sizes(a, b);
+  check_sizes(a, c);
+  auto result{output_array(a)};
+  const auto a_span{input_span(a)};
+  const auto b_span{input_span(b)};
+  const auto c_span{input_span(c)};
+  const auto result_span{output_span(result)};
+  {
+    py::gil_scoped_release release;
+    function(a_span, b_span, c_span, result_span);
+  }
+  return result;
+}
+
+/// A Plan and its Program, which is compiled when the Plan is first run.
+/// The Program is shared with the runs using it, so a builder function
+/// called by another Python thread during a run does not destroy it.
+struct PythonPlan {
+  via::isa::plan::Plan<double> plan;
+  std::shared_ptr<const via::isa::plan::Program<double>> program;
+  std::size_t block_size{via::isa::plan::DEFAULT_BLOCK_SIZE};
+};
+
+/// Invalidate the compiled Program and call a Plan builder function.
+/// The Program is reset first, so that it is never stale, even if the
+/// builder function throws.
+template <typename Function>
+auto build_plan(PythonPlan &self, Function function) -> PythonPlan & {
+  self.program.reset();
+  function(self.plan);
+  return self;
+}
+
+/// Run a Plan over columns of values.
+/// @param columns a mapping from input column names to arrays, e.g. a dict,
+/// a pandas DataFrame or a pyarrow Table.
+/// @return a dict of the output arrays.
+auto run_plan(PythonPlan &self, const py::object &columns,
+              const std::size_t threads) -> py::dict {
+  const auto &names{self.plan.inputs()};
+  if (names.empty())
+    throw std::invalid_argument("plan has no inputs");
+
+  std::vector<DoubleArray> arrays;
+  for (const auto &name : names)
+    arrays.push_back(py::cast<DoubleArray>(columns[py::str(name)]));
+  for (const auto &array : arrays)
+    check_sizes(arrays.front(), array);
+
+  std::vector<std::span<const double>> inputs;
+  for (const auto &array : arrays)
+    inputs.push_back(input_span(array));
+  const auto output_names{self.plan.outputs()};
+  std::vector<DoubleArray> results;
+  std::vector<std::span<double>> outputs;
+  for (std::size_t i{}; i < output_names.size(); ++i) {
+    results.push_back(output_array(arrays.front()));
+    outputs.push_back(output_span(results.back()));
+  }
+
+  if (!self.program)
+    self.program = std::make_shared<const via::isa::plan::Program<double>>(
+        self.plan.compile(self.block_size));
+  // Hold the Program, since a builder may reset it while the GIL is released
+  const auto program{self.program};
+  {
+    py::gil_scoped_release release;
+    program->run(inputs, outputs, threads);
+  }
+
+  py::dict result;
+  for (std::size_t i{}; i < results.size(); ++i)
+    result[py::str(output_names[i])] = results[i];
+  return result;
+}
+
+#ifndef _WIN32
+using Columns = std::span<const std::span<const double>>;
+
+/// The batch kernels available to process_npy, by name.
+/// Each kernel is called with the input columns of a chunk.
+const std::map<std::string, std::function<void(Columns, std::span<double>)>>
+    NPY_KERNELS{
+        {"pressure",
+         [](Columns in, std::span<double> out) {
+           via::isa::batch::calculate_isa_pressure(in[0], out);
+         }},
+        {"altitude",
+         [](Columns in, std::span<double> out) {
+           via::isa::batch::calculate_isa_altitude(in[0], out);
+         }},
+        {"temperature",
+         [](Columns in, std::span<double> out) {
+           if (in.size() > 1)
+             via::isa::batch::calculate_isa_temperature(in[0], in[1], out);
+           else
+             via::isa::batch::calculate_isa_temperature(in[0], 0.0, out);
+         }},
+        {"density",
+         [](Columns in, std::span<double> out) {
+           via::isa::batch::calculate_density(in[0], in[1], out);
+         }},
+        {"true_air_speed",
+         [](Columns in, std::span<double> out) {
+           via::isa::batch::calculate_true_air_speed(in[0], in[1], in[2], out);
+         }},
+        {"calibrated_air_speed",
+         [](Columns in, std::span<double> out) {
+           via::isa::batch::calculate_calibrated_air_speed(in[0], in[1], in[2],
+                                                           out);
+         }},
+        {"speed_of_sound",
+         [](Columns in, std::span<double> out) {
+           via::isa::batch::speed_of_sound(in[0], out);
+         }},
+        {"mach_true_air_speed",
+         [](Columns in, std::span<double> out) {
+           via::isa::batch::mach_true_air_speed(in[0], in[1], out);
+         }},
+        {"crossover_altitude", [](Columns in, std::span<double> out) {
+           via::isa::batch::calculate_crossover_altitude(in[0], in[1], out);
+         }}};
+
+/// The number of input columns of each process_npy kernel.
+const std::map<std::string, std::pair<std::size_t, std::size_t>> NPY_ARITY{
+    {"pressure", {1, 1}},
+    {"altitude", {1, 1}},
+    {"temperature", {1, 2}},
+    {"density", {2, 2}},
+    {"true_air_speed", {3, 3}},
+    {"calibrated_air_speed", {3, 3}},
+    {"speed_of_sound", {1, 1}},
+    {"mach_true_air_speed", {2, 2}},
+    {"crossover_altitude", {2, 2}}};
+
+/// Open an input column: a `.npy` file or a member of a `.npz` archive
+/// given as "archive.npz:member".
+auto open_npy_input(const std::string &input) -> via::isa::npy::Column {
+  const auto pos{input.rfind(".npz:")};
+  if (pos != std::string::npos)
+    return via::isa::npy::open_npz_column(input.substr(0, pos + 4),
+                                          input.substr(pos + 5));
+  return via::isa::npy::open_column(input);
+}
+
+/// Process `.npy` columns in chunks with a named batch kernel.
+void process_npy(const std::string &operation,
+                 const std::vector<std::string> &inputs,
+                 const std::string &output, const std::size_t chunk_size,
+                 const std::size_t threads) {
+  const auto kernel{NPY_KERNELS.find(operation)};
+  if (kernel == NPY_KERNELS.end())
+    throw std::invalid_argument("unknown operation: " + operation);
+  const auto [min_inputs, max_inputs]{NPY_ARITY.at(operation)};
+  if ((inputs.size() < min_inputs) || (max_inputs < inputs.size()))
+    throw std::invalid_argument("wrong number of inputs for " + operation);
+  if (chunk_size == 0)
+    throw std::invalid_argument("chunk_size must be positive");
+
+  py::gil_scoped_release release;
+  std::vector<via::isa::npy::Column> columns;
+  for (const auto &input : inputs)
+    columns.push_back(open_npy_input(input));
+  via::isa::npy::process_npy(columns, output, kernel->second,
+                             {.chunk_size = chunk_size, .threads = threads});
+}
+#endif
+} // namespace
 
 PYBIND11_MODULE(via_isa, m) {
   // Python bindings for ISA constants
@@ -67,9 +314,320 @@ PYBIND11_MODULE(via_isa, m) {
   m.def("mach_true_air_speed", &via::isa::mach_true_air_speed<double>,
         "Calculate the True Air Speed (TAS) from the Mach number at the given "
         "temperature.");
+  m.def("true_air_speed_mach", &via::isa::true_air_speed_mach<double>,
+        "Calculate the Mach number from the True Air Speed (TAS) at the given "
+        "temperature.");
+  m.def("calculate_impact_pressure",
+        &via::isa::calculate_impact_pressure<double>,
+        "Calculate the impact pressure corresponding to the Calibrated Air "
+        "Speed (CAS).");
+  m.def("calibrated_air_speed_mach",
+        &via::isa::calibrated_air_speed_mach<double>,
+        "Calculate the Mach number from the Calibrated Air Speed (CAS) at the "
+        "given pressure.");
+  m.def("mach_calibrated_air_speed",
+        &via::isa::mach_calibrated_air_speed<double>,
+        "Calculate the Calibrated Air Speed (CAS) from the Mach number at the "
+        "given pressure.");
   m.def("calculate_crossover_altitude",
         &via::isa::calculate_crossover_altitude<double>,
         "Calculate the crossover altitude at which the True Air Speeds (TAS) "
         "corresponding to the given Calibrated Air Speed (CAS) and Mach number "
         "are the same.");
+
+  // Python bindings for ISA functions over numpy arrays of SI values
+  m.def(
+      "calculate_isa_pressure",
+      [](const DoubleArray &altitudes) {
+        return unary_batch(via::isa::batch::calculate_isa_pressure<double>,
+                           altitudes);
+      },
+      "Calculate the ISA pressures in Pascals corresponding to an array of "
+      "altitudes in metres.");
+  m.def(
+      "calculate_isa_altitude",
+      [](const DoubleArray &pressures) {
+        return unary_batch(via::isa::batch::calculate_isa_altitude<double>,
+                           pressures);
+      },
+      "Calculate the ISA altitudes in metres corresponding to an array of "
+      "pressures in Pascals.");
+  m.def(
+      "calculate_isa_temperature",
+      [](const DoubleArray &altitudes, const double delta_temperature) {
+        return unary_batch(
+            [delta_temperature](auto altitudes_span, auto temperatures) {
+              via::isa::batch::calculate_isa_temperature<double>(
+                  altitudes_span, delta_temperature, temperatures);
+            },
+            altitudes);
+      },
+      py::arg("altitudes"), py::arg("delta_temperature") = 0.0,
+      "Calculate the ISA temperatures in Kelvin corresponding to an array of "
+      "altitudes in metres and a difference in Sea level temperature.");
+  m.def(
+      "calculate_isa_temperature",
+      [](const DoubleArray &altitudes, const DoubleArray &delta_temperatures) {
+        return binary_batch(
+            [](auto altitudes_span, auto deltas_span, auto temperatures) {
+              via::isa::batch::calculate_isa_temperature<double>(
+                  altitudes_span, deltas_span, temperatures);
+            },
+            altitudes, delta_temperatures);
+      },
+      "Calculate the ISA temperatures in Kelvin corresponding to arrays of "
+      "altitudes in metres and differences in Sea level temperature.");
+  m.def(
+      "calculate_density",
+      [](const DoubleArray &pressures, const DoubleArray &temperatures) {
+        return binary_batch(via::isa::batch::calculate_density<double>,
+                            pressures, temperatures);
+      },
+      "Calculate the air densities given arrays of air pressures and "
+      "temperatures.");
+  m.def(
+      "calculate_true_air_speed",
+      [](const DoubleArray &cas, const DoubleArray &pressures,
+         const DoubleArray &temperatures) {
+        return ternary_batch(via::isa::batch::calculate_true_air_speed<double>,
+                             cas, pressures, temperatures);
+      },
+      "Calculate the True Air Speeds (TAS) from arrays of Calibrated Air "
+      "Speeds (CAS), pressures and temperatures.");
+  m.def(
+      "calculate_calibrated_air_speed",
+      [](const DoubleArray &tas, const DoubleArray &pressures,
+         const DoubleArray &temperatures) {
+        return ternary_batch(
+            via::isa::batch::calculate_calibrated_air_speed<double>, tas,
+            pressures, temperatures);
+      },
+      "Calculate the Calibrated Air Speeds (CAS) from arrays of True Air "
+      "Speeds (TAS), pressures and temperatures.");
+  m.def(
+      "speed_of_sound",
+      [](const DoubleArray &temperatures) {
+        return unary_batch(via::isa::batch::speed_of_sound<double>,
+                           temperatures);
+      },
+      "Calculate the speeds of sound for an array of temperatures.");
+  m.def(
+      "mach_true_air_speed",
+      [](const DoubleArray &machs, const DoubleArray &temperatures) {
+        return binary_batch(via::isa::batch::mach_true_air_speed<double>,
+                            machs, temperatures);
+      },
+      "Calculate the True Air Speeds (TAS) from arrays of Mach numbers and "
+      "temperatures.");
+  m.def(
+      "true_air_speed_mach",
+      [](const DoubleArray &tas, const DoubleArray &temperatures) {
+        return binary_batch(via::isa::batch::true_air_speed_mach<double>, tas,
+                            temperatures);
+      },
+      "Calculate the Mach numbers from arrays of True Air Speeds (TAS) and "
+      "temperatures.");
+  m.def(
+      "calculate_impact_pressure",
+      [](const DoubleArray &cas) {
+        return unary_batch(via::isa::batch::calculate_impact_pressure<double>,
+                           cas);
+      },
+      "Calculate the impact pressures corresponding to an array of Calibrated "
+      "Air Speeds (CAS).");
+  m.def(
+      "calibrated_air_speed_mach",
+      [](const DoubleArray &cas, const DoubleArray &pressures) {
+        return binary_batch(
+            via::isa::batch::calibrated_air_speed_mach<double>, cas,
+            pressures);
+      },
+      "Calculate the Mach numbers from arrays of Calibrated Air Speeds (CAS) "
+      "and pressures.");
+  m.def(
+      "mach_calibrated_air_speed",
+      [](const DoubleArray &machs, const DoubleArray &pressures) {
+        return binary_batch(
+            via::isa::batch::mach_calibrated_air_speed<double>, machs,
+            pressures);
+      },
+      "Calculate the Calibrated Air Speeds (CAS) from arrays of Mach numbers "
+      "and pressures.");
+  m.def(
+      "calculate_crossover_altitude",
+      [](const DoubleArray &cas, const DoubleArray &machs) {
+        return binary_batch(
+            via::isa::batch::calculate_crossover_altitude<double>, cas, machs);
+      },
+      "Calculate the crossover altitudes for arrays of Calibrated Air Speeds "
+      "(CAS) and Mach numbers.");
+
+  // Python bindings for runtime composed computation plans
+  using OptionalName = std::optional<std::string>;
+  const auto name_or_current{
+      [](const OptionalName &name) { return name.value_or(std::string()); }};
+  py::class_<PythonPlan>(
+      m, "Plan",
+      "A computation plan of the ISA functions over named columns of SI "
+      "values, e.g.: Plan().pressure('alt').density().tas('cas').\n"
+      "Each function adds an output column, named after the function by "
+      "default. Input column arguments of None use the value most recently "
+      "calculated by the plan. The plan is compiled when it is first run and "
+      "evaluated in cache sized blocks on multiple threads.")
+      .def(py::init([](const std::size_t block_size) {
+             if (block_size == 0)
+               throw std::invalid_argument("block_size must be positive");
+             return PythonPlan{{}, std::nullopt, block_size};
+           }),
+           py::arg("block_size") = via::isa::plan::DEFAULT_BLOCK_SIZE)
+      .def(
+          "pressure",
+          [=](PythonPlan &self, const OptionalName &altitude,
+              const std::string &name) -> PythonPlan & {
+            return build_plan(self, [&](auto &plan) {
+              plan.pressure(name_or_current(altitude), name);
+            });
+          },
+          py::arg("altitude") = py::none(), py::arg("name") = "pressure",
+          py::return_value_policy::reference_internal,
+          "Calculate ISA pressures from altitudes.")
+      .def(
+          "altitude",
+          [=](PythonPlan &self, const OptionalName &pressure,
+              const std::string &name) -> PythonPlan & {
+            return build_plan(self, [&](auto &plan) {
+              plan.altitude(name_or_current(pressure), name);
+            });
+          },
+          py::arg("pressure") = py::none(), py::arg("name") = "altitude",
+          py::return_value_policy::reference_internal,
+          "Calculate ISA altitudes from pressures.")
+      .def(
+          "temperature",
+          [=](PythonPlan &self, const OptionalName &altitude,
+              const OptionalName &delta_temperature,
+              const std::string &name) -> PythonPlan & {
+            return build_plan(self, [&](auto &plan) {
+              plan.temperature(name_or_current(altitude),
+                               name_or_current(delta_temperature), name);
+            });
+          },
+          py::arg("altitude") = py::none(),
+          py::arg("delta_temperature") = py::none(),
+          py::arg("name") = "temperature",
+          py::return_value_policy::reference_internal,
+          "Calculate ISA temperatures from altitudes and, optionally, "
+          "differences in Sea level temperature.")
+      .def(
+          "density",
+          [=](PythonPlan &self, const OptionalName &pressure,
+              const OptionalName &temperature,
+              const std::string &name) -> PythonPlan & {
+            return build_plan(self, [&](auto &plan) {
+              plan.density(name_or_current(pressure),
+                           name_or_current(temperature), name);
+            });
+          },
+          py::arg("pressure") = py::none(), py::arg("temperature") = py::none(),
+          py::arg("name") = "density",
+          py::return_value_policy::reference_internal,
+          "Calculate air densities from pressures and temperatures.")
+      .def(
+          "tas",
+          [=](PythonPlan &self, const std::string &cas,
+              const OptionalName &pressure, const OptionalName &temperature,
+              const std::string &name) -> PythonPlan & {
+            return build_plan(self, [&](auto &plan) {
+              plan.true_air_speed(cas, name_or_current(pressure),
+                                  name_or_current(temperature), name);
+            });
+          },
+          py::arg("cas") = "cas", py::arg("pressure") = py::none(),
+          py::arg("temperature") = py::none(), py::arg("name") = "tas",
+          py::return_value_policy::reference_internal,
+          "Calculate True Air Speeds from Calibrated Air Speeds, pressures and "
+          "temperatures.")
+      .def(
+          "cas",
+          [=](PythonPlan &self, const OptionalName &tas,
+              const OptionalName &pressure, const OptionalName &temperature,
+              const std::string &name) -> PythonPlan & {
+            return build_plan(self, [&](auto &plan) {
+              plan.calibrated_air_speed(name_or_current(tas),
+                                        name_or_current(pressure),
+                                        name_or_current(temperature), name);
+            });
+          },
+          py::arg("tas") = py::none(), py::arg("pressure") = py::none(),
+          py::arg("temperature") = py::none(), py::arg("name") = "cas",
+          py::return_value_policy::reference_internal,
+          "Calculate Calibrated Air Speeds from True Air Speeds, pressures and "
+          "temperatures.")
+      .def(
+          "speed_of_sound",
+          [=](PythonPlan &self, const OptionalName &temperature,
+              const std::string &name) -> PythonPlan & {
+            return build_plan(self, [&](auto &plan) {
+              plan.speed_of_sound(name_or_current(temperature), name);
+            });
+          },
+          py::arg("temperature") = py::none(),
+          py::arg("name") = "speed_of_sound",
+          py::return_value_policy::reference_internal,
+          "Calculate speeds of sound from temperatures.")
+      .def(
+          "mach_tas",
+          [=](PythonPlan &self, const std::string &mach,
+              const OptionalName &temperature,
+              const std::string &name) -> PythonPlan & {
+            return build_plan(self, [&](auto &plan) {
+              plan.mach_true_air_speed(mach, name_or_current(temperature),
+                                       name);
+            });
+          },
+          py::arg("mach") = "mach", py::arg("temperature") = py::none(),
+          py::arg("name") = "tas", py::return_value_policy::reference_internal,
+          "Calculate True Air Speeds from Mach numbers and temperatures.")
+      .def(
+          "crossover_altitude",
+          [](PythonPlan &self, const std::string &cas, const std::string &mach,
+             const std::string &name) -> PythonPlan & {
+            return build_plan(self, [&](auto &plan) {
+              plan.crossover_altitude(cas, mach, name);
+            });
+          },
+          py::arg("cas") = "cas", py::arg("mach") = "mach",
+          py::arg("name") = "crossover_altitude",
+          py::return_value_policy::reference_internal,
+          "Calculate crossover altitudes from Calibrated Air Speeds and Mach "
+          "numbers.")
+      .def_property_readonly(
+          "inputs", [](const PythonPlan &self) { return self.plan.inputs(); },
+          "The names of the input columns.")
+      .def_property_readonly(
+          "outputs",
+          [](const PythonPlan &self) { return self.plan.outputs(); },
+          "The names of the output columns.")
+      .def("run", &run_plan, py::arg("columns"), py::arg("threads") = 0,
+           "Run the plan over columns of float64 values: a mapping from input "
+           "column names to arrays, e.g. a dict of numpy arrays, a pandas "
+           "DataFrame or a pyarrow Table.\n"
+           "Returns a dict of the output arrays.");
+
+#ifndef _WIN32
+  // Python binding for out-of-core processing of .npy files
+  m.def("process_npy", &process_npy, py::arg("operation"), py::arg("inputs"),
+        py::arg("output"),
+        py::arg("chunk_size") = via::isa::npy::DEFAULT_CHUNK_SIZE,
+        py::arg("threads") = 0,
+        "Process memory mapped .npy files of float64 values in chunks with a "
+        "batch function, writing the result to a new memory mapped .npy "
+        "file.\n"
+        "operation: one of pressure, altitude, temperature, density, "
+        "true_air_speed, calibrated_air_speed, speed_of_sound, "
+        "mach_true_air_speed or crossover_altitude.\n"
+        "inputs: the paths of the input .npy files, in the order of the batch "
+        "function arguments; a member of a .npz archive is given as "
+        "'archive.npz:member'.");
+#endif
 }
@@ -0,0 +1,160 @@
+//////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2024 Ken Barker
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+/// @file
+/// @brief Contains tests for the air data computer functions.
+//////////////////////////////////////////////////////////////////////////////
+#include "via/isa/air_data.hpp"
+#include <boost/test/unit_test.hpp>
+#include <vector>
+
+using namespace via::isa;
+using namespace via::units::si;
+
+namespace {
+const double CALCULATION_TOLERANCE(1.0e-9);
+
+/// The measurements of a flight condition.
+struct Measurements {
+  double static_pressure;
+  double impact_pressure;
+  double total_temperature;
+};
+
+/// Calculate the measurements of an altitude, CAS and temperature deviation.
+auto measure(const double altitude, const double cas, const double delta,
+             const double recovery_factor = 1.0) -> Measurements {
+  const auto pressure{calculate_isa_pressure(Metres<double>(altitude))};
+  const auto temperature{
+      calculate_isa_temperature(Metres<double>(altitude), Kelvin<double>(delta))};
+  const double mach{
+      calibrated_air_speed_mach(MetresPerSecond<double>(cas), pressure)};
+  return Measurements{
+      pressure.v(), calculate_impact_pressure(MetresPerSecond<double>(cas)).v(),
+      temperature.v() * (1.0 + recovery_factor * 0.2 * mach * mach)};
+}
+} // namespace
+
+//////////////////////////////////////////////////////////////////////////////
+BOOST_AUTO_TEST_SUITE(Test_air_data_double)
+
+//////////////////////////////////////////////////////////////////////////////
+BOOST_AUTO_TEST_CASE(test_impact_pressure_conversions) {
+  for (const double cas : {0.0, 50.0, 150.0, 250.0}) {
+    const auto qc{calculate_impact_pressure(MetresPerSecond<double>(cas))};
+    BOOST_CHECK_SMALL(cas - impact_pressure_calibrated_air_speed(qc).v(),
+                      1e-9);
+  }
+
+  const auto pressure{Pascals<double>(30000.0)};
+  for (const double cas : {50.0, 150.0, 200.0}) {
+    const auto qc{calculate_impact_pressure(MetresPerSecond<double>(cas))};
+    BOOST_CHECK_CLOSE(
+        calibrated_air_speed_mach(MetresPerSecond<double>(cas), pressure),
+        impact_pressure_mach(qc, pressure), CALCULATION_TOLERANCE);
+  }
+
+  // At Mach 1 the total temperature is 20% higher
+  BOOST_CHECK_CLOSE(
+      250.0,
+      calculate_static_air_temperature(Kelvin<double>(300.0), 1.0).v(),
+      CALCULATION_TOLERANCE);
+  BOOST_CHECK_EQUAL(
+      300.0, calculate_static_air_temperature(Kelvin<double>(300.0), 0.0).v());
+}
+//////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////
+BOOST_AUTO_TEST_CASE(test_calculate_air_data) {
+  for (const double altitude : {0.0, 3000.0, 10000.0, 12000.0})
+    for (const double delta : {-10.0, 0.0, 15.0}) {
+      const double cas{140.0};
+      const auto m{measure(altitude, cas, delta, 0.98)};
+      const auto air_data{calculate_air_data(
+          Pascals<double>(m.static_pressure),
+          Pascals<double>(m.impact_pressure),
+          Kelvin<double>(m.total_temperature), 0.98)};
+
+      const auto temperature{calculate_isa_temperature(
+          Metres<double>(altitude), Kelvin<double>(delta))};
+      BOOST_CHECK_SMALL(altitude - air_data.pressure_altitude.v(), 1e-6);
+      BOOST_CHECK_CLOSE(cas, air_data.cas.v(), CALCULATION_TOLERANCE);
+      BOOST_CHECK_CLOSE(calibrated_air_speed_mach(
+                            MetresPerSecond<double>(cas),
+                            Pascals<double>(m.static_pressure)),
+                        air_data.mach, CALCULATION_TOLERANCE);
+      BOOST_CHECK_CLOSE(temperature.v(), air_data.static_temperature.v(),
+                        CALCULATION_TOLERANCE);
+      BOOST_CHECK_CLOSE(calculate_true_air_speed(
+                            MetresPerSecond<double>(cas),
+                            Pascals<double>(m.static_pressure), temperature)
+                            .v(),
+                        air_data.tas.v(), CALCULATION_TOLERANCE);
+    }
+
+  // Stationary
+  const auto stationary{calculate_air_data(
+      Pascals<double>(101325.0), Pascals<double>(0.0), Kelvin<double>(288.15))};
+  BOOST_CHECK_EQUAL(0.0, stationary.cas.v());
+  BOOST_CHECK_EQUAL(0.0, stationary.mach);
+  BOOST_CHECK_EQUAL(288.15, stationary.static_temperature.v());
+  BOOST_CHECK_EQUAL(0.0, stationary.tas.v());
+}
+//////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////
+BOOST_AUTO_TEST_CASE(test_batch_air_data) {
+  std::vector<double> static_pressures;
+  std::vector<double> impact_pressures;
+  std::vector<double> total_temperatures;
+  for (const double altitude : {500.0, 4000.0, 8000.0, 11000.0, 13000.0}) {
+    const auto m{measure(altitude, 120.0 + altitude / 100.0, 5.0)};
+    static_pressures.push_back(m.static_pressure);
+    impact_pressures.push_back(m.impact_pressure);
+    total_temperatures.push_back(m.total_temperature);
+  }
+
+  const auto size{static_pressures.size()};
+  std::vector<double> altitudes(size);
+  std::vector<double> cas(size);
+  std::vector<double> machs(size);
+  std::vector<double> temperatures(size);
+  std::vector<double> tas(size);
+  calculate_air_data<double>(static_pressures, impact_pressures,
+                             total_temperatures,
+                             {altitudes, cas, machs, temperatures, tas});
+
+  for (std::size_t i{}; i < size; ++i) {
+    const auto expected{calculate_air_data(
+        Pascals<double>(static_pressures[i]),
+        Pascals<double>(impact_pressures[i]),
+        Kelvin<double>(total_temperatures[i]))};
+    BOOST_CHECK_EQUAL(expected.pressure_altitude.v(), altitudes[i]);
+    BOOST_CHECK_EQUAL(expected.cas.v(), cas[i]);
+    BOOST_CHECK_EQUAL(expected.mach, machs[i]);
+    BOOST_CHECK_EQUAL(expected.static_temperature.v(), temperatures[i]);
+    BOOST_CHECK_EQUAL(expected.tas.v(), tas[i]);
+  }
+}
+//////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_SUITE_END()
+//////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,159 @@
+//////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2024 Ken Barker
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+/// @file
+/// @brief Contains tests for the Atmosphere classes.
+//////////////////////////////////////////////////////////////////////////////
+#include "via/isa/atmosphere.hpp"
+#include <boost/test/unit_test.hpp>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+using namespace via::isa;
+using namespace via::units::si;
+
+namespace {
+const double CALCULATION_TOLERANCE(1.0e-9);
+} // namespace
+
+//////////////////////////////////////////////////////////////////////////////
+BOOST_AUTO_TEST_SUITE(Test_atmosphere_double)
+
+//////////////////////////////////////////////////////////////////////////////
+BOOST_AUTO_TEST_CASE(test_standard_atmosphere) {
+  const Atmosphere<double> atmosphere;
+  BOOST_CHECK_EQUAL(101325.0, atmosphere.qnh().v());
+  BOOST_CHECK_EQUAL(0.0, atmosphere.delta_temperature().v());
+
+  const auto altitude{Metres<double>(3000.0)};
+  BOOST_CHECK_SMALL(3000.0 - atmosphere.pressure_altitude(altitude).v(), 1e-9);
+  BOOST_CHECK_EQUAL(calculate_isa_pressure(altitude).v(),
+                    atmosphere.pressure(altitude).v());
+  BOOST_CHECK_EQUAL(calculate_isa_temperature(altitude).v(),
+                    atmosphere.temperature(altitude).v());
+}
+//////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////
+BOOST_AUTO_TEST_CASE(test_non_standard_atmosphere) {
+  const auto qnh{Pascals<double>(99000.0)};
+  const auto delta{Kelvin<double>(-15.0)};
+  const Atmosphere<double> atmosphere(qnh, delta);
+
+  // QNH altitude zero is the pressure altitude of QNH
+  BOOST_CHECK_CLOSE(calculate_isa_altitude(qnh).v(),
+                    atmosphere.pressure_altitude(Metres<double>(0.0)).v(),
+                    CALCULATION_TOLERANCE);
+  BOOST_CHECK_EQUAL(atmosphere.offset().v(),
+                    atmosphere.pressure_altitude(Metres<double>(0.0)).v());
+  BOOST_CHECK_CLOSE(atmosphere.offset().v() + atmosphere.factor() * 1000.0,
+                    atmosphere.pressure_altitude(Metres<double>(1000.0)).v(),
+                    CALCULATION_TOLERANCE);
+
+  // The pressure at a QNH altitude is the pressure of the altimeter setting
+  for (const double h : {0.0, 1000.0, 5000.0, 10000.0}) {
+    const auto pressure_altitude{
+        atmosphere.pressure_altitude(Metres<double>(h))};
+    const double pressure{atmosphere.pressure(pressure_altitude).v()};
+    const double expected{calculate_isa_pressure(Metres<double>(h)).v() *
+                          qnh.v() / 101325.0};
+    BOOST_CHECK_CLOSE(expected, pressure, CALCULATION_TOLERANCE);
+    BOOST_CHECK_CLOSE(h + 1.0,
+                      atmosphere.qnh_altitude(pressure_altitude).v() + 1.0,
+                      CALCULATION_TOLERANCE);
+  }
+
+  const auto altitude{Metres<double>(6000.0)};
+  const auto temperature{calculate_isa_temperature(altitude, delta)};
+  BOOST_CHECK_EQUAL(temperature.v(), atmosphere.temperature(altitude).v());
+  BOOST_CHECK_EQUAL(
+      calculate_density(calculate_isa_pressure(altitude), temperature).v(),
+      atmosphere.density(altitude).v());
+
+  const auto cas{MetresPerSecond<double>(150.0)};
+  const auto tas{atmosphere.true_air_speed(cas, altitude)};
+  BOOST_CHECK_EQUAL(
+      calculate_true_air_speed(cas, calculate_isa_pressure(altitude),
+                               temperature)
+          .v(),
+      tas.v());
+  BOOST_CHECK_CLOSE(cas.v(), atmosphere.calibrated_air_speed(tas, altitude).v(),
+                    1e-6);
+}
+//////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////
+BOOST_AUTO_TEST_CASE(test_atmosphere_handle) {
+  AtmosphereHandle<double> handle;
+  BOOST_CHECK_EQUAL(0u, handle.epoch());
+  BOOST_CHECK_EQUAL(101325.0, handle.read()->qnh().v());
+
+  handle.update(Atmosphere<double>(Pascals<double>(100000.0)));
+  BOOST_CHECK_EQUAL(1u, handle.epoch());
+  BOOST_CHECK_EQUAL(100000.0, handle.read()->qnh().v());
+}
+//////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////
+BOOST_AUTO_TEST_CASE(test_atmosphere_handle_concurrent) {
+  constexpr int UPDATES{200};
+  AtmosphereHandle<double> handle(
+      Atmosphere<double>(Pascals<double>(100000.0), Kelvin<double>(0.0)));
+
+  // The delta temperature of each Atmosphere equals its QNH above 100000 Pa,
+  // so a reader can detect a torn or deleted model.
+  std::atomic<bool> stop{false};
+  std::atomic<bool> inconsistent{false};
+  std::atomic<bool> decreasing{false};
+  std::vector<std::jthread> readers;
+  for (int r{}; r < 4; ++r)
+    readers.emplace_back([&] {
+      double previous{};
+      while (!stop.load()) {
+        const auto atmosphere{handle.read()};
+        const double qnh{atmosphere->qnh().v()};
+        const double delta{atmosphere->delta_temperature().v()};
+        if (delta != qnh - 100000.0)
+          inconsistent.store(true);
+        if (qnh < previous)
+          decreasing.store(true);
+        previous = qnh;
+      }
+    });
+
+  for (int i{1}; i <= UPDATES; ++i) {
+    handle.update(Atmosphere<double>(Pascals<double>(100000.0 + i),
+                                     Kelvin<double>(i)));
+    // An update is visible to the next read
+    BOOST_CHECK_EQUAL(100000.0 + i, handle.read()->qnh().v());
+  }
+  stop.store(true);
+  readers.clear();
+
+  BOOST_CHECK(!inconsistent.load());
+  BOOST_CHECK(!decreasing.load());
+  BOOST_CHECK_EQUAL(static_cast<std::uint64_t>(UPDATES), handle.epoch());
+}
+//////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_SUITE_END()
+//////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,138 @@
+//////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2024 Ken Barker
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+/// @file
+/// @brief Contains tests for the via::isa::batch namespace.
+//////////////////////////////////////////////////////////////////////////////
+#include "via/isa/batch.hpp"
+#include "via/isa/synthetic_fleet.hpp"
+#include <boost/test/unit_test.hpp>
+
+using namespace via::isa;
+using namespace via::units::si;
+
+//////////////////////////////////////////////////////////////////////////////
+BOOST_AUTO_TEST_SUITE(Test_batch_double)
+
+//////////////////////////////////////////////////////////////////////////////
+BOOST_AUTO_TEST_CASE(test_batch_isa_functions) {
+  FleetParameters<double> params;
+  params.flights = 10;
+  const auto fleet{generate_synthetic_fleet(params)};
+  const auto n{fleet.size()};
+
+  std::vector<double> pressures(n);
+  batch::calculate_isa_pressure<double>(fleet.altitude, pressures);
+  std::vector<double> altitudes(n);
+  batch::calculate_isa_altitude<double>(pressures, altitudes);
+  std::vector<double> temperatures(n);
+  batch::calculate_isa_temperature<double>(
+      fleet.altitude, fleet.delta_temperature, temperatures);
+  std::vector<double> isa_temperatures(n);
+  batch::calculate_isa_temperature<double>(fleet.altitude, 0.0,
+                                           isa_temperatures);
+  std::vector<double> densities(n);
+  batch::calculate_density<double>(pressures, temperatures, densities);
+
+  for (std::size_t i{}; i < n; ++i) {
+    const auto altitude{Metres<double>(fleet.altitude[i])};
+    const auto pressure{calculate_isa_pressure(altitude)};
+    const auto temperature{calculate_isa_temperature(
+        altitude, Kelvin<double>(fleet.delta_temperature[i]))};
+    BOOST_CHECK_EQUAL(pressure.v(), pressures[i]);
+    BOOST_CHECK_EQUAL(calculate_isa_altitude(pressure).v(), altitudes[i]);
+    BOOST_CHECK_EQUAL(temperature.v(), temperatures[i]);
+    BOOST_CHECK_EQUAL(calculate_isa_temperature(altitude).v(),
+                      isa_temperatures[i]);
+    BOOST_CHECK_EQUAL(calculate_density(pressure, temperature).v(),
+                      densities[i]);
+  }
+}
+//////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////
+BOOST_AUTO_TEST_CASE(test_batch_air_speed_functions) {
+  FleetParameters<double> params;
+  params.flights = 10;
+  const auto fleet{generate_synthetic_fleet(params)};
+  const auto n{fleet.size()};
+
+  std::vector<double> pressures(n);
+  batch::calculate_isa_pressure<double>(fleet.altitude, pressures);
+  std::vector<double> temperatures(n);
+  batch::calculate_isa_temperature<double>(
+      fleet.altitude, fleet.delta_temperature, temperatures);
+
+  std::vector<double> tas(n);
+  batch::calculate_true_air_speed<double>(fleet.cas, pressures, temperatures,
+                                          tas);
+  std::vector<double> cas(n);
+  batch::calculate_calibrated_air_speed<double>(tas, pressures, temperatures,
+                                                cas);
+  std::vector<double> speeds(n);
+  batch::speed_of_sound<double>(temperatures, speeds);
+  std::vector<double> mach_tas(n);
+  batch::mach_true_air_speed<double>(fleet.mach, temperatures, mach_tas);
+  std::vector<double> crossovers(n);
+  batch::calculate_crossover_altitude<double>(fleet.cas, fleet.mach,
+                                              crossovers);
+  std::vector<double> tas_machs(n);
+  batch::true_air_speed_mach<double>(tas, temperatures, tas_machs);
+  std::vector<double> impact_pressures(n);
+  batch::calculate_impact_pressure<double>(fleet.cas, impact_pressures);
+  std::vector<double> cas_machs(n);
+  batch::calibrated_air_speed_mach<double>(fleet.cas, pressures, cas_machs);
+  std::vector<double> mach_cas(n);
+  batch::mach_calibrated_air_speed<double>(fleet.mach, pressures, mach_cas);
+
+  for (std::size_t i{}; i < n; ++i) {
+    const auto pressure{Pascals<double>(pressures[i])};
+    const auto temperature{Kelvin<double>(temperatures[i])};
+    const auto fleet_cas{MetresPerSecond<double>(fleet.cas[i])};
+    BOOST_CHECK_EQUAL(
+        calculate_true_air_speed(fleet_cas, pressure, temperature).v(),
+        tas[i]);
+    BOOST_CHECK_EQUAL(calculate_calibrated_air_speed(
+                          MetresPerSecond<double>(tas[i]), pressure,
+                          temperature)
+                          .v(),
+                      cas[i]);
+    BOOST_CHECK_EQUAL(speed_of_sound(temperature).v(), speeds[i]);
+    BOOST_CHECK_EQUAL(mach_true_air_speed(fleet.mach[i], temperature).v(),
+                      mach_tas[i]);
+    BOOST_CHECK_EQUAL(
+        calculate_crossover_altitude(fleet_cas, fleet.mach[i]).v(),
+        crossovers[i]);
+    BOOST_CHECK_EQUAL(
+        true_air_speed_mach(MetresPerSecond<double>(tas[i]), temperature),
+        tas_machs[i]);
+    BOOST_CHECK_EQUAL(calculate_impact_pressure(fleet_cas).v(),
+                      impact_pressures[i]);
+    BOOST_CHECK_EQUAL(calibrated_air_speed_mach(fleet_cas, pressure),
+                      cas_machs[i]);
+    BOOST_CHECK_EQUAL(mach_calibrated_air_speed(fleet.mach[i], pressure).v(),
+                      mach_cas[i]);
+  }
+}
+//////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_SUITE_END()
+//////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,156 @@
+//////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2024 Ken Barker
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+/// @file
+/// @brief Contains tests for the via::isa::codec namespace.
+//////////////////////////////////////////////////////////////////////////////
+#include "via/isa/codec.hpp"
+#include "via/isa/batch.hpp"
+#include "via/isa/synthetic_fleet.hpp"
+#include <boost/test/unit_test.hpp>
+#include <cmath>
+#include <vector>
+
+using namespace via::isa;
+
+namespace {
+/// @return the largest difference between the values.
+auto max_error(std::span<const double> a, std::span<const double> b)
+    -> double {
+  double error{};
+  for (std::size_t i{}; i < a.size(); ++i)
+    error = std::max(error, std::abs(a[i] - b[i]));
+  return error;
+}
+} // namespace
+
+//////////////////////////////////////////////////////////////////////////////
+BOOST_AUTO_TEST_SUITE(Test_codec_double)
+
+//////////////////////////////////////////////////////////////////////////////
+BOOST_AUTO_TEST_CASE(test_zigzag) {
+  BOOST_CHECK_EQUAL(0u, codec::detail::zigzag(0));
+  BOOST_CHECK_EQUAL(1u, codec::detail::zigzag(static_cast<std::uint64_t>(-1)));
+  BOOST_CHECK_EQUAL(2u, codec::detail::zigzag(1));
+  BOOST_CHECK_EQUAL(3u, codec::detail::zigzag(static_cast<std::uint64_t>(-2)));
+  for (const std::int64_t value : {0LL, 1LL, -1LL, 123456789LL, -(1LL << 62)})
+    BOOST_CHECK_EQUAL(value, static_cast<std::int64_t>(codec::detail::unzigzag(
+                                 codec::detail::zigzag(
+                                     static_cast<std::uint64_t>(value)))));
+}
+//////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////
+BOOST_AUTO_TEST_CASE(test_pack_unpack) {
+  std::array<std::uint64_t, codec::BLOCK_SIZE> values;
+  std::array<std::uint64_t, codec::BLOCK_SIZE> unpacked;
+  for (const unsigned width : {1u, 3u, 17u, 63u, 64u}) {
+    const auto mask{width == 64 ? ~std::uint64_t()
+                                : (std::uint64_t(1) << width) - 1};
+    for (std::size_t i{}; i < values.size(); ++i)
+      values[i] = (0x9e37'79b9'7f4a'7c15ULL * (i + 1)) & mask;
+    std::vector<std::uint64_t> words(2 * width);
+    codec::detail::pack(values, width, words);
+    codec::detail::UNPACK[width](words.data(), unpacked);
+    BOOST_CHECK(values == unpacked);
+  }
+}
+//////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////
+BOOST_AUTO_TEST_CASE(test_encode_decode) {
+  // Empty
+  const auto empty{codec::encode<double>(std::vector<double>(), 0.1)};
+  BOOST_CHECK_EQUAL(0u, empty.blocks());
+  BOOST_CHECK_EQUAL(0.0, empty.compression_ratio());
+
+  // Constant, linear, quadratic and noisy values, not a multiple of a block
+  constexpr std::size_t SIZE{1000};
+  std::vector<double> constant(SIZE, 101325.0);
+  std::vector<double> linear(SIZE);
+  std::vector<double> quadratic(SIZE);
+  std::vector<double> noisy(SIZE);
+  std::uint64_t state{1};
+  for (std::size_t i{}; i < SIZE; ++i) {
+    const auto x{static_cast<double>(i)};
+    linear[i] = 100.0 - 7.5 * x;
+    quadratic[i] = 0.01 * x * x - 3.0 * x;
+    state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+    noisy[i] = static_cast<double>(state >> 11) * 0x1.0p-53 * 1e6 - 5e5;
+  }
+
+  std::vector<double> decoded(SIZE);
+  for (const auto *values : {&constant, &linear, &quadratic, &noisy})
+    for (const double tolerance : {1e-6, 0.01, 10.0}) {
+      const auto column{codec::encode<double>(*values, tolerance)};
+      BOOST_CHECK_EQUAL(SIZE, column.size);
+      BOOST_CHECK_EQUAL(8u, column.blocks());
+      codec::decode<double>(column, decoded);
+      BOOST_CHECK_LE(max_error(*values, decoded), tolerance * (1.0 + 1e-9));
+    }
+
+  // Smooth values compress well
+  BOOST_CHECK_GT(codec::encode<double>(constant, 0.01).compression_ratio(),
+                 50.0);
+  BOOST_CHECK_GT(codec::encode<double>(linear, 0.01).compression_ratio(), 30.0);
+  BOOST_CHECK_GT(codec::encode<double>(quadratic, 0.01).compression_ratio(),
+                 8.0);
+
+  // Decode a range which starts and ends within blocks
+  const auto column{codec::encode<double>(quadratic, 0.01)};
+  codec::decode<double>(column, decoded);
+  std::vector<double> range(300);
+  codec::decode<double>(column, 100, range);
+  BOOST_CHECK(std::equal(range.begin(), range.end(), decoded.begin() + 100));
+}
+//////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////
+BOOST_AUTO_TEST_CASE(test_decode_into_batch) {
+  FleetParameters<double> params;
+  params.flights = 3;
+  const auto fleet{generate_synthetic_fleet(params)};
+
+  // Encode the pressures of the profiles to within 0.5 Pa
+  std::vector<double> pressures(fleet.size());
+  batch::calculate_isa_pressure<double>(fleet.altitude, pressures);
+  const auto column{codec::encode<double>(pressures, 0.5)};
+  BOOST_CHECK_GT(column.compression_ratio(), 4.0);
+
+  // Decode blocks into the input of a batch function
+  std::array<double, 256> block;
+  std::array<double, 256> altitudes;
+  for (std::size_t begin{}; begin < column.size; begin += block.size()) {
+    const auto n{std::min(block.size(), column.size - begin)};
+    codec::decode<double>(column, begin, std::span<double>(block).first(n));
+    batch::calculate_isa_altitude<double>(std::span<double>(block).first(n),
+                                          std::span<double>(altitudes).first(n));
+    // 0.5 Pa is less than 0.2 m at the highest cruise altitudes
+    BOOST_CHECK_LE(
+        max_error(std::span<const double>(altitudes).first(n),
+                  std::span<const double>(fleet.altitude).subspan(begin, n)),
+        0.2);
+  }
+}
+//////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_SUITE_END()
+//////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,134 @@
+//////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2024 Ken Barker
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+/// @file
+/// @brief Contains tests for the cold temperature correction functions.
+//////////////////////////////////////////////////////////////////////////////
+#include "via/isa/cold_temperature.hpp"
+#include <boost/test/unit_test.hpp>
+#include <vector>
+
+using namespace via::isa;
+using namespace via::units::si;
+
+namespace {
+const double CALCULATION_TOLERANCE(1.0e-6);
+
+/// Integrate the correction numerically with Simpson's rule.
+auto integrate_correction(const double height, const double elevation,
+                          const double delta_temperature) -> double {
+  constexpr int STEPS{1000};
+  const double step{height / STEPS};
+  const auto integrand{[&](const double h) {
+    return -delta_temperature /
+           calculate_isa_temperature(Metres<double>(elevation + h)).v();
+  }};
+  double sum{integrand(0.0) + integrand(height)};
+  for (int i{1}; i < STEPS; ++i)
+    sum += ((i % 2) ? 4.0 : 2.0) * integrand(i * step);
+  return sum * step / 3.0;
+}
+} // namespace
+
+//////////////////////////////////////////////////////////////////////////////
+BOOST_AUTO_TEST_SUITE(Test_cold_temperature_double)
+
+//////////////////////////////////////////////////////////////////////////////
+BOOST_AUTO_TEST_CASE(test_cold_temperature_correction) {
+  for (const double elevation : {0.0, 600.0, 1500.0})
+    for (const double height : {150.0, 300.0, 1000.0, 3000.0})
+      for (const double delta : {-40.0, -15.0, 10.0})
+        BOOST_CHECK_CLOSE(integrate_correction(height, elevation, delta),
+                          calculate_cold_temperature_correction(
+                              Metres<double>(height), Metres<double>(elevation),
+                              Kelvin<double>(delta))
+                              .v(),
+                          CALCULATION_TOLERANCE);
+
+  // No correction at ISA
+  BOOST_CHECK_EQUAL(0.0, calculate_cold_temperature_correction(
+                             Metres<double>(300.0), Metres<double>(0.0),
+                             Kelvin<double>(0.0))
+                             .v());
+}
+//////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////
+BOOST_AUTO_TEST_CASE(test_approximate_cold_temperature_correction) {
+  // A sea level aerodrome at -10°C, 1000 feet above it
+  const double expected{304.8 * 25.0 / (263.0 - 0.5 * 0.0065 * 304.8)};
+  BOOST_CHECK_CLOSE(expected,
+                    approximate_cold_temperature_correction(
+                        Metres<double>(304.8), Metres<double>(0.0),
+                        Kelvin<double>(-25.0))
+                        .v(),
+                    CALCULATION_TOLERANCE);
+
+  // No correction at ISA, even at an elevated aerodrome
+  for (const double elevation : {0.0, 600.0, 2000.0})
+    BOOST_CHECK_EQUAL(0.0, approximate_cold_temperature_correction(
+                               Metres<double>(300.0), Metres<double>(elevation),
+                               Kelvin<double>(0.0))
+                               .v());
+
+  // The approximation is conservative
+  for (const double height : {150.0, 300.0, 1000.0, 3000.0})
+    BOOST_CHECK(calculate_cold_temperature_correction(Metres<double>(height),
+                                                      Metres<double>(500.0),
+                                                      Kelvin<double>(-30.0))
+                    .v() < approximate_cold_temperature_correction(
+                               Metres<double>(height), Metres<double>(500.0),
+                               Kelvin<double>(-30.0))
+                               .v());
+}
+//////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////
+BOOST_AUTO_TEST_CASE(test_batch_corrections) {
+  const auto elevation{Metres<double>(450.0)};
+  const std::vector<double> heights{150.0, 300.0, 600.0, 900.0, 1500.0};
+  const std::vector<double> deltas{-45.0, -30.0, -15.0, -5.0};
+  std::vector<double> corrections(heights.size() * deltas.size());
+
+  calculate_cold_temperature_corrections<double>(heights, elevation, deltas,
+                                                 corrections);
+  for (std::size_t d{}; d < deltas.size(); ++d)
+    for (std::size_t i{}; i < heights.size(); ++i)
+      BOOST_CHECK_CLOSE(calculate_cold_temperature_correction(
+                            Metres<double>(heights[i]), elevation,
+                            Kelvin<double>(deltas[d]))
+                            .v(),
+                        corrections[d * heights.size() + i], 1e-12);
+
+  approximate_cold_temperature_corrections<double>(heights, elevation, deltas,
+                                                   corrections);
+  for (std::size_t d{}; d < deltas.size(); ++d)
+    for (std::size_t i{}; i < heights.size(); ++i)
+      BOOST_CHECK_EQUAL(approximate_cold_temperature_correction(
+                            Metres<double>(heights[i]), elevation,
+                            Kelvin<double>(deltas[d]))
+                            .v(),
+                        corrections[d * heights.size() + i]);
+}
+//////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_SUITE_END()
+//////////////////////////////////////////////////////////////////////////////
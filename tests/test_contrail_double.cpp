@@ -0,0 +1,157 @@
+//////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2024 Ken Barker
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+/// @file
+/// @brief Contains tests for the contrail functions.
+//////////////////////////////////////////////////////////////////////////////
+#include "via/isa/contrail.hpp"
+#include <boost/test/unit_test.hpp>
+#include <vector>
+
+using namespace via::isa;
+using namespace via::units::si;
+
+namespace {
+const double CALCULATION_TOLERANCE(1.0e-6);
+
+/// Calculate the specific humidity of air with a relative humidity over
+/// water.
+auto specific_humidity(const double pressure, const double temperature,
+                       const double relative_humidity) -> double {
+  const double e{
+      relative_humidity *
+      humidity::saturation_vapour_pressure(Kelvin<double>(temperature)).v()};
+  return humidity::EPSILON<double> * e /
+         (pressure - (1.0 - humidity::EPSILON<double>) * e);
+}
+} // namespace
+
+//////////////////////////////////////////////////////////////////////////////
+BOOST_AUTO_TEST_SUITE(Test_contrail_double)
+
+//////////////////////////////////////////////////////////////////////////////
+BOOST_AUTO_TEST_CASE(test_threshold_temperatures) {
+  const double slope{calculate_mixing_line_slope(Pascals<double>(25000.0))};
+  BOOST_CHECK_CLOSE(1.25 * 1004.0 * 25000.0 /
+                        (humidity::EPSILON<double> * 43.2e6 * 0.7),
+                    slope, CALCULATION_TOLERANCE);
+
+  // Close to the approximation of Schumann (1996)
+  const double maximum{calculate_maximum_threshold_temperature(slope).v()};
+  BOOST_CHECK_CLOSE(273.15 - 41.77, maximum, 0.3);
+
+  // The slope of the saturation curve is the slope of the mixing line
+  const auto e_sat{[](const double t) {
+    return humidity::saturation_vapour_pressure(Kelvin<double>(t)).v();
+  }};
+  BOOST_CHECK_CLOSE(slope, (e_sat(maximum + 1e-3) - e_sat(maximum - 1e-3)) / 2e-3,
+                    1e-4);
+
+  // Saturated air
+  BOOST_CHECK_CLOSE(maximum, calculate_critical_temperature(slope, 1.0).v(),
+                    CALCULATION_TOLERANCE);
+  // The mixing line from the critical temperature touches saturation
+  for (const double humidity : {0.0, 0.3, 0.7}) {
+    const double critical{calculate_critical_temperature(slope, humidity).v()};
+    BOOST_CHECK(critical < maximum);
+    BOOST_CHECK_CLOSE(humidity * e_sat(critical) +
+                          slope * (maximum - critical),
+                      e_sat(maximum), CALCULATION_TOLERANCE);
+  }
+}
+//////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////
+BOOST_AUTO_TEST_CASE(test_contrail_flags) {
+  const auto level{calculate_contrail_level(Metres<double>(10000.0))};
+  BOOST_CHECK_EQUAL(calculate_isa_pressure(Metres<double>(10000.0)).v(),
+                    level.pressure);
+
+  for (const double humidity : {0.2, 0.6, 0.9}) {
+    const double critical{
+        calculate_critical_temperature(level.slope, humidity).v()};
+    const double colder{critical - 0.1};
+    const double warmer{critical + 0.1};
+    BOOST_CHECK(calculate_contrail_flags(
+                    level, colder,
+                    specific_humidity(level.pressure, colder, humidity)) &
+                CONTRAIL_FORMS);
+    BOOST_CHECK_EQUAL(0u, calculate_contrail_flags(
+                              level, warmer,
+                              specific_humidity(level.pressure, warmer,
+                                                humidity)));
+  }
+
+  // Persistent in air saturated over water, which is supersaturated over ice
+  const double t{220.0};
+  BOOST_CHECK_EQUAL(CONTRAIL_FORMS | CONTRAIL_PERSISTS,
+                    calculate_contrail_flags(
+                        level, t, specific_humidity(level.pressure, t, 1.0)));
+  // Not persistent in dry air
+  BOOST_CHECK_EQUAL(CONTRAIL_FORMS,
+                    calculate_contrail_flags(
+                        level, t, specific_humidity(level.pressure, t, 0.3)));
+}
+//////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////
+BOOST_AUTO_TEST_CASE(test_calculate_contrails) {
+  const std::vector<double> altitudes{8000.0, 9500.0, 11000.0};
+  // Not a multiple of the block size
+  constexpr std::size_t POINTS{5000};
+  const auto size{altitudes.size() * POINTS};
+  std::vector<double> temperatures(size);
+  std::vector<double> humidities(size);
+  for (std::size_t i{}; i < size; ++i) {
+    temperatures[i] = 205.0 + static_cast<double>(i % 97) * 0.4;
+    humidities[i] = 1e-6 * static_cast<double>(i % 89);
+  }
+
+  std::vector<std::uint8_t> flags(size);
+  const auto levels{calculate_contrails<double>(altitudes, temperatures,
+                                                humidities, flags, {}, 4)};
+  BOOST_CHECK_EQUAL(altitudes.size(), levels.size());
+
+  std::size_t forms{};
+  for (std::size_t l{}; l < altitudes.size(); ++l) {
+    const auto level{calculate_contrail_level(Metres<double>(altitudes[l]))};
+    BOOST_CHECK_EQUAL(level.threshold_temperature,
+                      levels[l].threshold_temperature);
+    for (std::size_t p{}; p < POINTS; ++p) {
+      const auto i{l * POINTS + p};
+      BOOST_CHECK_EQUAL(
+          calculate_contrail_flags(level, temperatures[i], humidities[i]),
+          flags[i]);
+      forms += flags[i] & CONTRAIL_FORMS;
+    }
+  }
+  BOOST_CHECK(0u < forms);
+  BOOST_CHECK(forms < size);
+
+  // No flight levels and no weather grid points
+  const std::vector<double> none;
+  std::vector<std::uint8_t> no_flags;
+  BOOST_CHECK(calculate_contrails<double>(none, none, none, no_flags).empty());
+}
+//////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_SUITE_END()
+//////////////////////////////////////////////////////////////////////////////
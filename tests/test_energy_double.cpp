@@ -0,0 +1,143 @@
+//////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2024 Ken Barker
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+/// @file
+/// @brief Contains tests for the energy share factor and total energy functions.
+//////////////////////////////////////////////////////////////////////////////
+#include "via/isa/energy.hpp"
+#include <boost/test/unit_test.hpp>
+#include <vector>
+
+using namespace via::isa;
+using namespace via::units::si;
+
+namespace {
+const double CALCULATION_TOLERANCE(1.0e-9);
+
+/// Calculate the energy share factor from the derivative of the True Air
+/// Speed with respect to true height.
+auto numerical_energy_share_factor(const SpeedHold hold, const double speed,
+                                   const double altitude, const double delta)
+    -> double {
+  const auto tas{[&](const double h) {
+    const auto temperature{
+        calculate_isa_temperature(Metres<double>(h), Kelvin<double>(delta))};
+    return (hold == SpeedHold::CAS)
+               ? calculate_true_air_speed(MetresPerSecond<double>(speed),
+                                          calculate_isa_pressure(
+                                              Metres<double>(h)),
+                                          temperature)
+                     .v()
+               : mach_true_air_speed(speed, temperature).v();
+  }};
+  constexpr double STEP{0.1};
+  const double dv_dh{(tas(altitude + STEP) - tas(altitude - STEP)) /
+                     (2.0 * STEP)};
+  // The rate of pressure altitude with true height
+  const double ratio{
+      calculate_isa_temperature(Metres<double>(altitude)).v() /
+      calculate_isa_temperature(Metres<double>(altitude), Kelvin<double>(delta))
+          .v()};
+  return 1.0 / (1.0 + tas(altitude) / 9.80665 * dv_dh * ratio);
+}
+} // namespace
+
+//////////////////////////////////////////////////////////////////////////////
+BOOST_AUTO_TEST_SUITE(Test_energy_double)
+
+//////////////////////////////////////////////////////////////////////////////
+BOOST_AUTO_TEST_CASE(test_energy_share_factor_mach) {
+  // Above the tropopause
+  BOOST_CHECK_EQUAL(1.0, calculate_energy_share_factor(
+                             SpeedHold::MACH, 0.8, Metres<double>(12000.0)));
+
+  for (const double altitude : {3000.0, 8000.0, 10500.0})
+    for (const double delta : {-10.0, 0.0, 10.0}) {
+      const double f{calculate_energy_share_factor(
+          SpeedHold::MACH, 0.78, Metres<double>(altitude),
+          Kelvin<double>(delta))};
+      BOOST_CHECK(f >= 1.0);
+      BOOST_CHECK_CLOSE(numerical_energy_share_factor(SpeedHold::MACH, 0.78,
+                                                      altitude, delta),
+                        f, 1e-4);
+    }
+}
+//////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////
+BOOST_AUTO_TEST_CASE(test_energy_share_factor_cas) {
+  const double cas{140.0};
+  // Both sides of the tropopause
+  for (const double altitude : {1000.0, 6000.0, 10500.0, 12000.0, 15000.0})
+    for (const double delta : {-10.0, 0.0, 10.0}) {
+      const auto pressure{calculate_isa_pressure(Metres<double>(altitude))};
+      const double mach{
+          calibrated_air_speed_mach(MetresPerSecond<double>(cas), pressure)};
+      const double f{calculate_energy_share_factor(
+          SpeedHold::CAS, mach, Metres<double>(altitude),
+          Kelvin<double>(delta))};
+      BOOST_CHECK(f < 1.0);
+      BOOST_CHECK_CLOSE(numerical_energy_share_factor(SpeedHold::CAS, cas,
+                                                      altitude, delta),
+                        f, 1e-4);
+    }
+}
+//////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////
+BOOST_AUTO_TEST_CASE(test_calculate_total_energy) {
+  BOOST_CHECK_CLOSE(9.80665 * 1000.0 + 0.5 * 200.0 * 200.0,
+                    calculate_specific_total_energy(
+                        Metres<double>(1000.0), MetresPerSecond<double>(200.0)),
+                    CALCULATION_TOLERANCE);
+
+  const std::vector<double> altitudes{2000.0, 7000.0, 10900.0, 11100.0,
+                                      14000.0};
+  const std::vector<double> tas{160.0, 200.0, 230.0, 232.0, 236.0};
+  const std::vector<double> vertical_speeds{10.0, 8.0, 5.0, 5.0, 2.0};
+  const auto delta{Kelvin<double>(-5.0)};
+
+  const auto size{altitudes.size()};
+  std::vector<double> factors(size);
+  std::vector<double> energies(size);
+  std::vector<double> rates(size);
+  for (const auto hold : {SpeedHold::CAS, SpeedHold::MACH}) {
+    calculate_total_energy<double>(hold, altitudes, tas, vertical_speeds,
+                                   delta, {factors, energies, rates});
+    for (std::size_t i{}; i < size; ++i) {
+      const auto altitude{Metres<double>(altitudes[i])};
+      const auto speed{MetresPerSecond<double>(tas[i])};
+      const double mach{true_air_speed_mach(
+          speed, calculate_isa_temperature(altitude, delta))};
+      const double f{
+          calculate_energy_share_factor(hold, mach, altitude, delta)};
+      BOOST_CHECK_EQUAL(f, factors[i]);
+      BOOST_CHECK_EQUAL(calculate_specific_total_energy(altitude, speed),
+                        energies[i]);
+      BOOST_CHECK_CLOSE(9.80665 * vertical_speeds[i] / f, rates[i],
+                        CALCULATION_TOLERANCE);
+    }
+  }
+}
+//////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_SUITE_END()
+//////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,84 @@
+//////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2024 Ken Barker
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+/// @file
+/// @brief Contains tests for the via::isa speed envelope functions.
+//////////////////////////////////////////////////////////////////////////////
+#include "via/isa/envelope.hpp"
+#include <boost/test/unit_test.hpp>
+#include <vector>
+
+using namespace via::isa;
+using namespace via::units::si;
+
+namespace {
+const double CALCULATION_TOLERANCE(1.0e-9);
+} // namespace
+
+//////////////////////////////////////////////////////////////////////////////
+BOOST_AUTO_TEST_SUITE(Test_envelope_double)
+
+//////////////////////////////////////////////////////////////////////////////
+BOOST_AUTO_TEST_CASE(test_speed_envelope) {
+  const auto vmo{MetresPerSecond<double>(350.0 * 1852.0 / 3600.0)};
+  const auto mmo{0.82};
+
+  // Flight levels 0 to 450
+  std::vector<double> altitudes;
+  for (int fl{}; fl <= 450; fl += 10)
+    altitudes.push_back(fl * 100 * 0.3048);
+  const std::vector<double> delta_temperatures{-20.0, 0.0, 15.0, 30.0};
+  const std::vector<double> winds(altitudes.size(), -25.0);
+
+  const auto envelope{calculate_speed_envelope<double>(
+      vmo, mmo, altitudes, delta_temperatures, winds)};
+  BOOST_CHECK_EQUAL(altitudes.size(), envelope.levels);
+  BOOST_CHECK_EQUAL(delta_temperatures.size(), envelope.deviations);
+  BOOST_CHECK_EQUAL(calculate_crossover_altitude(vmo, mmo).v(),
+                    envelope.crossover_altitude.v());
+
+  for (std::size_t d{}; d < delta_temperatures.size(); ++d) {
+    const auto delta_temperature{Kelvin<double>(delta_temperatures[d])};
+    for (std::size_t i{}; i < altitudes.size(); ++i) {
+      const auto altitude{Metres<double>(altitudes[i])};
+      const auto temperature{
+          calculate_isa_temperature(altitude, delta_temperature)};
+      const auto expected{
+          (altitude < envelope.crossover_altitude)
+              ? calculate_true_air_speed(
+                    vmo, calculate_isa_pressure(altitude), temperature)
+              : mach_true_air_speed(mmo, temperature)};
+      BOOST_CHECK_CLOSE(expected.v(), envelope.true_air_speed(d, i).v(),
+                        CALCULATION_TOLERANCE);
+      BOOST_CHECK_EQUAL(envelope.true_air_speed(d, i).v() - 25.0,
+                        envelope.ground_speed(d, i).v());
+    }
+  }
+
+  // Mmo limits the Mach number above the crossover altitude
+  for (std::size_t i{}; i < altitudes.size(); ++i)
+    BOOST_CHECK_EQUAL(altitudes[i] >= envelope.crossover_altitude.v(),
+                      envelope.machs[i] == mmo);
+}
+//////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_SUITE_END()
+//////////////////////////////////////////////////////////////////////////////
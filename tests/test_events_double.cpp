@@ -0,0 +1,157 @@
+//////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2024 Ken Barker
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+/// @file
+/// @brief Contains tests for the via::isa::EventDetector class.
+//////////////////////////////////////////////////////////////////////////////
+#include "via/isa/events.hpp"
+#include <boost/test/unit_test.hpp>
+#include <vector>
+
+using namespace via::isa;
+using namespace via::units::si;
+
+namespace {
+const double CALCULATION_TOLERANCE(1.0e-9);
+
+/// A climb at 10 metres per second from Sea level to 12000 metres with the
+/// CAS ramping up to 210 metres per second and back down to 160.
+struct Climb {
+  std::vector<double> times;
+  std::vector<double> altitudes;
+  std::vector<double> cas;
+
+  Climb() {
+    for (int i{}; i <= 1200; ++i) {
+      times.push_back(i);
+      altitudes.push_back(10.0 * i);
+      cas.push_back(i < 600 ? 120.0 + 0.15 * i : 210.0 - 0.1 * (i - 600));
+    }
+  }
+};
+
+const EventThresholds<double> THRESHOLDS{MetresPerSecond<double>(150.0), 0.78,
+                                         MetresPerSecond<double>(180.0), 0.8};
+} // namespace
+
+//////////////////////////////////////////////////////////////////////////////
+BOOST_AUTO_TEST_SUITE(Test_events_double)
+
+//////////////////////////////////////////////////////////////////////////////
+BOOST_AUTO_TEST_CASE(test_event_detector) {
+  const Climb climb;
+  EventDetector<double> detector{THRESHOLDS};
+  BOOST_CHECK_EQUAL(calculate_crossover_altitude(THRESHOLDS.filed_cas,
+                                                 THRESHOLDS.filed_mach)
+                        .v(),
+                    detector.crossover_altitude().v());
+
+  std::vector<Event<double>> events;
+  detector.process(climb.times, climb.altitudes, climb.cas,
+                   [&events](const auto &event) { events.push_back(event); });
+  BOOST_CHECK_EQUAL(climb.times.size(), detector.samples());
+
+  std::vector<Event<double>> tropopause;
+  std::vector<Event<double>> crossover;
+  std::vector<Event<double>> cas;
+  std::vector<Event<double>> mach;
+  for (const auto &event : events) {
+    switch (event.type) {
+    case EventType::CROSSOVER:
+      crossover.push_back(event);
+      break;
+    case EventType::TROPOPAUSE:
+      tropopause.push_back(event);
+      break;
+    case EventType::OVERSPEED_CAS:
+      cas.push_back(event);
+      break;
+    case EventType::OVERSPEED_MACH:
+      mach.push_back(event);
+      break;
+    }
+  }
+
+  BOOST_REQUIRE_EQUAL(1u, tropopause.size());
+  BOOST_CHECK_CLOSE(1100.0, tropopause[0].time, CALCULATION_TOLERANCE);
+  BOOST_CHECK_EQUAL(1100u, tropopause[0].sample);
+  BOOST_CHECK(tropopause[0].rising);
+
+  BOOST_REQUIRE_EQUAL(1u, crossover.size());
+  BOOST_CHECK_CLOSE(detector.crossover_altitude().v() / 10.0,
+                    crossover[0].time, CALCULATION_TOLERANCE);
+
+  // The CAS rises above 180 at 400 seconds and falls below at 900 seconds
+  BOOST_REQUIRE_EQUAL(2u, cas.size());
+  BOOST_CHECK_CLOSE(400.0, cas[0].time, CALCULATION_TOLERANCE);
+  BOOST_CHECK(cas[0].rising);
+  BOOST_CHECK_CLOSE(900.0, cas[1].time, CALCULATION_TOLERANCE);
+  BOOST_CHECK(!cas[1].rising);
+
+  // The Mach number crosses Mmo between the samples either side of the event
+  BOOST_REQUIRE(!mach.empty());
+  for (const auto &event : mach) {
+    const auto machs{[&climb](const std::size_t i) {
+      return calibrated_air_speed_mach(
+          MetresPerSecond<double>(climb.cas[i]),
+          calculate_isa_pressure(Metres<double>(climb.altitudes[i])));
+    }};
+    BOOST_CHECK_EQUAL(event.rising, machs(event.sample) >= THRESHOLDS.mmo);
+    BOOST_CHECK_EQUAL(event.rising, machs(event.sample - 1) < THRESHOLDS.mmo);
+    BOOST_CHECK(climb.times[event.sample - 1] <= event.time);
+    BOOST_CHECK(event.time <= climb.times[event.sample]);
+  }
+}
+//////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////
+BOOST_AUTO_TEST_CASE(test_event_detector_streaming) {
+  const Climb climb;
+  EventDetector<double> detector{THRESHOLDS};
+  std::vector<Event<double>> expected;
+  detector.process(climb.times, climb.altitudes, climb.cas,
+                   [&expected](const auto &event) { expected.push_back(event); });
+
+  // Process the samples in uneven pieces
+  detector.reset();
+  std::vector<Event<double>> events;
+  const std::span<const double> times{climb.times};
+  const std::span<const double> altitudes{climb.altitudes};
+  const std::span<const double> cas{climb.cas};
+  for (std::size_t begin{}, n{1}; begin < times.size(); begin += n, n += 97) {
+    n = std::min(n, times.size() - begin);
+    detector.process(times.subspan(begin, n), altitudes.subspan(begin, n),
+                     cas.subspan(begin, n),
+                     [&events](const auto &event) { events.push_back(event); });
+  }
+
+  BOOST_REQUIRE_EQUAL(expected.size(), events.size());
+  for (std::size_t i{}; i < events.size(); ++i) {
+    BOOST_CHECK_EQUAL(expected[i].time, events[i].time);
+    BOOST_CHECK_EQUAL(expected[i].sample, events[i].sample);
+    BOOST_CHECK(expected[i].type == events[i].type);
+    BOOST_CHECK_EQUAL(expected[i].rising, events[i].rising);
+  }
+}
+//////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_SUITE_END()
+//////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,141 @@
+//////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2024 Ken Barker
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+/// @file
+/// @brief Contains tests for the via::isa::expression namespace.
+//////////////////////////////////////////////////////////////////////////////
+#include "via/isa/expression.hpp"
+#include "via/isa/batch.hpp"
+#include "via/isa/synthetic_fleet.hpp"
+#include <boost/test/unit_test.hpp>
+
+using namespace via::isa;
+using namespace via::units::si;
+
+namespace {
+/// A function object which counts its calls.
+struct CountingSquare {
+  static inline std::size_t calls{};
+  auto operator()(const double x) const -> double {
+    ++calls;
+    return x * x;
+  }
+};
+} // namespace
+
+//////////////////////////////////////////////////////////////////////////////
+BOOST_AUTO_TEST_SUITE(Test_expression_double)
+
+//////////////////////////////////////////////////////////////////////////////
+BOOST_AUTO_TEST_CASE(test_expression_density) {
+  FleetParameters<double> params;
+  params.flights = 5;
+  const auto fleet{generate_synthetic_fleet(params)};
+  const auto n{fleet.size()};
+
+  // The batch functions
+  std::vector<double> pressures(n);
+  batch::calculate_isa_pressure<double>(fleet.altitude, pressures);
+  std::vector<double> temperatures(n);
+  batch::calculate_isa_temperature<double>(
+      fleet.altitude, fleet.delta_temperature, temperatures);
+  std::vector<double> densities(n);
+  batch::calculate_density<double>(pressures, temperatures, densities);
+
+  // The equivalent expression
+  const auto h{expression::column(fleet.altitude)};
+  const auto rho{expression::calculate_density(
+      expression::calculate_isa_pressure(h),
+      expression::calculate_isa_temperature(
+          h, expression::column(fleet.delta_temperature)))};
+  BOOST_CHECK_EQUAL(n, rho.size());
+
+  std::vector<double> result(n);
+  expression::evaluate(result, rho);
+  BOOST_CHECK(densities == result);
+}
+//////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////
+BOOST_AUTO_TEST_CASE(test_expression_outputs) {
+  FleetParameters<double> params;
+  params.flights = 5;
+  const auto fleet{generate_synthetic_fleet(params)};
+  const auto n{fleet.size()};
+
+  const auto h{expression::column(fleet.altitude)};
+  const auto p{expression::calculate_isa_pressure(h)};
+  const auto t{expression::calculate_isa_temperature(h)};
+  const auto tas{expression::calculate_true_air_speed(
+      expression::column(fleet.cas), p, t)};
+  const auto mach{tas / expression::speed_of_sound(t)};
+
+  std::vector<double> densities(n);
+  std::vector<double> speeds(n);
+  std::vector<double> machs(n);
+  expression::evaluate(
+      expression::output(
+          densities, expression::calculate_density(p, t)),
+      expression::output(speeds, tas),
+      expression::output(machs, mach));
+
+  for (std::size_t i{}; i < n; i += 7) {
+    const auto altitude{Metres<double>(fleet.altitude[i])};
+    const auto pressure{calculate_isa_pressure(altitude)};
+    const auto temperature{calculate_isa_temperature(altitude)};
+    const auto true_air_speed{calculate_true_air_speed(
+        MetresPerSecond<double>(fleet.cas[i]), pressure, temperature)};
+    BOOST_CHECK_EQUAL(calculate_density(pressure, temperature).v(),
+                      densities[i]);
+    BOOST_CHECK_EQUAL(true_air_speed.v(), speeds[i]);
+    BOOST_CHECK_EQUAL(true_air_speed.v() / speed_of_sound(temperature).v(),
+                      machs[i]);
+  }
+}
+//////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////
+BOOST_AUTO_TEST_CASE(test_expression_common_subexpressions) {
+  std::vector<double> values(1000);
+  for (std::size_t i{}; i < values.size(); ++i)
+    values[i] = static_cast<double>(i);
+
+  const auto x{expression::column(values)};
+  const auto square{expression::make_function<CountingSquare>(x)};
+  const auto sum{square + square * 2.0 - 1.0};
+
+  std::vector<double> result(values.size());
+  CountingSquare::calls = 0;
+  expression::evaluate(result, sum);
+  BOOST_CHECK_EQUAL(values.size(), CountingSquare::calls);
+  for (std::size_t i{}; i < values.size(); ++i)
+    BOOST_CHECK_EQUAL(3.0 * values[i] * values[i] - 1.0, result[i]);
+
+  // Evaluating again uses the new values
+  values[0] = 2.0;
+  expression::evaluate(result, sum);
+  BOOST_CHECK_EQUAL(11.0, result[0]);
+  BOOST_CHECK_EQUAL(2 * values.size(), CountingSquare::calls);
+}
+//////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_SUITE_END()
+//////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,242 @@
+//////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2024 Ken Barker
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+/// @file
+/// @brief Contains tests for the via::isa::fixed_point namespace.
+//////////////////////////////////////////////////////////////////////////////
+#include "via/isa/fixed_point.hpp"
+#include "via/isa/batch.hpp"
+#include <boost/test/unit_test.hpp>
+#include <vector>
+
+using namespace via::isa;
+using namespace via::units::si;
+
+//////////////////////////////////////////////////////////////////////////////
+BOOST_AUTO_TEST_SUITE(Test_fixed_point)
+
+//////////////////////////////////////////////////////////////////////////////
+BOOST_AUTO_TEST_CASE(test_integer_functions) {
+  BOOST_CHECK_EQUAL(2, fixed_point::round_shift(3, 1));
+  BOOST_CHECK_EQUAL(-1, fixed_point::round_shift(-3, 1));
+  BOOST_CHECK_EQUAL(5, fixed_point::round_shift(5, 0));
+
+  BOOST_CHECK_EQUAL(0u, fixed_point::isqrt(0));
+  BOOST_CHECK_EQUAL(1u, fixed_point::isqrt(3));
+  BOOST_CHECK_EQUAL(2u, fixed_point::isqrt(4));
+  BOOST_CHECK_EQUAL(4294967295u, fixed_point::isqrt(~std::uint64_t()));
+  for (std::uint64_t root : {3037000499ull, 4294967294ull, 123456789ull})
+    for (const auto value : {root * root - 1, root * root, root * root + 1})
+      BOOST_CHECK_EQUAL(value < root * root ? root - 1 : root,
+                        fixed_point::isqrt(value));
+
+  BOOST_CHECK_EQUAL(32767, fixed_point::saturate<std::int16_t>(100000));
+  BOOST_CHECK_EQUAL(-32768, fixed_point::saturate<std::int16_t>(-100000));
+
+  BOOST_CHECK_EQUAL(384, fixed_point::to_fixed<std::int32_t>(1.5, 8));
+  BOOST_CHECK_EQUAL(-384, fixed_point::to_fixed<std::int32_t>(-1.5, 8));
+  BOOST_CHECK_EQUAL(127, fixed_point::to_fixed<std::int8_t>(1000.0, 0));
+  BOOST_CHECK_EQUAL(1.5, fixed_point::to_double(384, 8));
+}
+//////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////
+BOOST_AUTO_TEST_CASE(test_polynomial_table) {
+  // A quadratic is represented exactly, except for rounding
+  const fixed_point::PolynomialTable table(
+      [](const double x) { return 0.5 * x * x - x; }, -4.0, 4.0, 12, 12, 4);
+  BOOST_CHECK_LE(table.segments(), 17u);
+  for (double x{-4.0}; x <= 4.0; x += 0.125)
+    BOOST_CHECK_EQUAL(fixed_point::to_fixed<std::int64_t>(0.5 * x * x - x, 12),
+                      table(fixed_point::to_fixed<std::int64_t>(x, 12)));
+
+  // Inputs are clamped to the range
+  BOOST_CHECK_EQUAL(table(fixed_point::to_fixed<std::int64_t>(4.0, 12)),
+                    table(fixed_point::to_fixed<std::int64_t>(100.0, 12)));
+}
+//////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////
+BOOST_AUTO_TEST_CASE(test_fixed_point_isa) {
+  using Isa = fixed_point::FixedPointIsa<>;
+  constexpr auto F{Isa::FORMATS};
+  const Isa isa;
+
+  constexpr std::size_t SIZE{1000};
+  std::vector<double> altitudes(SIZE);
+  std::vector<double> deltas(SIZE);
+  std::vector<double> cas(SIZE);
+  for (std::size_t i{}; i < SIZE; ++i) {
+    const auto x{static_cast<double>(i) / SIZE};
+    altitudes[i] = -500.0 + 19000.0 * x;
+    deltas[i] = -20.0 + 40.0 * x * x;
+    cas[i] = 60.0 + 120.0 * (1.0 - x);
+  }
+
+  std::vector<double> pressures(SIZE);
+  std::vector<double> temperatures(SIZE);
+  std::vector<double> densities(SIZE);
+  std::vector<double> tas(SIZE);
+  std::vector<double> cas_values(SIZE);
+  std::vector<double> altitude_values(SIZE);
+  batch::calculate_isa_pressure<double>(altitudes, pressures);
+  batch::calculate_isa_temperature<double>(altitudes, deltas, temperatures);
+  batch::calculate_density<double>(pressures, temperatures, densities);
+  batch::calculate_true_air_speed<double>(cas, pressures, temperatures, tas);
+  batch::calculate_calibrated_air_speed<double>(tas, pressures, temperatures,
+                                                cas_values);
+  batch::calculate_isa_altitude<double>(pressures, altitude_values);
+
+  const auto fixed{[](const std::vector<double> &values, const int fraction) {
+    std::vector<std::int32_t> result(values.size());
+    fixed_point::to_fixed<std::int32_t>(values, fraction, result);
+    return result;
+  }};
+  const auto h{fixed(altitudes, F.altitude)};
+  const auto d{fixed(deltas, F.temperature)};
+  const auto c{fixed(cas, F.speed)};
+  const auto p{fixed(pressures, F.pressure)};
+  const auto t{fixed(temperatures, F.temperature)};
+  const auto v{fixed(tas, F.speed)};
+
+  std::vector<std::int32_t> out(SIZE);
+  isa.calculate_isa_pressure(h, out);
+  BOOST_CHECK_LT(fixed_point::error_report<std::int32_t>(pressures, out,
+                                                         F.pressure)
+                     .max_error,
+                 0.5);
+
+  isa.calculate_isa_altitude(p, out);
+  BOOST_CHECK_LT(fixed_point::error_report<std::int32_t>(altitude_values, out,
+                                                         F.altitude)
+                     .max_error,
+                 0.5);
+
+  isa.calculate_isa_temperature(h, d, out);
+  BOOST_CHECK_LT(fixed_point::error_report<std::int32_t>(temperatures, out,
+                                                         F.temperature)
+                     .max_error,
+                 1e-3);
+
+  isa.calculate_density(p, t, out);
+  BOOST_CHECK_LT(fixed_point::error_report<std::int32_t>(densities, out,
+                                                         F.density)
+                     .max_error,
+                 1e-5);
+
+  isa.calculate_true_air_speed(c, p, t, out);
+  const auto tas_report{
+      fixed_point::error_report<std::int32_t>(tas, out, F.speed)};
+  BOOST_CHECK_LT(tas_report.max_error, 0.005);
+  BOOST_CHECK_LT(tas_report.rms_error, tas_report.max_error + 1e-12);
+  BOOST_CHECK_EQUAL(SIZE, tas_report.count);
+
+  isa.calculate_calibrated_air_speed(v, p, t, out);
+  BOOST_CHECK_LT(fixed_point::error_report<std::int32_t>(cas_values, out,
+                                                         F.speed)
+                     .max_error,
+                 0.005);
+
+  // The fixed point functions are deterministic
+  const Isa other;
+  for (std::size_t i{}; i < SIZE; i += 37)
+    BOOST_CHECK_EQUAL(isa.calculate_true_air_speed(c[i], p[i], t[i]),
+                      other.calculate_true_air_speed(c[i], p[i], t[i]));
+}
+//////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////
+BOOST_AUTO_TEST_CASE(test_fixed_point_rom) {
+  using Isa = fixed_point::FixedPointIsa<>;
+  constexpr auto F{Isa::FORMATS};
+  const Isa isa;
+
+  // Tables loaded from ROM contents give the same results
+  auto rom{isa.rom()};
+  const Isa loaded(rom);
+  BOOST_CHECK(rom == loaded.rom());
+  BOOST_CHECK_EQUAL(isa.checksum(), loaded.checksum());
+  for (const double altitude : {-500.0, 0.0, 5000.0, 11000.0, 15000.0}) {
+    const auto h{fixed_point::to_fixed<std::int32_t>(altitude, F.altitude)};
+    const auto p{isa.calculate_isa_pressure(h)};
+    const auto t{isa.calculate_isa_temperature(h, 0)};
+    const auto cas{fixed_point::to_fixed<std::int32_t>(150.0, F.speed)};
+    BOOST_CHECK_EQUAL(p, loaded.calculate_isa_pressure(h));
+    BOOST_CHECK_EQUAL(isa.calculate_isa_altitude(p),
+                      loaded.calculate_isa_altitude(p));
+    BOOST_CHECK_EQUAL(isa.calculate_density(p, t),
+                      loaded.calculate_density(p, t));
+    BOOST_CHECK_EQUAL(isa.calculate_true_air_speed(cas, p, t),
+                      loaded.calculate_true_air_speed(cas, p, t));
+    BOOST_CHECK_EQUAL(isa.calculate_calibrated_air_speed(cas, p, t),
+                      loaded.calculate_calibrated_air_speed(cas, p, t));
+  }
+
+  // The checksum detects a different coefficient
+  rom[0][0][0] += std::int64_t(1) << fixed_point::GUARD_BITS;
+  const Isa modified(rom);
+  BOOST_CHECK(isa.checksum() != modified.checksum());
+  const auto h_min{
+      fixed_point::to_fixed<std::int32_t>(fixed_point::MIN_ALTITUDE, F.altitude)};
+  BOOST_CHECK_EQUAL(isa.calculate_isa_pressure(h_min) + 1,
+                    modified.calculate_isa_pressure(h_min));
+}
+//////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////
+BOOST_AUTO_TEST_CASE(test_fixed_point_word_lengths) {
+  // 64 bit words with more fraction bits and segments
+  using Isa = fixed_point::FixedPointIsa<
+      std::int64_t, fixed_point::Formats{.altitude = 12,
+                                         .pressure = 16,
+                                         .temperature = 24,
+                                         .density = 32,
+                                         .speed = 20,
+                                         .segment_bits = 10}>;
+  constexpr auto F{Isa::FORMATS};
+  const Isa isa;
+
+  for (const double altitude : {0.0, 5000.0, 11000.0, 15000.0}) {
+    const auto h{fixed_point::to_fixed<std::int64_t>(altitude, F.altitude)};
+    const auto expected{calculate_isa_pressure(Metres<double>(altitude)).v()};
+    BOOST_CHECK_CLOSE(expected,
+                      fixed_point::to_double(isa.calculate_isa_pressure(h),
+                                             F.pressure),
+                      1e-5);
+  }
+
+  // Fewer fraction bits and segments
+  using SmallIsa = fixed_point::FixedPointIsa<
+      std::int32_t, fixed_point::Formats{.altitude = 0,
+                                         .pressure = 2,
+                                         .temperature = 8,
+                                         .density = 16,
+                                         .speed = 8,
+                                         .segment_bits = 6}>;
+  const SmallIsa small;
+  const auto pressure{small.calculate_isa_pressure(10000)};
+  BOOST_CHECK_CLOSE(calculate_isa_pressure(Metres<double>(10000.0)).v(),
+                    fixed_point::to_double(pressure, 2), 1e-3);
+}
+//////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_SUITE_END()
+//////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,109 @@
+//////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2024 Ken Barker
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+/// @file
+/// @brief Contains tests for the FleetStore class.
+//////////////////////////////////////////////////////////////////////////////
+#include "via/isa/fleet_store.hpp"
+#include <boost/test/unit_test.hpp>
+#include <vector>
+
+using namespace via::isa;
+using namespace via::units::si;
+
+//////////////////////////////////////////////////////////////////////////////
+BOOST_AUTO_TEST_SUITE(Test_fleet_store_double)
+
+//////////////////////////////////////////////////////////////////////////////
+BOOST_AUTO_TEST_CASE(test_fleet_store) {
+  constexpr std::size_t SIZE{100};
+  std::vector<double> altitudes(SIZE);
+  std::vector<double> cas(SIZE);
+  std::vector<double> deltas(SIZE, 5.0);
+  for (std::size_t i{}; i < SIZE; ++i) {
+    altitudes[i] = 100.0 * static_cast<double>(i);
+    cas[i] = 100.0 + static_cast<double>(i);
+  }
+
+  FleetStore<double> store(SIZE, {.altitude = 1.0, .cas = 0.1,
+                                  .delta_temperature = 0.1});
+  BOOST_CHECK_EQUAL(SIZE, store.size());
+
+  // The first update calculates every aircraft
+  auto report{store.update(altitudes, cas, deltas)};
+  BOOST_CHECK_EQUAL(SIZE, report.size);
+  BOOST_CHECK_EQUAL(SIZE, report.recalculated);
+  BOOST_CHECK_EQUAL(1.0, report.recalculated_fraction());
+
+  const auto check{[&](const std::size_t i) {
+    const auto altitude{Metres<double>(store.altitudes()[i])};
+    const auto pressure{calculate_isa_pressure(altitude)};
+    const auto temperature{
+        calculate_isa_temperature(altitude, Kelvin<double>(deltas[i]))};
+    BOOST_CHECK_EQUAL(pressure.v(), store.pressures()[i]);
+    BOOST_CHECK_EQUAL(temperature.v(), store.temperatures()[i]);
+    BOOST_CHECK_EQUAL(calculate_true_air_speed(
+                          MetresPerSecond<double>(store.cas()[i]), pressure,
+                          temperature)
+                          .v(),
+                      store.true_air_speeds()[i]);
+  }};
+  for (std::size_t i{}; i < SIZE; ++i)
+    check(i);
+
+  // Noise within the tolerances does not recalculate
+  for (std::size_t i{}; i < SIZE; ++i) {
+    altitudes[i] += 0.5;
+    cas[i] -= 0.05;
+  }
+  report = store.update(altitudes, cas, deltas);
+  BOOST_CHECK_EQUAL(0u, report.recalculated);
+  BOOST_CHECK_EQUAL(0.0, report.recalculated_fraction());
+  BOOST_CHECK_EQUAL(0.0, store.altitudes()[0]);
+
+  // Noise accumulates from the inputs of the current air data
+  altitudes[3] += 0.6;
+  cas[7] += 1.0;
+  deltas[11] = 6.0;
+  report = store.update(altitudes, cas, deltas);
+  BOOST_CHECK_EQUAL(3u, report.recalculated);
+  const std::vector<std::size_t> expected{3, 7, 11};
+  BOOST_CHECK_EQUAL_COLLECTIONS(expected.begin(), expected.end(),
+                                store.recalculated().begin(),
+                                store.recalculated().end());
+  BOOST_CHECK_EQUAL(altitudes[3], store.altitudes()[3]);
+  for (const auto i : expected)
+    check(i);
+
+  // Invalidate recalculates every aircraft
+  store.invalidate();
+  BOOST_CHECK_EQUAL(SIZE, store.update(altitudes, cas, deltas).recalculated);
+  for (std::size_t i{}; i < SIZE; ++i)
+    check(i);
+
+  // An empty store
+  FleetStore<double> empty(0);
+  BOOST_CHECK_EQUAL(0.0, empty.update({}, {}, {}).recalculated_fraction());
+}
+//////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_SUITE_END()
+//////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,139 @@
+//////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2024 Ken Barker
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+/// @file
+/// @brief Contains tests for the via::isa::grid namespace.
+//////////////////////////////////////////////////////////////////////////////
+#include "via/isa/grid.hpp"
+#include <boost/test/unit_test.hpp>
+#include <vector>
+
+using namespace via::isa;
+using namespace via::units::si;
+
+namespace {
+const double CALCULATION_TOLERANCE(1.0e-10);
+
+const std::vector<double> ALTITUDES{0.0, 3000.0, 9000.0, 11000.0, 13000.0};
+const std::vector<double> DELTAS{-20.0, 0.0, 15.0};
+const std::vector<double> SPEEDS{60.0, 120.0, 180.0, 240.0};
+} // namespace
+
+//////////////////////////////////////////////////////////////////////////////
+BOOST_AUTO_TEST_SUITE(Test_grid_double)
+
+//////////////////////////////////////////////////////////////////////////////
+BOOST_AUTO_TEST_CASE(test_grid_values) {
+  grid::GridValues<double, 3> values({2, 3, 4});
+  BOOST_CHECK_EQUAL(24u, values.size());
+  BOOST_CHECK_EQUAL(3u, values.extent(1));
+  for (std::size_t i{}; i < values.size(); ++i)
+    values.values()[i] = static_cast<double>(i);
+  BOOST_CHECK_EQUAL(0.0, values(0, 0, 0));
+  BOOST_CHECK_EQUAL(3.0, values(0, 0, 3));
+  BOOST_CHECK_EQUAL(4.0, values(0, 1, 0));
+  BOOST_CHECK_EQUAL(23.0, values(1, 2, 3));
+
+#ifdef __cpp_lib_mdspan
+  const auto view{values.mdspan()};
+  BOOST_CHECK_EQUAL(4u, view.extent(2));
+  BOOST_CHECK_EQUAL(23.0, (view[1, 2, 3]));
+#endif
+
+  // A generic two dimensional grid
+  const std::vector<double> outer{1.0, 2.0};
+  const std::vector<double> inner{10.0, 20.0, 30.0};
+  const auto sums{grid::evaluate_grid<double>(
+      outer, inner, [](const double x) { return 100.0 * x; },
+      [](const double y) { return y; },
+      [](const double x, const double y) { return x + y; })};
+  BOOST_CHECK_EQUAL(2u, sums.extent(0));
+  BOOST_CHECK_EQUAL(3u, sums.extent(1));
+  BOOST_CHECK_EQUAL(110.0, sums(0, 0));
+  BOOST_CHECK_EQUAL(230.0, sums(1, 2));
+}
+//////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////
+BOOST_AUTO_TEST_CASE(test_pressure_and_density) {
+  const auto pressures{grid::calculate_isa_pressure<double>(ALTITUDES)};
+  const auto densities{grid::calculate_density<double>(ALTITUDES, DELTAS)};
+  for (std::size_t a{}; a < ALTITUDES.size(); ++a) {
+    const auto altitude{Metres<double>(ALTITUDES[a])};
+    const auto pressure{calculate_isa_pressure(altitude)};
+    BOOST_CHECK_EQUAL(pressure.v(), pressures(a));
+    for (std::size_t d{}; d < DELTAS.size(); ++d)
+      BOOST_CHECK_CLOSE(
+          calculate_density(pressure, calculate_isa_temperature(
+                                          altitude, Kelvin<double>(DELTAS[d])))
+              .v(),
+          densities(a, d), CALCULATION_TOLERANCE);
+  }
+}
+//////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////
+BOOST_AUTO_TEST_CASE(test_air_speeds) {
+  const auto tas{grid::calculate_true_air_speed<double>(ALTITUDES, DELTAS,
+                                                        SPEEDS)};
+  const auto cas{grid::calculate_calibrated_air_speed<double>(ALTITUDES,
+                                                              DELTAS, SPEEDS)};
+  BOOST_CHECK_EQUAL(ALTITUDES.size(), tas.extent(0));
+  BOOST_CHECK_EQUAL(DELTAS.size(), tas.extent(1));
+  BOOST_CHECK_EQUAL(SPEEDS.size(), tas.extent(2));
+
+  for (std::size_t a{}; a < ALTITUDES.size(); ++a) {
+    const auto altitude{Metres<double>(ALTITUDES[a])};
+    const auto pressure{calculate_isa_pressure(altitude)};
+    for (std::size_t d{}; d < DELTAS.size(); ++d) {
+      const auto temperature{
+          calculate_isa_temperature(altitude, Kelvin<double>(DELTAS[d]))};
+      for (std::size_t s{}; s < SPEEDS.size(); ++s) {
+        const auto speed{MetresPerSecond<double>(SPEEDS[s])};
+        BOOST_CHECK_CLOSE(
+            calculate_true_air_speed(speed, pressure, temperature).v(),
+            tas(a, d, s), CALCULATION_TOLERANCE);
+        BOOST_CHECK_CLOSE(
+            calculate_calibrated_air_speed(speed, pressure, temperature).v(),
+            cas(a, d, s), CALCULATION_TOLERANCE);
+      }
+    }
+  }
+}
+//////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////
+BOOST_AUTO_TEST_CASE(test_crossover_altitudes) {
+  const std::vector<double> cas{130.0, 150.0, 170.0};
+  const std::vector<double> machs{0.7, 0.78, 0.85};
+  const auto altitudes{grid::calculate_crossover_altitude<double>(cas, machs)};
+  for (std::size_t c{}; c < cas.size(); ++c)
+    for (std::size_t m{}; m < machs.size(); ++m)
+      BOOST_CHECK_CLOSE(
+          calculate_crossover_altitude(MetresPerSecond<double>(cas[c]),
+                                       machs[m])
+              .v(),
+          altitudes(c, m), CALCULATION_TOLERANCE);
+}
+//////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_SUITE_END()
+//////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,132 @@
+//////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2024 Ken Barker
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+/// @file
+/// @brief Contains tests for the via::isa::humidity namespace.
+//////////////////////////////////////////////////////////////////////////////
+#include "via/isa/humidity.hpp"
+#include <boost/test/unit_test.hpp>
+#include <vector>
+
+using namespace via::isa;
+using namespace via::units::si;
+
+namespace {
+const double CALCULATION_TOLERANCE(1.0e-9);
+} // namespace
+
+//////////////////////////////////////////////////////////////////////////////
+BOOST_AUTO_TEST_SUITE(Test_humidity_double)
+
+//////////////////////////////////////////////////////////////////////////////
+BOOST_AUTO_TEST_CASE(test_saturation_vapour_pressure) {
+  // Reference values of saturation vapour pressure over water
+  BOOST_CHECK_CLOSE(611.2,
+                    humidity::saturation_vapour_pressure(Kelvin<double>(273.15))
+                        .v(),
+                    0.1);
+  BOOST_CHECK_CLOSE(2338.8,
+                    humidity::saturation_vapour_pressure(Kelvin<double>(293.15))
+                        .v(),
+                    0.5);
+  BOOST_CHECK_CLOSE(7384.0,
+                    humidity::saturation_vapour_pressure(Kelvin<double>(313.15))
+                        .v(),
+                    0.5);
+}
+//////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////
+BOOST_AUTO_TEST_CASE(test_virtual_temperature) {
+  const auto p{Pascals<double>(101325.0)};
+  const auto t{Kelvin<double>(303.15)};
+
+  // Dry air
+  BOOST_CHECK_EQUAL(t.v(), humidity::calculate_virtual_temperature(
+                               p, t, Pascals<double>(0.0))
+                               .v());
+  BOOST_CHECK_EQUAL(calculate_density(p, t).v(),
+                    humidity::calculate_density(p, t, 0.0).v());
+
+  // Saturated air at 30°C is about 5K warmer virtually and 1.7% less dense
+  const auto tv{humidity::calculate_virtual_temperature(
+      p, t, humidity::saturation_vapour_pressure(t))};
+  BOOST_CHECK_CLOSE(308.0, tv.v(), 0.05);
+  const auto density{humidity::calculate_density(p, t, 1.0)};
+  BOOST_CHECK_CLOSE(calculate_density(p, tv).v(), density.v(),
+                    CALCULATION_TOLERANCE);
+  BOOST_CHECK_CLOSE(1.145, density.v(), 0.1);
+
+  // The dewpoint of saturated air is its temperature
+  BOOST_CHECK_EQUAL(density.v(),
+                    humidity::calculate_density_dewpoint(p, t, t).v());
+}
+//////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////
+BOOST_AUTO_TEST_CASE(test_batch_density) {
+  const std::vector<double> pressures{101325.0, 95000.0, 90000.0, 80000.0};
+  const std::vector<double> temperatures{303.15, 298.15, 288.15, 278.15};
+  const std::vector<double> humidities{0.9, 0.5, 0.3, 0.0};
+  const std::vector<double> dewpoints{293.15, 290.15, 280.15, 270.15};
+  std::vector<double> densities(4);
+
+  humidity::calculate_density<double>(pressures, temperatures, humidities,
+                                      densities);
+  for (std::size_t i{}; i < densities.size(); ++i)
+    BOOST_CHECK_EQUAL(humidity::calculate_density(
+                          Pascals<double>(pressures[i]),
+                          Kelvin<double>(temperatures[i]), humidities[i])
+                          .v(),
+                      densities[i]);
+
+  humidity::calculate_density<double>(pressures, temperatures, 0.6, densities);
+  for (std::size_t i{}; i < densities.size(); ++i)
+    BOOST_CHECK_EQUAL(humidity::calculate_density(
+                          Pascals<double>(pressures[i]),
+                          Kelvin<double>(temperatures[i]), 0.6)
+                          .v(),
+                      densities[i]);
+
+  humidity::calculate_density_dewpoint<double>(pressures, temperatures,
+                                               dewpoints, densities);
+  for (std::size_t i{}; i < densities.size(); ++i)
+    BOOST_CHECK_EQUAL(humidity::calculate_density_dewpoint(
+                          Pascals<double>(pressures[i]),
+                          Kelvin<double>(temperatures[i]),
+                          Kelvin<double>(dewpoints[i]))
+                          .v(),
+                      densities[i]);
+
+  humidity::calculate_density_dewpoint<double>(
+      pressures, temperatures, Kelvin<double>(280.15), densities);
+  for (std::size_t i{}; i < densities.size(); ++i)
+    BOOST_CHECK_EQUAL(humidity::calculate_density_dewpoint(
+                          Pascals<double>(pressures[i]),
+                          Kelvin<double>(temperatures[i]),
+                          Kelvin<double>(280.15))
+                          .v(),
+                      densities[i]);
+}
+//////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_SUITE_END()
+//////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,210 @@
+//////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2024 Ken Barker
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+/// @file
+/// @brief Contains tests for the via::isa::interval namespace.
+//////////////////////////////////////////////////////////////////////////////
+#include "via/isa/interval.hpp"
+#include <boost/test/unit_test.hpp>
+#include <vector>
+
+using namespace via::isa;
+using namespace via::units::si;
+using interval::Interval;
+
+namespace {
+constexpr int SAMPLES{8};
+
+/// @return sample values across an interval, including its bounds.
+auto samples(const Interval<double> range) -> std::vector<double> {
+  std::vector<double> values;
+  for (int i{}; i <= SAMPLES; ++i)
+    values.push_back(range.lower + range.width() * i / SAMPLES);
+  return values;
+}
+} // namespace
+
+//////////////////////////////////////////////////////////////////////////////
+BOOST_AUTO_TEST_SUITE(Test_interval_double)
+
+//////////////////////////////////////////////////////////////////////////////
+BOOST_AUTO_TEST_CASE(test_make_interval) {
+  const auto range{interval::make_interval(1000.0, 30.0)};
+  BOOST_CHECK_EQUAL(970.0, range.lower);
+  BOOST_CHECK_EQUAL(1030.0, range.upper);
+  BOOST_CHECK_EQUAL(60.0, range.width());
+  BOOST_CHECK(range.contains(1000.0));
+  BOOST_CHECK(!range.contains(1030.1));
+
+  const auto rounded{interval::round_outwards(1.0, 2.0)};
+  BOOST_CHECK(rounded.lower < 1.0);
+  BOOST_CHECK(rounded.upper > 2.0);
+  BOOST_CHECK_CLOSE(1.0, rounded.lower, 1e-10);
+  BOOST_CHECK_CLOSE(2.0, rounded.upper, 1e-10);
+}
+//////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////
+BOOST_AUTO_TEST_CASE(test_atmosphere_bounds) {
+  // Across the tropopause
+  for (const double altitude : {0.0, 5000.0, 10950.0, 15000.0}) {
+    const auto h{interval::make_interval(altitude, 60.0)};
+    const auto d{interval::make_interval(-5.0, 2.0)};
+    const auto p{interval::calculate_isa_pressure(h)};
+    const auto t{interval::calculate_isa_temperature(h, d)};
+    const auto h2{interval::calculate_isa_altitude(p)};
+    BOOST_CHECK(h2.lower <= h.lower);
+    BOOST_CHECK(h.upper <= h2.upper);
+
+    for (const double x : samples(h)) {
+      BOOST_CHECK(p.contains(calculate_isa_pressure(Metres<double>(x)).v()));
+      for (const double y : samples(d))
+        BOOST_CHECK(t.contains(
+            calculate_isa_temperature(Metres<double>(x), Kelvin<double>(y))
+                .v()));
+    }
+
+    const auto rho{interval::calculate_density(p, t)};
+    for (const double x : samples(p))
+      for (const double y : samples(t))
+        BOOST_CHECK(rho.contains(
+            calculate_density(Pascals<double>(x), Kelvin<double>(y)).v()));
+
+    const auto a{interval::speed_of_sound(t)};
+    for (const double y : samples(t))
+      BOOST_CHECK(a.contains(speed_of_sound(Kelvin<double>(y)).v()));
+  }
+}
+//////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////
+BOOST_AUTO_TEST_CASE(test_speed_bounds) {
+  const auto p{interval::make_interval(30000.0, 300.0)};
+  const auto t{interval::make_interval(230.0, 3.0)};
+  const auto cas{interval::make_interval(140.0, 2.0)};
+
+  const auto tas{interval::calculate_true_air_speed(cas, p, t)};
+  const auto cas2{interval::calculate_calibrated_air_speed(tas, p, t)};
+  BOOST_CHECK(cas2.lower <= cas.lower);
+  BOOST_CHECK(cas.upper <= cas2.upper);
+
+  const auto cas_mach{interval::calibrated_air_speed_mach(cas, p)};
+  const auto tas_mach{interval::true_air_speed_mach(tas, t)};
+  for (const double c : samples(cas))
+    for (const double x : samples(p)) {
+      BOOST_CHECK(cas_mach.contains(calibrated_air_speed_mach(
+          MetresPerSecond<double>(c), Pascals<double>(x))));
+      for (const double y : samples(t)) {
+        const auto speed{calculate_true_air_speed(
+            MetresPerSecond<double>(c), Pascals<double>(x), Kelvin<double>(y))};
+        BOOST_CHECK(tas.contains(speed.v()));
+        BOOST_CHECK(
+            tas_mach.contains(true_air_speed_mach(speed, Kelvin<double>(y))));
+      }
+    }
+
+  const auto mach{interval::make_interval(0.78, 0.01)};
+  const auto mach_tas{interval::mach_true_air_speed(mach, t)};
+  for (const double m : samples(mach))
+    for (const double y : samples(t))
+      BOOST_CHECK(
+          mach_tas.contains(mach_true_air_speed(m, Kelvin<double>(y)).v()));
+}
+//////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////
+BOOST_AUTO_TEST_CASE(test_cancellation_bounds) {
+  // Near Sea level, altitude subtracts nearly equal numbers
+  for (int i{}; i <= 200; ++i) {
+    const double pressure{101324.9 + 0.001 * i};
+    const auto h{interval::calculate_isa_altitude(
+        Interval<double>{pressure, pressure})};
+    const long double exact{
+        calculate_isa_altitude(Pascals<long double>(pressure)).v()};
+    BOOST_CHECK(h.lower <= exact);
+    BOOST_CHECK(exact <= h.upper);
+  }
+
+  // Near zero speed, the air speeds subtract nearly equal numbers
+  const auto p{Interval<double>{30000.0, 30000.0}};
+  const auto t{Interval<double>{230.0, 230.0}};
+  for (const double speed : {0.0, 1e-6, 1e-3, 0.1, 1.0}) {
+    const auto v{Interval<double>{speed, speed}};
+    const auto tas{interval::calculate_true_air_speed(v, p, t)};
+    const auto cas{interval::calculate_calibrated_air_speed(v, p, t)};
+    const auto mach{interval::calibrated_air_speed_mach(v, p)};
+    const long double exact_tas{
+        calculate_true_air_speed(MetresPerSecond<long double>(speed),
+                                 Pascals<long double>(p.lower),
+                                 Kelvin<long double>(t.lower))
+            .v()};
+    const long double exact_cas{
+        calculate_calibrated_air_speed(MetresPerSecond<long double>(speed),
+                                       Pascals<long double>(p.lower),
+                                       Kelvin<long double>(t.lower))
+            .v()};
+    const long double exact_mach{calibrated_air_speed_mach(
+        MetresPerSecond<long double>(speed), Pascals<long double>(p.lower))};
+    BOOST_CHECK((tas.lower <= exact_tas) && (exact_tas <= tas.upper));
+    BOOST_CHECK((cas.lower <= exact_cas) && (exact_cas <= cas.upper));
+    BOOST_CHECK((mach.lower <= exact_mach) && (exact_mach <= mach.upper));
+  }
+}
+//////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////
+BOOST_AUTO_TEST_CASE(test_batch_bounds) {
+  const std::vector<Interval<double>> altitudes{
+      {0.0, 100.0}, {3000.0, 3100.0}, {9000.0, 9200.0}, {12000.0, 12500.0}};
+  const std::vector<Interval<double>> deltas(4, {-10.0, -5.0});
+  const std::vector<Interval<double>> cas(4, {120.0, 125.0});
+
+  std::vector<Interval<double>> pressures(4);
+  std::vector<Interval<double>> temperatures(4);
+  std::vector<Interval<double>> densities(4);
+  std::vector<Interval<double>> tas(4);
+  std::vector<Interval<double>> machs(4);
+  interval::calculate_isa_pressure<double>(altitudes, pressures);
+  interval::calculate_isa_temperature<double>(altitudes, deltas, temperatures);
+  interval::calculate_density<double>(pressures, temperatures, densities);
+  interval::calculate_true_air_speed<double>(cas, pressures, temperatures,
+                                             tas);
+  interval::true_air_speed_mach<double>(tas, temperatures, machs);
+
+  for (std::size_t i{}; i < altitudes.size(); ++i) {
+    const auto p{interval::calculate_isa_pressure(altitudes[i])};
+    const auto t{interval::calculate_isa_temperature(altitudes[i], deltas[i])};
+    BOOST_CHECK_EQUAL(p.lower, pressures[i].lower);
+    BOOST_CHECK_EQUAL(p.upper, pressures[i].upper);
+    BOOST_CHECK_EQUAL(t.lower, temperatures[i].lower);
+    BOOST_CHECK_EQUAL(t.upper, temperatures[i].upper);
+    BOOST_CHECK_EQUAL(interval::calculate_density(p, t).upper,
+                      densities[i].upper);
+    const auto speed{interval::calculate_true_air_speed(cas[i], p, t)};
+    BOOST_CHECK_EQUAL(speed.lower, tas[i].lower);
+    BOOST_CHECK_EQUAL(interval::true_air_speed_mach(speed, t).upper,
+                      machs[i].upper);
+  }
+}
+//////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_SUITE_END()
+//////////////////////////////////////////////////////////////////////////////
@@ -192,6 +192,84 @@ BOOST_AUTO_TEST_CASE(test_mach_true_air_speed) {
 }
 //////////////////////////////////////////////////////////////////////////////
 
+//////////////////////////////////////////////////////////////////////////////
+BOOST_AUTO_TEST_CASE(test_true_air_speed_mach) {
+  double result = true_air_speed_mach(
+      constants::SEA_LEVEL_SPEED_OF_SOUND<double>,
+      constants::SEA_LEVEL_TEMPERATURE<double>);
+  BOOST_CHECK_CLOSE(1.0, result, 10 * CALCULATION_TOLERANCE);
+  result = true_air_speed_mach(MetresPerSecond<double>(0.85 * 295.069493),
+                               constants::TROPOPAUSE_TEMPERATURE<double>);
+  BOOST_CHECK_CLOSE(0.85, result, CALCULATION_TOLERANCE);
+}
+//////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////
+BOOST_AUTO_TEST_CASE(test_calculate_impact_pressure) {
+  Pascals<double> result =
+      calculate_impact_pressure(MetresPerSecond<double>(0.0));
+  BOOST_CHECK_EQUAL(0.0, result.v());
+
+  // At Sea level the impact pressure of Mach 1 is: P0 * (1.2^3.5 - 1)
+  result = calculate_impact_pressure(
+      constants::SEA_LEVEL_SPEED_OF_SOUND<double>);
+  BOOST_CHECK_CLOSE(constants::SEA_LEVEL_PRESSURE<double>.v() *
+                        (std::pow(1.2, 3.5) - 1.0),
+                    result.v(), 10 * CALCULATION_TOLERANCE);
+}
+//////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////
+BOOST_AUTO_TEST_CASE(test_calibrated_air_speed_mach) {
+  // At Sea level CAS is TAS
+  double result = calibrated_air_speed_mach(
+      MetresPerSecond<double>(150.0), constants::SEA_LEVEL_PRESSURE<double>);
+  BOOST_CHECK_CLOSE(150.0 / constants::SEA_LEVEL_SPEED_OF_SOUND<double>.v(),
+                    result, 10 * CALCULATION_TOLERANCE);
+
+  // Round trips through TAS at a range of altitudes and temperatures
+  for (const double altitude : {0.0, 3000.0, 9000.0, 11000.0, 13000.0}) {
+    const auto pressure{calculate_isa_pressure(Metres<double>(altitude))};
+    for (const double delta : {-20.0, 0.0, 20.0}) {
+      const auto temperature{
+          calculate_isa_temperature(Metres<double>(altitude),
+                                    Kelvin<double>(delta))};
+      for (const double cas_value : {60.0, 130.0, 180.0, 230.0}) {
+        const auto cas{MetresPerSecond<double>(cas_value)};
+        const auto tas{calculate_true_air_speed(cas, pressure, temperature)};
+        const auto mach{calibrated_air_speed_mach(cas, pressure)};
+        BOOST_CHECK_CLOSE(tas.v() / speed_of_sound(temperature).v(), mach,
+                          CALCULATION_TOLERANCE);
+        BOOST_CHECK_CLOSE(true_air_speed_mach(tas, temperature), mach,
+                          CALCULATION_TOLERANCE);
+        BOOST_CHECK_CLOSE(cas_value,
+                          mach_calibrated_air_speed(mach, pressure).v(),
+                          CALCULATION_TOLERANCE);
+        BOOST_CHECK_CLOSE(tas.v(), mach_true_air_speed(mach, temperature).v(),
+                          CALCULATION_TOLERANCE);
+      }
+    }
+  }
+}
+//////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////
+BOOST_AUTO_TEST_CASE(test_mach_calibrated_air_speed) {
+  // At Sea level CAS is TAS
+  MetresPerSecond<double> result =
+      mach_calibrated_air_speed(0.5, constants::SEA_LEVEL_PRESSURE<double>);
+  BOOST_CHECK_CLOSE(0.5 * constants::SEA_LEVEL_SPEED_OF_SOUND<double>.v(),
+                    result.v(), 10 * CALCULATION_TOLERANCE);
+
+  // The CAS of the Mach number at the crossover altitude
+  const auto cas{MetresPerSecond<double>(155.0)};
+  const auto crossover_altitude{calculate_crossover_altitude(cas, 0.79)};
+  result = mach_calibrated_air_speed(
+      0.79, calculate_isa_pressure(crossover_altitude));
+  BOOST_CHECK_CLOSE(cas.v(), result.v(), 4 * CALCULATION_TOLERANCE);
+}
+//////////////////////////////////////////////////////////////////////////////
+
 //////////////////////////////////////////////////////////////////////////////
 BOOST_AUTO_TEST_CASE(test_calculate_crossover_altitude) {
   auto cas = MetresPerSecond<double>(155.0);
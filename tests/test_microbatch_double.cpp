@@ -0,0 +1,115 @@
+//////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2024 Ken Barker
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+/// @file
+/// @brief Contains tests for the MicroBatcher class.
+//////////////////////////////////////////////////////////////////////////////
+#include "via/isa/microbatch.hpp"
+#include <boost/test/unit_test.hpp>
+#include <atomic>
+#include <vector>
+
+using namespace via::isa;
+using namespace via::units::si;
+
+//////////////////////////////////////////////////////////////////////////////
+BOOST_AUTO_TEST_SUITE(Test_microbatch_double)
+
+//////////////////////////////////////////////////////////////////////////////
+BOOST_AUTO_TEST_CASE(test_microbatcher) {
+  MicroBatcher<double> batcher({.latency_budget = std::chrono::microseconds(100),
+                                .max_batch_size = 64});
+
+  auto pressure{batcher.calculate_isa_pressure(Metres<double>(10000.0))};
+  auto tas{batcher.calculate_true_air_speed(MetresPerSecond<double>(150.0),
+                                            Pascals<double>(30000.0),
+                                            Kelvin<double>(230.0))};
+  BOOST_CHECK_EQUAL(calculate_isa_pressure(Metres<double>(10000.0)).v(),
+                    pressure.get().v());
+  BOOST_CHECK_EQUAL(calculate_true_air_speed(MetresPerSecond<double>(150.0),
+                                             Pascals<double>(30000.0),
+                                             Kelvin<double>(230.0))
+                        .v(),
+                    tas.get().v());
+
+  const auto statistics{batcher.statistics()};
+  BOOST_CHECK_EQUAL(2u, statistics.requests);
+  BOOST_CHECK(statistics.batches >= 1u);
+}
+//////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////
+BOOST_AUTO_TEST_CASE(test_microbatcher_threads) {
+  constexpr std::size_t THREADS{8};
+  constexpr std::size_t REQUESTS{500};
+
+  MicroBatcher<double> batcher({.latency_budget = std::chrono::microseconds(200),
+                                .max_batch_size = 16});
+  std::atomic<std::size_t> errors{0};
+  {
+    std::vector<std::jthread> threads;
+    for (std::size_t t{}; t < THREADS; ++t)
+      threads.emplace_back([&batcher, &errors, t] {
+        // Submit a few values at a time, as a request handler would
+        for (std::size_t i{}; i < REQUESTS; i += 2) {
+          const auto altitude{Metres<double>(static_cast<double>(t * i))};
+          auto p0{batcher.calculate_isa_pressure(altitude)};
+          auto p1{batcher.calculate_isa_pressure(
+              Metres<double>(altitude.v() + 1.0))};
+          if ((p0.get() != calculate_isa_pressure(altitude)) ||
+              (p1.get() !=
+               calculate_isa_pressure(Metres<double>(altitude.v() + 1.0))))
+            ++errors;
+        }
+      });
+  }
+  BOOST_CHECK_EQUAL(0u, errors.load());
+
+  const auto statistics{batcher.statistics()};
+  BOOST_CHECK_EQUAL(THREADS * REQUESTS, statistics.requests);
+  BOOST_CHECK(statistics.mean_batch_size() > 1.0);
+  BOOST_CHECK(statistics.mean_batch_size() <= 16.0);
+}
+//////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////
+BOOST_AUTO_TEST_CASE(test_microbatcher_destructor) {
+  std::vector<std::future<Pascals<double>>> futures;
+  {
+    // A long latency budget: the destructor calculates the pending values
+    MicroBatcher<double> batcher(
+        {.latency_budget = std::chrono::seconds(60), .max_batch_size = 1000});
+    for (int i{}; i < 10; ++i)
+      futures.push_back(batcher.calculate_isa_pressure(
+          Metres<double>(1000.0 * static_cast<double>(i))));
+  }
+  for (std::size_t i{}; i < futures.size(); ++i)
+    BOOST_CHECK_EQUAL(
+        calculate_isa_pressure(Metres<double>(1000.0 * static_cast<double>(i)))
+            .v(),
+        futures[i].get().v());
+
+  BOOST_CHECK_EQUAL(0.0, MicroBatchStatistics{}.mean_batch_size());
+}
+//////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_SUITE_END()
+//////////////////////////////////////////////////////////////////////////////
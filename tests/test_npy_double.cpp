@@ -0,0 +1,245 @@
+//////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2024 Ken Barker
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+/// @file
+/// @brief Contains tests for the via::isa::npy namespace.
+//////////////////////////////////////////////////////////////////////////////
+#include "via/isa/npy.hpp"
+#include "via/isa/batch.hpp"
+#include <boost/test/unit_test.hpp>
+#include <fstream>
+
+using namespace via::isa;
+using namespace via::units::si;
+
+namespace {
+/// A temporary file which is deleted when it goes out of scope.
+struct TemporaryFile {
+  std::filesystem::path path;
+
+  explicit TemporaryFile(const std::string &name)
+      : path{std::filesystem::temp_directory_path() / name} {}
+  ~TemporaryFile() { std::filesystem::remove(path); }
+};
+
+/// Write little-endian bytes of an unsigned integer to a string.
+template <typename Int> void write_le(std::string &bytes, Int value) {
+  for (std::size_t i{}; i < sizeof(Int); ++i, value >>= 8)
+    bytes += static_cast<char>(value & 0xff);
+}
+
+/// Write an uncompressed zip archive containing an `.npy` array.
+/// An odd length extra field is added to the local header so that the array
+/// data is not aligned.
+void write_npz(const std::filesystem::path &path, const std::string &name,
+               const std::vector<double> &values) {
+  const std::size_t shape{values.size()};
+  auto npy{npy::make_header(std::span(&shape, 1))};
+  npy.append(reinterpret_cast<const char *>(values.data()),
+             values.size() * sizeof(double));
+
+  const std::string extra(5, '\0');
+  std::string zip;
+  write_le<std::uint32_t>(zip, 0x0403'4b50);
+  write_le<std::uint16_t>(zip, 20); // version
+  write_le<std::uint16_t>(zip, 0);  // flags
+  write_le<std::uint16_t>(zip, 0);  // stored
+  write_le<std::uint32_t>(zip, 0);  // time and date
+  write_le<std::uint32_t>(zip, 0);  // crc, unchecked
+  write_le<std::uint32_t>(zip, static_cast<std::uint32_t>(npy.size()));
+  write_le<std::uint32_t>(zip, static_cast<std::uint32_t>(npy.size()));
+  write_le<std::uint16_t>(zip, static_cast<std::uint16_t>(name.size()));
+  write_le<std::uint16_t>(zip, static_cast<std::uint16_t>(extra.size()));
+  zip += name + extra + npy;
+
+  const auto directory{zip.size()};
+  write_le<std::uint32_t>(zip, 0x0201'4b50);
+  write_le<std::uint16_t>(zip, 20); // version made by
+  write_le<std::uint16_t>(zip, 20); // version needed
+  write_le<std::uint16_t>(zip, 0);  // flags
+  write_le<std::uint16_t>(zip, 0);  // stored
+  write_le<std::uint32_t>(zip, 0);  // time and date
+  write_le<std::uint32_t>(zip, 0);  // crc, unchecked
+  write_le<std::uint32_t>(zip, static_cast<std::uint32_t>(npy.size()));
+  write_le<std::uint32_t>(zip, static_cast<std::uint32_t>(npy.size()));
+  write_le<std::uint16_t>(zip, static_cast<std::uint16_t>(name.size()));
+  write_le<std::uint16_t>(zip, 0); // extra length
+  write_le<std::uint16_t>(zip, 0); // comment length
+  write_le<std::uint16_t>(zip, 0); // disk
+  write_le<std::uint16_t>(zip, 0); // internal attributes
+  write_le<std::uint32_t>(zip, 0); // external attributes
+  write_le<std::uint32_t>(zip, 0); // local header offset
+  zip += name;
+
+  const auto directory_size{zip.size() - directory};
+  write_le<std::uint32_t>(zip, 0x0605'4b50);
+  write_le<std::uint16_t>(zip, 0); // disk
+  write_le<std::uint16_t>(zip, 0); // directory disk
+  write_le<std::uint16_t>(zip, 1); // entries on disk
+  write_le<std::uint16_t>(zip, 1); // entries
+  write_le<std::uint32_t>(zip, static_cast<std::uint32_t>(directory_size));
+  write_le<std::uint32_t>(zip, static_cast<std::uint32_t>(directory));
+  write_le<std::uint16_t>(zip, 0); // comment length
+
+  std::ofstream(path, std::ios::binary) << zip;
+}
+} // namespace
+
+//////////////////////////////////////////////////////////////////////////////
+BOOST_AUTO_TEST_SUITE(Test_npy_double)
+
+//////////////////////////////////////////////////////////////////////////////
+BOOST_AUTO_TEST_CASE(test_npy_header) {
+  const std::size_t shape[]{3, 4};
+  const auto header{npy::make_header(shape)};
+  BOOST_CHECK_EQUAL(0u, header.size() % 64);
+
+  const auto parsed{npy::parse_header(std::as_bytes(std::span(header)))};
+  BOOST_CHECK_EQUAL("<f8", parsed.descr);
+  BOOST_CHECK(!parsed.fortran_order);
+  BOOST_CHECK_EQUAL(2u, parsed.shape.size());
+  BOOST_CHECK_EQUAL(12u, parsed.size());
+  BOOST_CHECK_EQUAL(header.size(), parsed.data_offset);
+
+  // A header written by numpy.save
+  std::string dict{
+      "{'descr': '<f8', 'fortran_order': False, 'shape': (1000,), }"};
+  dict.resize(117, ' ');
+  const auto numpy_header{std::string("\x93NUMPY\x01\x00\x76\x00", 10) +
+                          dict + '\n'};
+  const auto numpy_parsed{
+      npy::parse_header(std::as_bytes(std::span(numpy_header)))};
+  BOOST_CHECK_EQUAL(1u, numpy_parsed.shape.size());
+  BOOST_CHECK_EQUAL(1000u, numpy_parsed.size());
+  BOOST_CHECK_EQUAL(128u, numpy_parsed.data_offset);
+
+  // Truncated header dictionaries
+  for (const std::string truncated :
+       {"{'descr':", "{'descr': '<f8'", "{'descr': '<f8', 'shape': (1000,"}) {
+    const auto truncated_header{
+        std::string("\x93NUMPY\x01\x00", 8) +
+        static_cast<char>(truncated.size()) + '\0' + truncated};
+    BOOST_CHECK_THROW(static_cast<void>(npy::parse_header(
+                          std::as_bytes(std::span(truncated_header)))),
+                      std::runtime_error);
+  }
+}
+//////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////
+BOOST_AUTO_TEST_CASE(test_process_npy) {
+  const TemporaryFile altitudes_file{"via_isa_test_altitudes.npy"};
+  const TemporaryFile pressures_file{"via_isa_test_pressures.npy"};
+
+  constexpr std::size_t SIZE{10'007};
+  {
+    const std::size_t shape{SIZE};
+    const auto altitudes{
+        npy::create_column(altitudes_file.path, std::span(&shape, 1))};
+    const auto values{altitudes.mutable_chunk(0, SIZE)};
+    for (std::size_t i{}; i < SIZE; ++i)
+      values[i] = static_cast<double>(i);
+  }
+
+  std::vector<npy::Column> inputs;
+  inputs.push_back(npy::open_column(altitudes_file.path));
+  BOOST_CHECK_EQUAL(SIZE, inputs.front().size());
+
+  npy::process_npy(
+      inputs, pressures_file.path,
+      [](std::span<const std::span<const double>> in, std::span<double> out) {
+        batch::calculate_isa_pressure(in[0], out);
+      },
+      {.chunk_size = 1000, .threads = 4});
+
+  const auto pressures{npy::open_column(pressures_file.path)};
+  BOOST_CHECK_EQUAL(SIZE, pressures.size());
+  std::vector<double> scratch;
+  const auto values{pressures.chunk(0, SIZE, scratch)};
+  BOOST_CHECK(scratch.empty());
+  for (std::size_t i{}; i < SIZE; i += 101)
+    BOOST_CHECK_EQUAL(
+        calculate_isa_pressure(Metres<double>(static_cast<double>(i))).v(),
+        values[i]);
+
+  // The output must not overwrite an input
+  BOOST_CHECK_EQUAL(altitudes_file.path, inputs.front().path());
+  const auto copy{[](std::span<const std::span<const double>> in,
+                     std::span<double> out) {
+    std::ranges::copy(in[0], out.begin());
+  }};
+  BOOST_CHECK_THROW(npy::process_npy(inputs, altitudes_file.path, copy),
+                    std::invalid_argument);
+  BOOST_CHECK_EQUAL(SIZE, npy::open_column(altitudes_file.path).size());
+  BOOST_CHECK_EQUAL(static_cast<double>(SIZE - 1),
+                    inputs.front().chunk(SIZE - 1, 1, scratch)[0]);
+}
+//////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////
+BOOST_AUTO_TEST_CASE(test_process_npz) {
+  const TemporaryFile npz_file{"via_isa_test_columns.npz"};
+  const TemporaryFile densities_file{"via_isa_test_densities.npy"};
+
+  constexpr std::size_t SIZE{1'000};
+  std::vector<double> pressures(SIZE);
+  std::vector<double> temperatures(SIZE);
+  for (std::size_t i{}; i < SIZE; ++i) {
+    const auto altitude{Metres<double>(10.0 * static_cast<double>(i))};
+    pressures[i] = calculate_isa_pressure(altitude).v();
+    temperatures[i] = calculate_isa_temperature(altitude).v();
+  }
+  write_npz(npz_file.path, "pressure.npy", pressures);
+  const TemporaryFile temperatures_file{"via_isa_test_temperatures.npy"};
+  {
+    const std::size_t shape{SIZE};
+    const auto column{
+        npy::create_column(temperatures_file.path, std::span(&shape, 1))};
+    std::ranges::copy(temperatures, column.mutable_chunk(0, SIZE).begin());
+  }
+
+  std::vector<npy::Column> inputs;
+  inputs.push_back(npy::open_npz_column(npz_file.path, "pressure"));
+  inputs.push_back(npy::open_column(temperatures_file.path));
+  BOOST_CHECK_THROW(static_cast<void>(
+                        npy::open_npz_column(npz_file.path, "temperature")),
+                    std::runtime_error);
+
+  npy::process_npy(
+      inputs, densities_file.path,
+      [](std::span<const std::span<const double>> in, std::span<double> out) {
+        batch::calculate_density(in[0], in[1], out);
+      },
+      {.chunk_size = 64, .threads = 3});
+
+  const auto densities{npy::open_column(densities_file.path)};
+  std::vector<double> scratch;
+  const auto values{densities.chunk(0, SIZE, scratch)};
+  for (std::size_t i{}; i < SIZE; ++i)
+    BOOST_CHECK_EQUAL(calculate_density(Pascals<double>(pressures[i]),
+                                        Kelvin<double>(temperatures[i]))
+                          .v(),
+                      values[i]);
+}
+//////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_SUITE_END()
+//////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,180 @@
+//////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2024 Ken Barker
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+/// @file
+/// @brief Contains tests for the parallel functions.
+//////////////////////////////////////////////////////////////////////////////
+#include "via/isa/parallel.hpp"
+#include <boost/test/unit_test.hpp>
+#include <numeric>
+#include <stdexcept>
+
+using namespace via::isa;
+
+//////////////////////////////////////////////////////////////////////////////
+BOOST_AUTO_TEST_SUITE(Test_parallel)
+
+//////////////////////////////////////////////////////////////////////////////
+BOOST_AUTO_TEST_CASE(test_thread_count) {
+  BOOST_CHECK_EQUAL(4u, thread_count(4, 100));
+  BOOST_CHECK_EQUAL(2u, thread_count(4, 2));
+  BOOST_CHECK_EQUAL(1u, thread_count(4, 0));
+  BOOST_CHECK(1u <= thread_count(0, 100));
+}
+//////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////
+BOOST_AUTO_TEST_CASE(test_parallel_for) {
+  constexpr std::size_t COUNT{1000};
+  std::vector<std::atomic<int>> calls(COUNT);
+  parallel_for(COUNT, [&](const std::size_t i) { ++calls[i]; }, 4);
+  for (const auto &c : calls)
+    BOOST_CHECK_EQUAL(1, c.load());
+
+  // No calls for no indices
+  parallel_for(0, [&](const std::size_t i) { ++calls[i]; }, 4);
+
+  // An exception is rethrown in the calling thread
+  BOOST_CHECK_THROW(parallel_for(
+                        COUNT,
+                        [](const std::size_t i) {
+                          if (i == 500)
+                            throw std::runtime_error("error");
+                        },
+                        4),
+                    std::runtime_error);
+}
+//////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////
+BOOST_AUTO_TEST_CASE(test_work_stealing_deque) {
+  detail::WorkStealingDeque deque;
+  IndexRange range{};
+  BOOST_CHECK(!deque.take(range));
+  BOOST_CHECK(!deque.steal(range));
+
+  BOOST_CHECK(deque.push({0, 10}));
+  BOOST_CHECK(deque.push({10, 20}));
+  BOOST_CHECK(deque.push({20, 30}));
+
+  // The owner takes the newest range, thieves steal the oldest
+  BOOST_CHECK(deque.take(range));
+  BOOST_CHECK_EQUAL(20u, range.begin);
+  BOOST_CHECK(deque.steal(range));
+  BOOST_CHECK_EQUAL(0u, range.begin);
+  BOOST_CHECK(deque.take(range));
+  BOOST_CHECK_EQUAL(10u, range.begin);
+  BOOST_CHECK_EQUAL(10u, range.size());
+  BOOST_CHECK(!deque.take(range));
+
+  // The deque does not grow
+  for (std::size_t i{}; i < detail::WorkStealingDeque::CAPACITY; ++i)
+    BOOST_CHECK(deque.push({i, i + 1}));
+  BOOST_CHECK(!deque.push({0, 1}));
+}
+//////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////
+BOOST_AUTO_TEST_CASE(test_work_stealing_for) {
+  constexpr std::size_t COUNT{100000};
+  constexpr std::size_t GRAIN{64};
+  for (const std::size_t threads : {1u, 2u, 4u, 7u}) {
+    std::vector<std::atomic<int>> calls(COUNT);
+    std::atomic<bool> too_large{false};
+    work_stealing_for(
+        COUNT,
+        [&](const std::size_t begin, const std::size_t end) {
+          if (end - begin > GRAIN)
+            too_large = true;
+          for (auto i{begin}; i < end; ++i)
+            ++calls[i];
+        },
+        GRAIN, threads);
+    BOOST_CHECK(!too_large);
+    BOOST_CHECK(std::all_of(calls.begin(), calls.end(),
+                            [](const auto &c) { return c.load() == 1; }));
+  }
+
+  // No calls for no indices
+  work_stealing_for(
+      0, [](const std::size_t, const std::size_t) { BOOST_CHECK(false); }, 8,
+      4);
+
+  // An exception is rethrown in the calling thread
+  BOOST_CHECK_THROW(work_stealing_for(
+                        COUNT,
+                        [](const std::size_t begin, const std::size_t end) {
+                          if ((begin <= 5000) && (5000 < end))
+                            throw std::runtime_error("error");
+                        },
+                        GRAIN, 4),
+                    std::runtime_error);
+}
+//////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////
+BOOST_AUTO_TEST_CASE(test_parallel_for_trajectories) {
+  // Very short and very long trajectories
+  const std::vector<std::size_t> lengths{10, 100000, 0, 12, 3, 50000, 1, 20};
+  std::vector<std::size_t> offsets{0};
+  std::inclusive_scan(lengths.begin(), lengths.end(),
+                      std::back_inserter(offsets));
+
+  std::vector<std::atomic<int>> calls(offsets.back());
+  std::vector<std::atomic<std::size_t>> samples(lengths.size());
+  std::atomic<bool> outside{false};
+  parallel_for_trajectories(
+      offsets,
+      [&](const std::size_t trajectory, const std::size_t begin,
+          const std::size_t end) {
+        if ((begin < offsets[trajectory]) || (offsets[trajectory + 1] < end) ||
+            (begin >= end))
+          outside = true;
+        samples[trajectory] += end - begin;
+        for (auto i{begin}; i < end; ++i)
+          ++calls[i];
+      },
+      1000, 4);
+  BOOST_CHECK(!outside);
+  BOOST_CHECK(std::all_of(calls.begin(), calls.end(),
+                          [](const auto &c) { return c.load() == 1; }));
+  for (std::size_t i{}; i < lengths.size(); ++i)
+    BOOST_CHECK_EQUAL(lengths[i], samples[i].load());
+
+  // Trajectories that do not start at zero
+  const std::vector<std::size_t> tail(offsets.begin() + 3, offsets.end());
+  std::atomic<std::size_t> total{0};
+  parallel_for_trajectories(
+      tail,
+      [&](const std::size_t trajectory, const std::size_t begin,
+          const std::size_t end) {
+        if (begin < tail[trajectory])
+          outside = true;
+        total += end - begin;
+      },
+      100, 3);
+  BOOST_CHECK(!outside);
+  BOOST_CHECK_EQUAL(tail.back() - tail.front(), total.load());
+}
+//////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_SUITE_END()
+//////////////////////////////////////////////////////////////////////////////
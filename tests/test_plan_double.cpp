@@ -0,0 +1,185 @@
+//////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2024 Ken Barker
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+/// @file
+/// @brief Contains tests for the via::isa::plan namespace.
+//////////////////////////////////////////////////////////////////////////////
+#include "via/isa/plan.hpp"
+#include "via/isa/synthetic_fleet.hpp"
+#include <boost/test/unit_test.hpp>
+
+using namespace via::isa;
+using namespace via::units::si;
+
+//////////////////////////////////////////////////////////////////////////////
+BOOST_AUTO_TEST_SUITE(Test_plan_double)
+
+//////////////////////////////////////////////////////////////////////////////
+BOOST_AUTO_TEST_CASE(test_plan_graph) {
+  plan::Plan<double> isa_plan;
+  isa_plan.pressure("alt").density().true_air_speed("cas").speed_of_sound();
+
+  BOOST_CHECK((std::vector<std::string>{"alt", "cas"} == isa_plan.inputs()));
+  BOOST_CHECK((std::vector<std::string>{"pressure", "density", "tas",
+                                        "speed_of_sound"} ==
+               isa_plan.outputs()));
+  // alt, pressure, temperature, density, cas, tas, speed_of_sound
+  BOOST_CHECK_EQUAL(7u, isa_plan.nodes().size());
+  BOOST_CHECK_THROW(isa_plan.pressure("alt"), std::invalid_argument);
+  // A builder that throws does not change the Plan
+  BOOST_CHECK_THROW(isa_plan.true_air_speed("cas2", "p", "t", "density"),
+                    std::invalid_argument);
+  BOOST_CHECK((std::vector<std::string>{"alt", "cas"} == isa_plan.inputs()));
+  BOOST_CHECK_EQUAL(7u, isa_plan.nodes().size());
+  // An empty input name throws before the pressure and temperature change
+  BOOST_CHECK_THROW(isa_plan.true_air_speed("", "p", "t", "tas2"),
+                    std::invalid_argument);
+  BOOST_CHECK_THROW(isa_plan.mach_true_air_speed("", "t", "tas2"),
+                    std::invalid_argument);
+  BOOST_CHECK_THROW(isa_plan.crossover_altitude("cas", ""),
+                    std::invalid_argument);
+  BOOST_CHECK((std::vector<std::string>{"alt", "cas"} == isa_plan.inputs()));
+  BOOST_CHECK_EQUAL(7u, isa_plan.nodes().size());
+  // The current pressure and temperature are still those of "alt"
+  isa_plan.density({}, {}, "density2");
+  BOOST_CHECK_EQUAL(7u, isa_plan.nodes().size());
+
+  const auto program{isa_plan.compile()};
+  // density2 is a copy of density
+  BOOST_CHECK_EQUAL(5u, program.steps().size());
+  // Only the temperatures are not output
+  BOOST_CHECK_EQUAL(1u, program.scratch_slots());
+}
+//////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////
+BOOST_AUTO_TEST_CASE(test_plan_run) {
+  FleetParameters<double> params;
+  params.flights = 5;
+  const auto fleet{generate_synthetic_fleet(params)};
+  const auto n{fleet.size()};
+
+  plan::Plan<double> isa_plan;
+  isa_plan.temperature("altitude", "delta_temperature", "t")
+      .density()
+      .true_air_speed()
+      .calibrated_air_speed({}, {}, {}, "cas_check")
+      .crossover_altitude();
+  BOOST_CHECK((std::vector<std::string>{"altitude", "delta_temperature",
+                                        "cas", "mach"} == isa_plan.inputs()));
+
+  const std::vector<std::span<const double>> inputs{
+      fleet.altitude, fleet.delta_temperature, fleet.cas, fleet.mach};
+  std::vector<std::vector<double>> results(isa_plan.outputs().size(),
+                                           std::vector<double>(n));
+  const std::vector<std::span<double>> outputs(results.begin(), results.end());
+
+  const auto program{isa_plan.compile(100)};
+  program.run(inputs, outputs, 4);
+
+  const auto &temperatures{results[0]};
+  const auto &densities{results[1]};
+  const auto &speeds{results[2]};
+  const auto &cas{results[3]};
+  const auto &crossover_altitudes{results[4]};
+  for (std::size_t i{}; i < n; ++i) {
+    const auto altitude{Metres<double>(fleet.altitude[i])};
+    const auto pressure{calculate_isa_pressure(altitude)};
+    const auto temperature{calculate_isa_temperature(
+        altitude, Kelvin<double>(fleet.delta_temperature[i]))};
+    const auto tas{calculate_true_air_speed(
+        MetresPerSecond<double>(fleet.cas[i]), pressure, temperature)};
+    BOOST_CHECK_EQUAL(temperature.v(), temperatures[i]);
+    BOOST_CHECK_EQUAL(calculate_density(pressure, temperature).v(),
+                      densities[i]);
+    BOOST_CHECK_EQUAL(tas.v(), speeds[i]);
+    BOOST_CHECK_EQUAL(
+        calculate_calibrated_air_speed(tas, pressure, temperature).v(), cas[i]);
+    BOOST_CHECK_EQUAL(calculate_crossover_altitude(
+                          MetresPerSecond<double>(fleet.cas[i]), fleet.mach[i])
+                          .v(),
+                      crossover_altitudes[i]);
+  }
+}
+//////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////
+BOOST_AUTO_TEST_CASE(test_plan_copy_outputs) {
+  const std::vector<double> pressures{101325.0, 50000.0, 20000.0};
+
+  // An output of an input column and the same node output twice
+  plan::Plan<double> isa_plan;
+  const auto p{isa_plan.input("p")};
+  const auto h{isa_plan.add(plan::Operation::ALTITUDE, {p})};
+  isa_plan.output("p", p);
+  isa_plan.output("h1", h);
+  isa_plan.output("h2", isa_plan.add(plan::Operation::ALTITUDE, {p}));
+
+  std::vector<std::vector<double>> results(3, std::vector<double>(3));
+  const std::vector<std::span<double>> outputs(results.begin(), results.end());
+  const std::vector<std::span<const double>> inputs{pressures};
+  isa_plan.compile().run(inputs, outputs);
+
+  BOOST_CHECK(pressures == results[0]);
+  BOOST_CHECK(results[1] == results[2]);
+  BOOST_CHECK_EQUAL(
+      calculate_isa_altitude(Pascals<double>(pressures[1])).v(), results[1][1]);
+}
+//////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////
+BOOST_AUTO_TEST_CASE(test_plan_repeated_argument) {
+  const std::vector<double> altitudes{0.0, 1000.0, 11000.0};
+
+  // A node that uses the same scratch node twice releases its slot once
+  plan::Plan<double> isa_plan;
+  const auto h{isa_plan.input("h")};
+  const auto p{isa_plan.add(plan::Operation::PRESSURE, {h})};
+  const auto rho{isa_plan.add(plan::Operation::DENSITY, {p, p})};
+  const auto a{isa_plan.add(plan::Operation::ALTITUDE, {rho})};
+  const auto t{isa_plan.add(plan::Operation::TEMPERATURE, {a})};
+  const auto s{isa_plan.add(plan::Operation::SPEED_OF_SOUND, {t})};
+  isa_plan.output("density", isa_plan.add(plan::Operation::DENSITY, {a, s}));
+
+  const auto program{isa_plan.compile()};
+  BOOST_CHECK_EQUAL(3u, program.scratch_slots());
+
+  std::vector<double> results(altitudes.size());
+  const std::vector<std::span<double>> outputs{results};
+  const std::vector<std::span<const double>> inputs{altitudes};
+  program.run(inputs, outputs);
+
+  for (std::size_t i{}; i < altitudes.size(); ++i) {
+    const auto pressure{calculate_isa_pressure(Metres<double>(altitudes[i]))};
+    const auto density{
+        calculate_density(pressure, Kelvin<double>(pressure.v()))};
+    const auto altitude{calculate_isa_altitude(Pascals<double>(density.v()))};
+    const auto sound{speed_of_sound(calculate_isa_temperature(altitude))};
+    BOOST_CHECK_EQUAL(calculate_density(Pascals<double>(altitude.v()),
+                                        Kelvin<double>(sound.v()))
+                          .v(),
+                      results[i]);
+  }
+}
+//////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_SUITE_END()
+//////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,165 @@
+//////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2024 Ken Barker
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+/// @file
+/// @brief Contains tests for the QnhMap class.
+//////////////////////////////////////////////////////////////////////////////
+#include "via/isa/qnh.hpp"
+#include <boost/test/unit_test.hpp>
+#include <vector>
+
+using namespace via::isa;
+using namespace via::units::si;
+
+namespace {
+const double CALCULATION_TOLERANCE(1.0e-9);
+
+/// The pressure altitude of a QNH altitude from the ISA relations.
+auto pressure_altitude(const double qnh_altitude, const double qnh) -> double {
+  return calculate_isa_altitude(
+             Pascals<double>(
+                 calculate_isa_pressure(Metres<double>(qnh_altitude)).v() *
+                 qnh / 101325.0))
+      .v();
+}
+
+const std::vector<QnhRegion<double>> REGIONS{
+    {50.0, 60.0, -10.0, 2.0, Pascals<double>(99000.0), Metres<double>(1828.8)},
+    {40.0, 55.0, 0.0, 15.0, Pascals<double>(102500.0), Metres<double>(1524.0)},
+    {-40.0, -30.0, 140.0, 155.0, Pascals<double>(101000.0),
+     Metres<double>(3048.0)}};
+const QnhRegion<double> DEFAULT_REGION{0.0,
+                                       0.0,
+                                       0.0,
+                                       0.0,
+                                       Pascals<double>(101325.0),
+                                       Metres<double>(5486.4)};
+} // namespace
+
+//////////////////////////////////////////////////////////////////////////////
+BOOST_AUTO_TEST_SUITE(Test_qnh_double)
+
+//////////////////////////////////////////////////////////////////////////////
+BOOST_AUTO_TEST_CASE(test_calculate_transition_level) {
+  // Standard pressure: the next flight level above 6000 feet is FL70
+  BOOST_CHECK_CLOSE(
+      7000 * 0.3048,
+      calculate_transition_level(Metres<double>(1828.8),
+                                 Pascals<double>(101325.0))
+          .v(),
+      CALCULATION_TOLERANCE);
+
+  // Low pressure: 6000 feet is a pressure altitude of about 6640 feet, so FL70
+  BOOST_CHECK_CLOSE(
+      7000 * 0.3048,
+      calculate_transition_level(Metres<double>(1828.8),
+                                 Pascals<double>(99000.0))
+          .v(),
+      CALCULATION_TOLERANCE);
+
+  // High pressure: 6000 feet is a pressure altitude of about 5650 feet, so FL60
+  BOOST_CHECK_CLOSE(
+      6000 * 0.3048,
+      calculate_transition_level(Metres<double>(1828.8),
+                                 Pascals<double>(102500.0))
+          .v(),
+      CALCULATION_TOLERANCE);
+}
+//////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////
+BOOST_AUTO_TEST_CASE(test_find_regions) {
+  const QnhMap<double> map(REGIONS, DEFAULT_REGION, 2.5);
+  BOOST_CHECK_EQUAL(4u, map.size());
+  BOOST_CHECK_EQUAL(101325.0, map.qnh(0).v());
+  BOOST_CHECK_EQUAL(99000.0, map.qnh(1).v());
+
+  BOOST_CHECK_EQUAL(1u, map.region(51.5, -0.5));
+  // The first region wins where regions overlap
+  BOOST_CHECK_EQUAL(1u, map.region(52.0, 1.0));
+  BOOST_CHECK_EQUAL(2u, map.region(48.0, 1.0));
+  BOOST_CHECK_EQUAL(2u, map.region(45.0, 15.0));
+  BOOST_CHECK_EQUAL(3u, map.region(-33.9, 151.2));
+  // Inside the grid, outside the regions
+  BOOST_CHECK_EQUAL(0u, map.region(0.0, 0.0));
+  BOOST_CHECK_EQUAL(0u, map.region(58.0, 10.0));
+  // Outside the grid
+  BOOST_CHECK_EQUAL(0u, map.region(70.0, 0.0));
+  BOOST_CHECK_EQUAL(0u, map.region(51.5, -170.0));
+
+  const std::vector latitudes{51.5, 45.0, 0.0, -33.9};
+  const std::vector longitudes{-0.5, 15.0, 0.0, 151.2};
+  std::vector<std::uint32_t> regions(4);
+  map.find_regions(latitudes, longitudes, regions);
+  BOOST_CHECK_EQUAL(1u, regions[0]);
+  BOOST_CHECK_EQUAL(2u, regions[1]);
+  BOOST_CHECK_EQUAL(0u, regions[2]);
+  BOOST_CHECK_EQUAL(3u, regions[3]);
+
+  // A map without regions
+  const QnhMap<double> empty({}, DEFAULT_REGION);
+  BOOST_CHECK_EQUAL(1u, empty.size());
+  BOOST_CHECK_EQUAL(0u, empty.region(51.5, -0.5));
+}
+//////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////
+BOOST_AUTO_TEST_CASE(test_convert_altitudes) {
+  const QnhMap<double> map(REGIONS, DEFAULT_REGION);
+
+  // More positions than a block
+  constexpr std::size_t SIZE{1000};
+  std::vector<double> latitudes(SIZE);
+  std::vector<double> longitudes(SIZE);
+  std::vector<double> qnh_altitudes(SIZE);
+  for (std::size_t i{}; i < SIZE; ++i) {
+    latitudes[i] = -60.0 + 0.12 * static_cast<double>(i);
+    longitudes[i] = -20.0 + 0.17 * static_cast<double>(i);
+    qnh_altitudes[i] = 10.0 * static_cast<double>(i);
+  }
+
+  std::vector<double> pressure_altitudes(SIZE);
+  map.calculate_pressure_altitudes(latitudes, longitudes, qnh_altitudes,
+                                   pressure_altitudes);
+  std::vector<double> result(SIZE);
+  map.calculate_qnh_altitudes(latitudes, longitudes, pressure_altitudes,
+                              result);
+  std::vector<double> indicated(SIZE);
+  map.calculate_indicated_altitudes(latitudes, longitudes, pressure_altitudes,
+                                    indicated);
+
+  for (std::size_t i{}; i < SIZE; ++i) {
+    const auto region{map.region(latitudes[i], longitudes[i])};
+    const double expected{
+        pressure_altitude(qnh_altitudes[i], map.qnh(region).v())};
+    BOOST_CHECK_SMALL(expected - pressure_altitudes[i], 1e-6);
+    BOOST_CHECK_SMALL(qnh_altitudes[i] - result[i], 1e-6);
+
+    if (pressure_altitudes[i] < map.transition_level(region).v())
+      BOOST_CHECK_SMALL(qnh_altitudes[i] - indicated[i], 1e-6);
+    else
+      BOOST_CHECK_EQUAL(pressure_altitudes[i], indicated[i]);
+  }
+}
+//////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_SUITE_END()
+//////////////////////////////////////////////////////////////////////////////
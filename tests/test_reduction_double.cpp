@@ -0,0 +1,185 @@
+//////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2024 Ken Barker
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+/// @file
+/// @brief Contains tests for the via::isa::reduction namespace.
+//////////////////////////////////////////////////////////////////////////////
+#include "via/isa/reduction.hpp"
+#include <boost/test/unit_test.hpp>
+#include <algorithm>
+#include <numeric>
+#include <vector>
+
+using namespace via::isa;
+using namespace via::units::si;
+
+namespace {
+const double CALCULATION_TOLERANCE(1.0e-9);
+} // namespace
+
+//////////////////////////////////////////////////////////////////////////////
+BOOST_AUTO_TEST_SUITE(Test_reduction_double)
+
+//////////////////////////////////////////////////////////////////////////////
+BOOST_AUTO_TEST_CASE(test_summary) {
+  reduction::Summary<double> empty;
+  BOOST_CHECK_EQUAL(0u, empty.count());
+  BOOST_CHECK(std::isnan(empty.mean()));
+
+  const std::vector<double> values{3.0, -1.0, 4.0, 1.0, 5.0, 9.0, 2.0};
+  reduction::Summary<double> summary;
+  summary.add(values);
+  BOOST_CHECK_EQUAL(values.size(), summary.count());
+  BOOST_CHECK_EQUAL(-1.0, summary.min());
+  BOOST_CHECK_EQUAL(9.0, summary.max());
+  BOOST_CHECK_EQUAL(23.0, summary.sum());
+  BOOST_CHECK_CLOSE(23.0 / 7.0, summary.mean(), CALCULATION_TOLERANCE);
+
+  // Merging in parts gives the same result
+  reduction::Summary<double> first;
+  reduction::Summary<double> second;
+  first.add(std::span<const double>(values).first(3));
+  second.add(std::span<const double>(values).subspan(3));
+  first.merge(second);
+  first.merge(empty);
+  BOOST_CHECK_EQUAL(summary.count(), first.count());
+  BOOST_CHECK_EQUAL(summary.min(), first.min());
+  BOOST_CHECK_EQUAL(summary.max(), first.max());
+  BOOST_CHECK_EQUAL(summary.sum(), first.sum());
+}
+//////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////
+BOOST_AUTO_TEST_CASE(test_quantile_sketch) {
+  constexpr auto ACCURACY{0.01};
+  reduction::QuantileSketch<double> empty(ACCURACY);
+  BOOST_CHECK(std::isnan(empty.quantile(0.5)));
+
+  std::vector<double> values(10001);
+  std::iota(values.begin(), values.end(), -2000.0);
+  reduction::QuantileSketch<double> sketch(ACCURACY);
+  sketch.add(values);
+  BOOST_CHECK_EQUAL(values.size(), sketch.count());
+
+  for (const double q : {0.0, 0.1, 0.2, 0.25, 0.5, 0.9, 0.99, 1.0}) {
+    const auto expected{values[static_cast<std::size_t>(
+        q * static_cast<double>(values.size() - 1))]};
+    BOOST_CHECK_LE(std::abs(sketch.quantile(q) - expected),
+                   ACCURACY * std::abs(expected));
+  }
+  BOOST_CHECK_EQUAL(0.0, sketch.quantile(0.2));
+
+  // Merging sketches of parts gives the same quantiles
+  reduction::QuantileSketch<double> first(ACCURACY);
+  reduction::QuantileSketch<double> second(ACCURACY);
+  first.add(std::span<const double>(values).first(5000));
+  second.add(std::span<const double>(values).subspan(5000));
+  second.merge(first);
+  for (const double q : {0.0, 0.3, 0.5, 0.75, 1.0})
+    BOOST_CHECK_EQUAL(sketch.quantile(q), second.quantile(q));
+}
+//////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////
+BOOST_AUTO_TEST_CASE(test_reduce) {
+  constexpr std::size_t SIZE{100003};
+  std::vector<double> altitudes(SIZE);
+  for (std::size_t i{}; i < SIZE; ++i)
+    altitudes[i] = static_cast<double>(i % 13001);
+
+  std::vector<double> pressures(SIZE);
+  batch::calculate_isa_pressure<double>(altitudes, pressures);
+  const auto [min, max]{std::minmax_element(pressures.begin(), pressures.end())};
+  const auto sum{std::accumulate(pressures.begin(), pressures.end(), 0.0)};
+
+  const auto result{reduction::reduce_isa_pressure<double>(
+      altitudes, reduction::Statistics<double>{}, 1)};
+  BOOST_CHECK_EQUAL(SIZE, result.summary.count());
+  BOOST_CHECK_EQUAL(*min, result.summary.min());
+  BOOST_CHECK_EQUAL(*max, result.summary.max());
+  BOOST_CHECK_CLOSE(sum, result.summary.sum(), CALCULATION_TOLERANCE);
+  BOOST_CHECK_EQUAL(SIZE, result.sketch.count());
+
+  // The results do not depend upon the number of threads
+  for (const std::size_t threads : {2u, 3u, 8u}) {
+    const auto other{reduction::reduce_isa_pressure<double>(
+        altitudes, reduction::Statistics<double>{}, threads)};
+    BOOST_CHECK_EQUAL(result.summary.sum(), other.summary.sum());
+    BOOST_CHECK_EQUAL(result.sketch.quantile(0.5), other.sketch.quantile(0.5));
+  }
+
+  const std::vector<double> temperatures(SIZE, 250.0);
+  const auto densities{reduction::reduce_density<double>(
+      pressures, temperatures, reduction::Summary<double>{})};
+  BOOST_CHECK_EQUAL(
+      calculate_density(Pascals<double>(*max), Kelvin<double>(250.0)).v(),
+      densities.max());
+
+  const std::vector<double> cas(SIZE, 150.0);
+  const auto machs{reduction::reduce_calibrated_air_speed_mach<double>(
+      cas, altitudes, reduction::Summary<double>{})};
+  BOOST_CHECK_EQUAL(calibrated_air_speed_mach(MetresPerSecond<double>(150.0),
+                                              Pascals<double>(*min)),
+                    machs.max());
+
+  const std::vector<double> mach_numbers(SIZE, 0.8);
+  const auto tas{reduction::reduce_mach_true_air_speed<double>(
+      mach_numbers, temperatures, reduction::Summary<double>{})};
+  BOOST_CHECK_EQUAL(mach_true_air_speed(0.8, Kelvin<double>(250.0)).v(),
+                    tas.min());
+}
+//////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////
+BOOST_AUTO_TEST_CASE(test_time_above) {
+  const std::vector<double> times{0.0, 10.0, 20.0, 30.0, 40.0};
+  const std::vector<double> altitudes{10000.0, 12000.0, 12000.0, 10500.0,
+                                      11500.0};
+  // Above from 5s to 26.67s and from 35s to 40s
+  BOOST_CHECK_CLOSE(
+      5.0 + 10.0 + 20.0 / 3.0 + 5.0, reduction::time_above<double>(times, altitudes, 11000.0),
+      CALCULATION_TOLERANCE);
+  BOOST_CHECK_EQUAL(0.0, reduction::time_above<double>(
+                             std::span<const double>(times).first(1),
+                             std::span<const double>(altitudes).first(1),
+                             11000.0));
+
+  // A long climb and descent through the tropopause
+  constexpr std::size_t SIZE{20001};
+  std::vector<double> long_times(SIZE);
+  std::vector<double> long_altitudes(SIZE);
+  for (std::size_t i{}; i < SIZE; ++i) {
+    long_times[i] = static_cast<double>(i);
+    long_altitudes[i] =
+        12000.0 - std::abs(static_cast<double>(i) - 10000.0) * 0.5;
+  }
+  const auto tropopause{constants::TROPOPAUSE_ALTITUDE<double>.v()};
+  const auto expected{4.0 * (12000.0 - tropopause)};
+  const auto above{
+      reduction::time_above<double>(long_times, long_altitudes, tropopause, 1)};
+  BOOST_CHECK_CLOSE(expected, above, CALCULATION_TOLERANCE);
+  BOOST_CHECK_EQUAL(above, reduction::time_above<double>(
+                               long_times, long_altitudes, tropopause, 4));
+}
+//////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_SUITE_END()
+//////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,102 @@
+//////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2024 Ken Barker
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+/// @file
+/// @brief Contains tests for the synthetic fleet generator.
+//////////////////////////////////////////////////////////////////////////////
+#include "via/isa/synthetic_fleet.hpp"
+#include <boost/test/unit_test.hpp>
+
+using namespace via::isa;
+using namespace via::units::si;
+
+namespace {
+const double CALCULATION_TOLERANCE(1.0e-6);
+} // namespace
+
+//////////////////////////////////////////////////////////////////////////////
+BOOST_AUTO_TEST_SUITE(Test_synthetic_fleet_double)
+
+//////////////////////////////////////////////////////////////////////////////
+BOOST_AUTO_TEST_CASE(test_generate_synthetic_fleet_deterministic) {
+  FleetParameters<double> params;
+  params.flights = 20;
+  const auto fleet_a{generate_synthetic_fleet(params)};
+  const auto fleet_b{generate_synthetic_fleet(params)};
+
+  BOOST_CHECK_EQUAL(20u, fleet_a.flights());
+  BOOST_CHECK_EQUAL(fleet_a.size(), fleet_a.offsets.back());
+  BOOST_CHECK(fleet_a.offsets == fleet_b.offsets);
+  BOOST_CHECK(fleet_a.altitude == fleet_b.altitude);
+  BOOST_CHECK(fleet_a.cas == fleet_b.cas);
+  BOOST_CHECK(fleet_a.delta_temperature == fleet_b.delta_temperature);
+
+  // A different seed generates a different fleet
+  params.seed = 42;
+  const auto fleet_c{generate_synthetic_fleet(params)};
+  BOOST_CHECK(fleet_a.altitude != fleet_c.altitude);
+}
+//////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////
+BOOST_AUTO_TEST_CASE(test_generate_synthetic_fleet_profiles) {
+  FleetParameters<double> params;
+  params.flights = 50;
+  const auto fleet{generate_synthetic_fleet(params)};
+
+  std::size_t cruise_samples{};
+  for (std::size_t i{}; i < fleet.size(); ++i) {
+    const auto altitude{Metres<double>(fleet.altitude[i])};
+    BOOST_CHECK(0.0 <= altitude.v());
+    BOOST_CHECK(altitude.v() <= params.max_cruise_altitude);
+
+    if (fleet.phase[i] == FlightPhase::CRUISE)
+      ++cruise_samples;
+
+    // The CAS and Mach number are consistent at every sample
+    const auto temperature{calculate_isa_temperature(
+        altitude, Kelvin<double>(fleet.delta_temperature[i]))};
+    const auto tas{calculate_true_air_speed(
+        MetresPerSecond<double>(fleet.cas[i]), calculate_isa_pressure(altitude),
+        temperature)};
+    BOOST_CHECK_CLOSE(mach_true_air_speed(fleet.mach[i], temperature).v(),
+                      tas.v(), 10 * CALCULATION_TOLERANCE);
+  }
+
+  // Most samples are at cruise altitudes
+  BOOST_CHECK(2 * cruise_samples > fleet.size());
+
+  // The flights climb, cruise and descend in that order
+  for (std::size_t f{}; f < fleet.flights(); ++f) {
+    const auto begin{fleet.offsets[f]};
+    const auto end{fleet.offsets[f + 1]};
+    BOOST_CHECK(begin < end);
+    BOOST_CHECK(FlightPhase::CLIMB == fleet.phase[begin]);
+    BOOST_CHECK(FlightPhase::DESCENT == fleet.phase[end - 1]);
+    BOOST_CHECK_EQUAL(0.0, fleet.time[begin]);
+    for (auto i{begin + 1}; i < end; ++i)
+      BOOST_CHECK(fleet.phase[i - 1] <= fleet.phase[i]);
+  }
+}
+//////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_SUITE_END()
+//////////////////////////////////////////////////////////////////////////////
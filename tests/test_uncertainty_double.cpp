@@ -0,0 +1,217 @@
+//////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2024 Ken Barker
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+/// @file
+/// @brief Contains tests for the via::isa::uncertainty namespace.
+//////////////////////////////////////////////////////////////////////////////
+#include "via/isa/uncertainty.hpp"
+#include <boost/test/unit_test.hpp>
+#include <vector>
+
+using namespace via::isa;
+using namespace via::units::si;
+
+namespace {
+const double CALCULATION_TOLERANCE(1.0e-5);
+
+/// Calculate a central difference derivative.
+template <typename Function>
+auto derivative(Function f, const double x, const double step) -> double {
+  return (f(x + step) - f(x - step)) / (2.0 * step);
+}
+} // namespace
+
+//////////////////////////////////////////////////////////////////////////////
+BOOST_AUTO_TEST_SUITE(Test_uncertainty_double)
+
+//////////////////////////////////////////////////////////////////////////////
+BOOST_AUTO_TEST_CASE(test_linear_variance) {
+  const std::array sensitivity{2.0};
+  const std::array variance{9.0};
+  BOOST_CHECK_EQUAL(4.0 * 9.0,
+                    uncertainty::linear_variance(sensitivity, variance));
+
+  // Perfectly correlated inputs with equal and opposite sensitivities
+  const std::array sensitivities{1.0, -1.0};
+  const std::array variances{4.0, 4.0};
+  BOOST_CHECK_EQUAL(0.0, uncertainty::linear_variance(sensitivities, variances,
+                                                      std::array{4.0}));
+  BOOST_CHECK_EQUAL(8.0,
+                    uncertainty::linear_variance(sensitivities, variances));
+}
+//////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////
+BOOST_AUTO_TEST_CASE(test_sensitivities) {
+  // Below and above the tropopause
+  for (const double p : {90000.0, 50000.0, 20000.0}) {
+    const auto [altitude, d_altitude]{
+        uncertainty::isa_altitude_sensitivities(Pascals<double>(p))};
+    BOOST_CHECK_EQUAL(calculate_isa_altitude(Pascals<double>(p)).v(),
+                      altitude.v());
+    const auto expected{derivative(
+        [](const double x) {
+          return calculate_isa_altitude(Pascals<double>(x)).v();
+        },
+        p, 1.0)};
+    BOOST_CHECK_CLOSE(expected, d_altitude[0], CALCULATION_TOLERANCE);
+  }
+
+  const auto p{Pascals<double>(30000.0)};
+  const auto t{Kelvin<double>(230.0)};
+  const auto cas{MetresPerSecond<double>(140.0)};
+
+  const auto [density, d_density]{uncertainty::density_sensitivities(p, t)};
+  BOOST_CHECK_EQUAL(calculate_density(p, t).v(), density.v());
+  BOOST_CHECK_CLOSE(derivative(
+                        [t](const double x) {
+                          return calculate_density(Pascals<double>(x), t).v();
+                        },
+                        p.v(), 1.0),
+                    d_density[0], CALCULATION_TOLERANCE);
+  BOOST_CHECK_CLOSE(derivative(
+                        [p](const double x) {
+                          return calculate_density(p, Kelvin<double>(x)).v();
+                        },
+                        t.v(), 0.01),
+                    d_density[1], CALCULATION_TOLERANCE);
+
+  const auto [tas, d_tas]{uncertainty::true_air_speed_sensitivities(cas, p, t)};
+  BOOST_CHECK_EQUAL(calculate_true_air_speed(cas, p, t).v(), tas.v());
+  BOOST_CHECK_CLOSE(
+      derivative(
+          [p, t](const double x) {
+            return calculate_true_air_speed(MetresPerSecond<double>(x), p, t)
+                .v();
+          },
+          cas.v(), 0.01),
+      d_tas[0], CALCULATION_TOLERANCE);
+  BOOST_CHECK_CLOSE(
+      derivative(
+          [cas, t](const double x) {
+            return calculate_true_air_speed(cas, Pascals<double>(x), t).v();
+          },
+          p.v(), 1.0),
+      d_tas[1], CALCULATION_TOLERANCE);
+  BOOST_CHECK_CLOSE(
+      derivative(
+          [cas, p](const double x) {
+            return calculate_true_air_speed(cas, p, Kelvin<double>(x)).v();
+          },
+          t.v(), 0.01),
+      d_tas[2], CALCULATION_TOLERANCE);
+
+  // Zero speed is not differentiable
+  const auto [zero_tas, d_zero_tas]{uncertainty::true_air_speed_sensitivities(
+      MetresPerSecond<double>(0.0), p, t)};
+  BOOST_CHECK_EQUAL(0.0, zero_tas.v());
+  BOOST_CHECK_EQUAL(0.0, d_zero_tas[0]);
+
+  const auto [mach_tas, d_mach_tas]{
+      uncertainty::mach_true_air_speed_sensitivities(0.8, t)};
+  BOOST_CHECK_EQUAL(mach_true_air_speed(0.8, t).v(), mach_tas.v());
+  BOOST_CHECK_CLOSE(
+      derivative(
+          [t](const double x) { return mach_true_air_speed(x, t).v(); }, 0.8,
+          1e-4),
+      d_mach_tas[0], CALCULATION_TOLERANCE);
+  BOOST_CHECK_CLOSE(derivative(
+                        [](const double x) {
+                          return mach_true_air_speed(0.8, Kelvin<double>(x))
+                              .v();
+                        },
+                        t.v(), 0.01),
+                    d_mach_tas[1], CALCULATION_TOLERANCE);
+}
+//////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////
+BOOST_AUTO_TEST_CASE(test_batch_uncertainty) {
+  const std::vector<double> cas{100.0, 150.0, 200.0, 250.0};
+  const std::vector<double> pressures{90000.0, 60000.0, 30000.0, 20000.0};
+  const std::vector<double> temperatures{280.0, 260.0, 230.0, 216.65};
+  const std::vector<double> pressure_variances(4, 100.0);
+  const std::vector<double> temperature_variances(4, 1.0);
+  const std::vector<double> pressure_temperature_covariances(4, 5.0);
+
+  std::vector<double> values(4);
+  std::vector<double> variances(4);
+
+  uncertainty::calculate_isa_altitude<double>(
+      pressures, {.variances = {pressure_variances}}, values, variances);
+  for (std::size_t i{}; i < values.size(); ++i) {
+    const auto [altitude, sensitivities]{uncertainty::isa_altitude_sensitivities(
+        Pascals<double>(pressures[i]))};
+    BOOST_CHECK_EQUAL(altitude.v(), values[i]);
+    BOOST_CHECK_EQUAL(
+        sensitivities[0] * sensitivities[0] * pressure_variances[i],
+        variances[i]);
+  }
+
+  // Pressure and temperature errors are correlated
+  uncertainty::calculate_density<double>(
+      pressures, temperatures,
+      {.variances = {pressure_variances, temperature_variances},
+       .covariances = {pressure_temperature_covariances}},
+      values, variances);
+  for (std::size_t i{}; i < values.size(); ++i) {
+    const auto [density, s]{uncertainty::density_sensitivities(
+        Pascals<double>(pressures[i]), Kelvin<double>(temperatures[i]))};
+    BOOST_CHECK_EQUAL(density.v(), values[i]);
+    BOOST_CHECK_CLOSE(s[0] * s[0] * pressure_variances[i] +
+                          s[1] * s[1] * temperature_variances[i] +
+                          2.0 * s[0] * s[1] *
+                              pressure_temperature_covariances[i],
+                      variances[i], CALCULATION_TOLERANCE);
+  }
+
+  // No CAS errors
+  uncertainty::calculate_true_air_speed<double>(
+      cas, pressures, temperatures,
+      {.variances = {std::span<const double>(), pressure_variances,
+                     temperature_variances}}, values,
+      variances);
+  for (std::size_t i{}; i < values.size(); ++i) {
+    const auto [tas, s]{uncertainty::true_air_speed_sensitivities(
+        MetresPerSecond<double>(cas[i]), Pascals<double>(pressures[i]),
+        Kelvin<double>(temperatures[i]))};
+    BOOST_CHECK_EQUAL(tas.v(), values[i]);
+    BOOST_CHECK_CLOSE(s[1] * s[1] * pressure_variances[i] +
+                          s[2] * s[2] * temperature_variances[i],
+                      variances[i], CALCULATION_TOLERANCE);
+  }
+
+  const std::vector<double> machs{0.3, 0.5, 0.7, 0.85};
+  const std::vector<double> mach_variances(4, 1e-4);
+  uncertainty::mach_true_air_speed<double>(
+      machs, temperatures, {.variances = {mach_variances, std::span<const double>()}}, values,
+      variances);
+  for (std::size_t i{}; i < values.size(); ++i) {
+    const auto speed{speed_of_sound(Kelvin<double>(temperatures[i])).v()};
+    BOOST_CHECK_EQUAL(machs[i] * speed, values[i]);
+    BOOST_CHECK_CLOSE(speed * speed * mach_variances[i], variances[i],
+                      CALCULATION_TOLERANCE);
+  }
+}
+//////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_SUITE_END()
+//////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,136 @@
+//////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2024 Ken Barker
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+/// @file
+/// @brief Contains tests for the true vertical speed functions.
+//////////////////////////////////////////////////////////////////////////////
+#include "via/isa/vertical_speed.hpp"
+#include <boost/test/unit_test.hpp>
+#include <vector>
+
+using namespace via::isa;
+using namespace via::units::si;
+
+namespace {
+const double CALCULATION_TOLERANCE(1.0e-9);
+} // namespace
+
+//////////////////////////////////////////////////////////////////////////////
+BOOST_AUTO_TEST_SUITE(Test_vertical_speed_double)
+
+//////////////////////////////////////////////////////////////////////////////
+BOOST_AUTO_TEST_CASE(test_geopotential_height) {
+  BOOST_CHECK_EQUAL(0.0, geopotential_height(Metres<double>(0.0)).v());
+  // ICAO Doc 7488/3: 11000 m geopotential is 11019 m geometric
+  BOOST_CHECK_CLOSE(11019.0, geometric_height(Metres<double>(11000.0)).v(),
+                    0.001);
+  for (const double height : {-500.0, 3000.0, 11000.0, 20000.0})
+    BOOST_CHECK_CLOSE(
+        height,
+        geopotential_height(geometric_height(Metres<double>(height))).v(),
+        CALCULATION_TOLERANCE);
+}
+//////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////
+BOOST_AUTO_TEST_CASE(test_true_vertical_speed) {
+  const auto rate{MetresPerSecond<double>(10.0)};
+  const auto altitude{Metres<double>(5000.0)};
+  const auto isa_temperature{calculate_isa_temperature(altitude)};
+
+  // ISA
+  BOOST_CHECK_CLOSE(
+      10.0, calculate_true_vertical_speed(rate, altitude, isa_temperature).v(),
+      CALCULATION_TOLERANCE);
+  // 10% colder than ISA
+  BOOST_CHECK_CLOSE(9.0,
+                    calculate_true_vertical_speed(
+                        rate, altitude, Kelvin<double>(0.9 * isa_temperature.v()))
+                        .v(),
+                    CALCULATION_TOLERANCE);
+}
+//////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////
+BOOST_AUTO_TEST_CASE(test_true_vertical_profile) {
+  // A climb at 10 m/s pressure altitude rate for 10 minutes on a cold day
+  constexpr std::size_t SIZE{601};
+  const auto delta{Kelvin<double>(-20.0)};
+  const auto elevation{Metres<double>(300.0)};
+  std::vector<double> times(SIZE);
+  std::vector<double> altitudes(SIZE);
+  std::vector<double> rates(SIZE, 10.0);
+  std::vector<double> temperatures(SIZE);
+  for (std::size_t i{}; i < SIZE; ++i) {
+    times[i] = static_cast<double>(i);
+    altitudes[i] = 10.0 * static_cast<double>(i);
+    temperatures[i] =
+        calculate_isa_temperature(Metres<double>(altitudes[i]), delta).v();
+  }
+
+  std::vector<double> speeds(SIZE);
+  std::vector<double> heights(SIZE);
+  calculate_true_vertical_profile<double>(times, altitudes, rates, delta,
+                                          elevation, speeds, heights);
+  BOOST_CHECK_CLOSE(elevation.v(), heights[0], CALCULATION_TOLERANCE);
+
+  // The geopotential height gained is the integral of T / T_isa
+  constexpr double L{-0.0065};
+  for (const std::size_t i : {100u, 300u, 600u}) {
+    const double h{altitudes[i]};
+    const double gained{h + delta.v() * std::log1p(L * h / 288.15) / L};
+    const double expected{
+        geometric_height(
+            Metres<double>(geopotential_height(elevation).v() + gained))
+            .v()};
+    BOOST_CHECK_CLOSE(expected, heights[i], 1e-4);
+
+    // The vertical speeds are the rates of change of geometric height
+    const double radius{EARTH_RADIUS<double>.v()};
+    const double ratio{
+        radius /
+        (radius - geopotential_height(Metres<double>(heights[i])).v())};
+    BOOST_CHECK_CLOSE(calculate_true_vertical_speed(
+                          MetresPerSecond<double>(rates[i]),
+                          Metres<double>(h), Kelvin<double>(temperatures[i]))
+                              .v() *
+                          ratio * ratio,
+                      speeds[i], CALCULATION_TOLERANCE);
+  }
+  for (std::size_t i{1}; i + 1 < SIZE; ++i)
+    BOOST_CHECK_CLOSE(0.5 * (heights[i + 1] - heights[i - 1]), speeds[i],
+                      1e-4);
+
+  // The same profile from outside air temperatures
+  std::vector<double> oat_speeds(SIZE);
+  std::vector<double> oat_heights(SIZE);
+  calculate_true_vertical_profile<double>(times, altitudes, rates,
+                                          temperatures, elevation, oat_speeds,
+                                          oat_heights);
+  for (std::size_t i{}; i < SIZE; ++i) {
+    BOOST_CHECK_EQUAL(speeds[i], oat_speeds[i]);
+    BOOST_CHECK_EQUAL(heights[i], oat_heights[i]);
+  }
+}
+//////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_SUITE_END()
+//////////////////////////////////////////////////////////////////////////////